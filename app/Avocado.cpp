@@ -20,7 +20,11 @@
 #include <Avocado/optimizers/ADAM.hpp>
 #include <Avocado/losses/MeanSquareLoss.hpp>
 #include <Avocado/losses/CrossEntropyLoss.hpp>
+#include <Avocado/metrics/TopKAccuracy.hpp>
 #include <Avocado/utils/file_helpers.hpp>
+#include <Avocado/data/Dataset.hpp>
+#include <Avocado/data/DataLoader.hpp>
+#include <Avocado/graph/Trainer.hpp>
 
 #include <Avocado/expression/Expression.hpp>
 #include <Avocado/expression/autograd.hpp>
@@ -37,10 +41,6 @@ class MNIST
 {
 	private:
 		const std::string path = "/home/maciek/Downloads/mnist/";
-		mutable std::vector<int> train_ordering;
-		mutable std::vector<int> test_ordering;
-		mutable size_t train_index = 0;
-		mutable size_t test_index = 0;
 	public:
 		Tensor train_images;
 		Tensor test_images;
@@ -50,13 +50,9 @@ class MNIST
 		{
 			train_images = load_images(path + "train-images-idx3-ubyte", 60000);
 			train_labels = load_labels(path + "train-labels-idx1-ubyte", 60000);
-			train_ordering.assign(train_images.dimension(0), 0);
-			std::iota(train_ordering.begin(), train_ordering.end(), 0);
 
 			test_images = load_images(path + "t10k-images-idx3-ubyte", 10000);
 			test_labels = load_labels(path + "t10k-labels-idx1-ubyte", 10000);
-			test_ordering.assign(test_images.dimension(0), 0);
-			std::iota(test_ordering.begin(), test_ordering.end(), 0);
 		}
 		void printSample(int index) const
 		{
@@ -91,41 +87,7 @@ class MNIST
 			}
 			std::cout << "└────────────────────────────────────────────────────────┘\n\n";
 		}
-		void packTrainSamples(Tensor &input, Tensor &target)
-		{
-			pack_samples(input, target, train_images, train_labels, train_ordering, train_index);
-		}
-		void packTestSamples(Tensor &input, Tensor &target)
-		{
-			pack_samples(input, target, test_images, test_labels, test_ordering, test_index);
-		}
 	private:
-		void pack_samples(Tensor &input, Tensor &target, const Tensor &images, const Tensor &labels, std::vector<int> &ordering, size_t &index) const
-		{
-			assert(input.firstDim() == target.firstDim());
-			std::vector<float> host_input(input.volume(), 0.0f);
-			std::vector<float> host_target(target.volume(), 0.0f);
-			for (int i = 0; i < input.firstDim(); i++)
-			{
-				if (index >= ordering.size())
-				{
-					std::random_shuffle(ordering.begin(), ordering.end());
-					index = 0;
-				}
-				const int sample_index = ordering.at(index) % 1000;
-				index++;
-
-				Tensor tmp = const_cast<Tensor&>(images).view(Shape( { 28, 28 }), sample_index * 28 * 28);
-				tmp.copyToHost(host_input.data() + i * 28 * 28, 28 * 28);
-				const int label = labels.get<int>( { sample_index });
-				host_target.at(i * 10 + label) = 1.0f;
-			}
-
-			Tensor tmp_input(input.shape(), input.dtype(), Device::cpu());
-			Tensor tmp_target(target.shape(), target.dtype(), Device::cpu());
-			input.copyFromHost(host_input.data(), input.volume());
-			target.copyFromHost(host_target.data(), target.volume());
-		}
 		Tensor load_images(const std::string &path, int n)
 		{
 			std::fstream stream(path, std::fstream::in);
@@ -152,30 +114,47 @@ class MNIST
 		}
 };
 
-double get_accuracy(const Tensor &output, const Tensor &target)
+/*
+ * Decodes labels into one-hot targets.
+ */
+class MNISTDataset: public Dataset
 {
-	assert(output.firstDim() == target.firstDim());
-	double correct = 0;
-	for (int i = 0; i < output.firstDim(); i++)
-	{
-		int output_idx = 0;
-		float output_max = output.get<float>( { i, 0 });
-		for (int j = 0; j < output.lastDim(); j++)
-			if (output.get<float>( { i, j }) > output_max)
-			{
-				output_max = output.get<float>( { i, j });
-				output_idx = j;
-			}
+	private:
+		const Tensor &m_images;
+		const Tensor &m_labels;
+	public:
+		MNISTDataset(const Tensor &images, const Tensor &labels) :
+				m_images(images),
+				m_labels(labels)
+		{
+		}
+		size_t size() const
+		{
+			return m_images.firstDim();
+		}
+		void load(size_t index, std::vector<Tensor> &rows) const
+		{
+			const float *image = reinterpret_cast<const float*>(m_images.data()) + index * 28 * 28;
+			std::memcpy(rows[0].data(), image, sizeof(float) * 28 * 28);
 
-		int target_idx = 0;
-		for (int j = 0; j < target.lastDim(); j++)
-			if (target.get<float>( { i, j }) == 1.0f)
-				target_idx = j;
+			float *target = reinterpret_cast<float*>(rows[1].data());
+			std::fill(target, target + 10, 0.0f);
+			target[reinterpret_cast<const int*>(m_labels.data())[index]] = 1.0f;
+		}
+};
 
-		correct += static_cast<int>(target_idx == output_idx);
-	}
-	return correct;
-}
+class PrintingCallback: public TrainerCallback
+{
+	public:
+		void onLog(Trainer &trainer, const TrainingLog &log)
+		{
+			std::cout << "train : " << log.toString() << '\n';
+		}
+		void onEvaluation(Trainer &trainer, const TrainingLog &log)
+		{
+			std::cout << "test  : " << log.toString() << '\n';
+		}
+};
 
 void train_mnist()
 {
@@ -211,45 +190,16 @@ void train_mnist()
 //	model.setRegularizer(RegularizerL2(1.0e-4f));
 //	model.moveTo(Device::cuda(0));
 
-	for (int i = 0; i < 1; i++)
-	{
-		double avg_loss = 0.0;
-		double avg_acc = 0.0;
-		int counter = 0;
-		for (int j = 0; j < 5; j += batch_size, counter++)
-		{
-			dataset.packTrainSamples(model.getInput(), model.getTarget());
-			model.forward(batch_size);
-			model.backward(batch_size);
-			auto loss = model.getLoss(batch_size);
-			avg_loss += loss.at(0).get<float>();
-			avg_acc += get_accuracy(model.getOutput(), model.getTarget());
-
-			model.learn();
-		}
-		for (int k = 0; k < 10; k++)
-			std::cout << k << " " << model.getOutput().get<float>( { 0, k }) << " " << model.getTarget().get<float>( { 0, k }) << '\n';
-		std::cout << '\n';
-		std::cout << "Epoch " << i << " : train loss = " << avg_loss / (counter * batch_size) << ", acc = " << avg_acc / (counter * batch_size)
-				<< '\n';
-
-//		avg_loss = 0.0;
-//		avg_acc = 0.0;
-//		counter = 0;
-//		for (int j = 0; j < 1; j += batch_size, counter++)
-//		{
-//			dataset.packTestSamples(model.getInput(), model.getTarget());
-//			model.forward(batch_size);
-//			auto loss = model.getLoss(batch_size);
-//			avg_loss += loss.at(0).get<float>();
-//			avg_acc += get_accuracy(model.getOutput(), model.getTarget());
-//		}
-//		std::cout << "Epoch " << i << " : test loss  = " << avg_loss / counter << ", acc = " << avg_acc / (counter * batch_size) << '\n' << '\n';
-	}
-//	SerializedObject so;
-//	Json json = model.save(so);
-//	FileSaver fs("mnist_network.bin");
-//	fs.save(json, so);
+	MNISTDataset train_set(dataset.train_images, dataset.train_labels);
+	MNISTDataset test_set(dataset.test_images, dataset.test_labels);
+	DataLoader train_loader(train_set, model, 2);
+	DataLoader test_loader(test_set, model, 2, 2, false);
+
+	PrintingCallback printer;
+	Trainer trainer(model, train_loader);
+	trainer.setValidationData(test_loader).addMetric(TopKAccuracy()).addCallback(printer).setLogInterval(1000);
+//	trainer.setCheckpoint("mnist_network.bin");
+	trainer.fit(1);
 }
 
 int main()
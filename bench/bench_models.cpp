@@ -0,0 +1,137 @@
+/*
+ * bench_models.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ *
+ *  End-to-end benchmark of the canonical workloads. Example:
+ *  bench --workloads=mlp,classifier --batch=1,32,128 --threads=1,8 --output=results.json
+ */
+
+#include "bench_utils.hpp"
+#include "workloads.hpp"
+
+#include <Avocado/graph/Graph.hpp>
+#include <Avocado/core/DataType.hpp>
+#include <Avocado/core/Device.hpp>
+
+#include <exception>
+#include <iostream>
+
+using namespace avocado;
+using namespace avocado::bench;
+
+namespace
+{
+	void print_help()
+	{
+		std::cout << "Usage: bench [--name=value ...]\n";
+		std::cout << "  --workloads=mlp,classifier         models to run\n";
+		std::cout << "  --batch=1,8,32,128                 batch sizes\n";
+		std::cout << "  --threads=1,N                      numbers of CPU threads (default is 1 and all cores)\n";
+		std::cout << "  --dtypes=float32                   data types\n";
+		std::cout << "  --device=cpu                       device, for example 'cpu' or 'cuda:0'\n";
+		std::cout << "  --warmup=3                         number of unmeasured iterations\n";
+		std::cout << "  --iterations=20                    number of measured iterations\n";
+		std::cout << "  --output=-                         path to the JSON file with results, '-' means standard output\n";
+	}
+
+	Json run(Graph &graph, int batchSize, int warmup, int iterations)
+	{
+		const Context &context = graph.context();
+		Json result(JsonType::Object);
+
+		const Statistics forward = measure(context, [&]()
+		{
+			graph.forward(batchSize);
+		}, warmup, iterations);
+		result["forward"] = forward.toJson();
+		result["inference throughput [samples/s]"] = batchSize / forward.median;
+
+		graph.resetPeakMemoryUsage();
+		context.resetPeakMemoryUsage();
+		const Statistics training = measure(context, [&]()
+		{
+			graph.forward(batchSize);
+			graph.backward(batchSize);
+			graph.learn();
+		}, warmup, iterations);
+		result["training step"] = training.toJson();
+		result["training throughput [samples/s]"] = batchSize / training.median;
+
+		Json memory(JsonType::Object);
+		memory["forward"] = toJson(graph.getPeakMemoryUsage(GraphPhase::FORWARD));
+		memory["backward"] = toJson(graph.getPeakMemoryUsage(GraphPhase::BACKWARD));
+		memory["learn"] = toJson(graph.getPeakMemoryUsage(GraphPhase::LEARN));
+		memory["device"] = toJson(context.getPeakMemoryUsage());
+		result["peak memory [bytes]"] = memory;
+		return result;
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	try
+	{
+		const ArgumentParser args(argc, argv);
+		if (args.has("help"))
+		{
+			print_help();
+			return 0;
+		}
+		const Device device = Device::fromString(args.getString("device", "cpu"));
+		const std::vector<std::string> workloads = args.getStrings("workloads", "mlp,classifier");
+		const std::vector<int> batch_sizes = args.getInts("batch", "1,8,32,128");
+		const std::vector<int> threads = device.isCPU() ? args.getInts("threads", "1," + std::to_string(device.cores())) : std::vector<int>( { 0 });
+		const std::vector<std::string> dtypes = args.getStrings("dtypes", "float32");
+		const int warmup = args.getInt("warmup", 3);
+		const int iterations = args.getInt("iterations", 20);
+		const int default_threads = device.getNumberOfThreads();
+
+		Json settings(JsonType::Object);
+		settings["warmup"] = warmup;
+		settings["iterations"] = iterations;
+
+		Json results(JsonType::Array);
+		for (size_t w = 0; w < workloads.size(); w++)
+			for (size_t b = 0; b < batch_sizes.size(); b++)
+			{
+				Graph graph(device);
+				createWorkload(graph, workloads[w], batch_sizes[b]);
+				for (size_t d = 0; d < dtypes.size(); d++)
+					for (size_t t = 0; t < threads.size(); t++)
+					{
+						Json entry(JsonType::Object);
+						entry["workload"] = workloads[w];
+						entry["batch size"] = batch_sizes[b];
+						entry["dtype"] = dtypes[d];
+						entry["threads"] = threads[t];
+						if (typeFromString(dtypes[d]) != graph.dtype())
+						{ // graph is always built in its default precision
+							entry["skipped"] = "graph does not support dtype " + dtypes[d];
+							results[results.size()] = entry;
+							continue;
+						}
+						if (device.isCPU())
+							device.setNumberOfThreads(threads[t]);
+						std::cerr << workloads[w] << " : batch = " << batch_sizes[b] << ", dtype = " << dtypes[d] << ", threads = " << threads[t]
+								<< std::endl;
+						entry["results"] = run(graph, batch_sizes[b], warmup, iterations);
+						results[results.size()] = entry;
+					}
+			}
+		device.setNumberOfThreads(default_threads);
+
+		Json output(JsonType::Object);
+		output["benchmark"] = "models";
+		output["environment"] = environment(device);
+		output["settings"] = settings;
+		output["results"] = results;
+		saveResults(output, args.getString("output", "-"));
+	} catch (std::exception &e)
+	{
+		std::cerr << "bench failed : " << e.what() << std::endl;
+		return 1;
+	}
+	return 0;
+}
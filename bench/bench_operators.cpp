@@ -0,0 +1,164 @@
+/*
+ * bench_operators.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ *
+ *  Micro-benchmark of individual math:: functions. Example:
+ *  bench_ops --ops=gemm,softmaxForward --sizes=64,512 --dtypes=float32,float64 --reference --output=ops.json
+ */
+
+#include "bench_utils.hpp"
+#include "operators.hpp"
+
+#include <Avocado/core/Context.hpp>
+#include <Avocado/core/DataType.hpp>
+#include <Avocado/core/Device.hpp>
+
+#include <exception>
+#include <iostream>
+
+using namespace avocado;
+using namespace avocado::bench;
+
+namespace
+{
+	void print_help()
+	{
+		std::cout << "Usage: bench_ops [--name=value ...]\n";
+		std::cout << "  --ops=gemm,...              operators to run (default is all)\n";
+		std::cout << "  --sizes=64,256,1024         problem sizes (matrix dimension or number of rows)\n";
+		std::cout << "  --dtypes=float32            data types\n";
+		std::cout << "  --math=exact                accuracy modes of transcendental functions (exact, fast, fastest)\n";
+		std::cout << "  --device=cpu                device, for example 'cpu' or 'cuda:0'\n";
+		std::cout << "  --warmup=3                  number of unmeasured iterations\n";
+		std::cout << "  --iterations=20             number of measured iterations\n";
+		std::cout << "  --reference                 also run the ReferenceBackend implementation (where available) and compare results\n";
+		std::cout << "  --output=-                  path to the JSON file with results, '-' means standard output\n";
+	}
+	std::string join(const std::vector<std::string> &list)
+	{
+		std::string result;
+		for (size_t i = 0; i < list.size(); i++)
+			result += (i == 0 ? "" : ",") + list[i];
+		return result;
+	}
+
+	Json run(const Context &context, OperatorCase &operatorCase, const Roofline &roofline, bool compare, int warmup, int iterations)
+	{
+		const Statistics time = measure(context, operatorCase.run, warmup, iterations);
+		const double achieved_flops = operatorCase.flops / time.median;
+		const double achieved_bandwidth = operatorCase.bytes / time.median;
+
+		Json result(JsonType::Object);
+		result["time"] = time.toJson();
+		result["GFLOP/s"] = 1.0e-9 * achieved_flops;
+		result["GB/s"] = 1.0e-9 * achieved_bandwidth;
+		if (operatorCase.flops > 0.0)
+		{
+			const double intensity = operatorCase.flops / operatorCase.bytes;
+			result["arithmetic intensity"] = intensity;
+			result["roofline efficiency"] = achieved_flops / roofline.attainableFlops(intensity);
+		}
+		else
+			result["roofline efficiency"] = achieved_bandwidth / roofline.bandwidth; // pure data movement
+
+		if (compare)
+		{
+			if (operatorCase.runReference)
+			{
+				const Statistics reference_time = measure(context, operatorCase.runReference, std::min(warmup, 1), std::min(iterations, 3));
+				result["reference time"] = reference_time.toJson();
+				result["speedup over reference"] = reference_time.median / time.median;
+				result["max difference"] = compareWithReference(operatorCase);
+			}
+			else
+				result["reference"] = "not available";
+		}
+		return result;
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	try
+	{
+		const ArgumentParser args(argc, argv);
+		if (args.has("help"))
+		{
+			print_help();
+			return 0;
+		}
+		const Device device = Device::fromString(args.getString("device", "cpu"));
+		const std::vector<std::string> operators = args.getStrings("ops", join(availableOperators()));
+		const std::vector<int> sizes = args.getInts("sizes", "64,256,1024");
+		const std::vector<std::string> dtypes = args.getStrings("dtypes", "float32");
+		const std::vector<std::string> math_modes = args.getStrings("math", "exact");
+		const int warmup = args.getInt("warmup", 3);
+		const int iterations = args.getInt("iterations", 20);
+		const bool compare = args.has("reference");
+
+		Context context(device);
+		context.activate();
+
+		Json rooflines(JsonType::Object);
+		Json results(JsonType::Array);
+		for (size_t d = 0; d < dtypes.size(); d++)
+		{
+			const DataType dtype = typeFromString(dtypes[d]);
+			if (not device.supportsType(dtype))
+			{
+				std::cerr << "skipping unsupported dtype " << dtypes[d] << std::endl;
+				continue;
+			}
+			std::cerr << "measuring roofline for " << dtypes[d] << std::endl;
+			const Roofline roofline = Roofline::measure(context, dtype);
+			Json tmp(JsonType::Object);
+			tmp["peak GFLOP/s"] = 1.0e-9 * roofline.peakFlops;
+			tmp["bandwidth GB/s"] = 1.0e-9 * roofline.bandwidth;
+			rooflines[dtypes[d]] = tmp;
+
+			for (size_t m = 0; m < math_modes.size(); m++)
+				for (size_t o = 0; o < operators.size(); o++)
+					for (size_t s = 0; s < sizes.size(); s++)
+					{
+						Json entry(JsonType::Object);
+						entry["operator"] = operators[o];
+						entry["size"] = sizes[s];
+						entry["dtype"] = dtypes[d];
+						entry["math"] = math_modes[m];
+						try
+						{
+							context.setFastMathMode(fastMathModeFromString(math_modes[m]));
+							OperatorCase operatorCase = createOperatorCase(context, operators[o], sizes[s], dtype);
+							entry["shape"] = operatorCase.shape;
+							entry["flops"] = operatorCase.flops;
+							entry["bytes"] = operatorCase.bytes;
+							std::cerr << operators[o] << " : " << operatorCase.shape << ' ' << dtypes[d] << ' ' << math_modes[m] << std::endl;
+							entry["results"] = run(context, operatorCase, roofline, compare, warmup, iterations);
+						} catch (std::exception &e)
+						{ // single unsupported configuration should not stop the whole sweep
+							entry["skipped"] = std::string(e.what());
+						}
+						results[results.size()] = entry;
+					}
+		}
+
+		Json settings(JsonType::Object);
+		settings["warmup"] = warmup;
+		settings["iterations"] = iterations;
+
+		Json output(JsonType::Object);
+		output["benchmark"] = "operators";
+		output["environment"] = environment(device);
+		output["settings"] = settings;
+		output["roofline"] = rooflines;
+		output["results"] = results;
+		saveResults(output, args.getString("output", "-"));
+	} catch (std::exception &e)
+	{
+		std::cerr << "bench_ops failed : " << e.what() << std::endl;
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,174 @@
+/*
+ * bench_utils.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include "bench_utils.hpp"
+
+#include <Avocado/core/Device.hpp>
+#include <Avocado/core/error_handling.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace
+{
+	std::vector<std::string> split(const std::string &str, char delimiter)
+	{
+		std::vector<std::string> result;
+		std::stringstream ss(str);
+		std::string item;
+		while (std::getline(ss, item, delimiter))
+			if (not item.empty())
+				result.push_back(item);
+		return result;
+	}
+}
+
+namespace avocado
+{
+	namespace bench
+	{
+		ArgumentParser::ArgumentParser(int argc, char *argv[])
+		{
+			for (int i = 1; i < argc; i++)
+			{
+				const std::string arg(argv[i]);
+				if (arg.substr(0, 2) != "--")
+					throw IllegalArgument(METHOD_NAME, "argument", "must be in the form '--name=value'", arg);
+				const size_t split_point = arg.find('=');
+				if (split_point == std::string::npos)
+					m_values[arg.substr(2)] = "";
+				else
+					m_values[arg.substr(2, split_point - 2)] = arg.substr(split_point + 1);
+			}
+		}
+		bool ArgumentParser::has(const std::string &name) const
+		{
+			return m_values.find(name) != m_values.end();
+		}
+		std::string ArgumentParser::getString(const std::string &name, const std::string &defaultValue) const
+		{
+			auto iter = m_values.find(name);
+			return (iter == m_values.end()) ? defaultValue : iter->second;
+		}
+		int ArgumentParser::getInt(const std::string &name, int defaultValue) const
+		{
+			return has(name) ? std::stoi(getString(name, "")) : defaultValue;
+		}
+		double ArgumentParser::getDouble(const std::string &name, double defaultValue) const
+		{
+			return has(name) ? std::stod(getString(name, "")) : defaultValue;
+		}
+		std::vector<std::string> ArgumentParser::getStrings(const std::string &name, const std::string &defaultValue) const
+		{
+			return split(getString(name, defaultValue), ',');
+		}
+		std::vector<int> ArgumentParser::getInts(const std::string &name, const std::string &defaultValue) const
+		{
+			const std::vector<std::string> tmp = getStrings(name, defaultValue);
+			std::vector<int> result;
+			for (size_t i = 0; i < tmp.size(); i++)
+				result.push_back(std::stoi(tmp[i]));
+			return result;
+		}
+
+		Statistics Statistics::from(std::vector<double> times)
+		{
+			Statistics result;
+			if (times.empty())
+				return result;
+			std::sort(times.begin(), times.end());
+			result.samples = static_cast<int>(times.size());
+			result.min = times.front();
+			result.max = times.back();
+			const size_t middle = times.size() / 2;
+			result.median = (times.size() % 2 == 1) ? times[middle] : 0.5 * (times[middle - 1] + times[middle]);
+			for (size_t i = 0; i < times.size(); i++)
+				result.mean += times[i];
+			result.mean /= times.size();
+			for (size_t i = 0; i < times.size(); i++)
+				result.stddev += (times[i] - result.mean) * (times[i] - result.mean);
+			result.stddev = std::sqrt(result.stddev / times.size());
+			return result;
+		}
+		Json Statistics::toJson() const
+		{
+			Json result(JsonType::Object);
+			result["samples"] = samples;
+			result["mean [ms]"] = 1.0e3 * mean;
+			result["median [ms]"] = 1.0e3 * median;
+			result["min [ms]"] = 1.0e3 * min;
+			result["max [ms]"] = 1.0e3 * max;
+			result["stddev [ms]"] = 1.0e3 * stddev;
+			return result;
+		}
+
+		Statistics measure(const Context &context, const std::function<void()> &function, int warmup, int iterations)
+		{
+			for (int i = 0; i < warmup; i++)
+				function();
+			context.synchronize();
+
+			std::vector<double> times;
+			times.reserve(iterations);
+			for (int i = 0; i < iterations; i++)
+			{
+				const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+				function();
+				context.synchronize();
+				times.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+			}
+			return Statistics::from(times);
+		}
+
+		Json toJson(const MemoryUsage &usage)
+		{
+			Json result(JsonType::Object);
+			result["total"] = usage.total;
+			for (int i = 0; i < number_of_memory_categories; i++)
+				result[toString(static_cast<MemoryCategory>(i))] = usage.bytes[i];
+			return result;
+		}
+		Json environment(Device device)
+		{
+			Json result(JsonType::Object);
+			result["device"] = device.toString();
+			result["device name"] = device.name();
+			if (device.isCPU())
+			{
+				result["cores"] = device.cores();
+				result["default threads"] = device.getNumberOfThreads();
+			}
+			result["hardware"] = Device::hardwareInfo();
+#if defined(__VERSION__)
+			result["compiler"] = __VERSION__;
+#endif
+			result["build"] = __DATE__ " " __TIME__;
+#if defined(NDEBUG)
+			result["debug"] = false;
+#else
+			result["debug"] = true;
+#endif
+			return result;
+		}
+		void saveResults(const Json &results, const std::string &path)
+		{
+			if (path.empty() or path == "-")
+			{
+				std::cout << results.dump(2) << '\n';
+				return;
+			}
+			std::ofstream stream(path);
+			if (not stream.good())
+				throw RuntimeError(METHOD_NAME, "could not open file '" + path + "'");
+			stream << results.dump(2) << '\n';
+		}
+
+	} /* namespace bench */
+} /* namespace avocado */
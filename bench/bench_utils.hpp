@@ -0,0 +1,74 @@
+/*
+ * bench_utils.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#ifndef AVOCADO_BENCH_BENCH_UTILS_HPP_
+#define AVOCADO_BENCH_BENCH_UTILS_HPP_
+
+#include <Avocado/core/Context.hpp>
+#include <Avocado/core/MemoryTracker.hpp>
+#include <Avocado/utils/json.hpp>
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace avocado
+{
+	namespace bench
+	{
+		/*
+		 * Parses arguments in the form '--name=value'. Lists are separated with commas.
+		 */
+		class ArgumentParser
+		{
+			private:
+				std::map<std::string, std::string> m_values;
+			public:
+				ArgumentParser(int argc, char *argv[]);
+				bool has(const std::string &name) const;
+				std::string getString(const std::string &name, const std::string &defaultValue) const;
+				int getInt(const std::string &name, int defaultValue) const;
+				double getDouble(const std::string &name, double defaultValue) const;
+				std::vector<std::string> getStrings(const std::string &name, const std::string &defaultValue) const;
+				std::vector<int> getInts(const std::string &name, const std::string &defaultValue) const;
+		};
+
+		struct Statistics
+		{
+				int samples = 0;
+				double mean = 0.0; // all times are in seconds
+				double median = 0.0;
+				double min = 0.0;
+				double max = 0.0;
+				double stddev = 0.0;
+
+				static Statistics from(std::vector<double> times);
+				Json toJson() const; // times are stored in milliseconds
+		};
+
+		/*
+		 * Runs the function 'warmup' times without measuring, then measures each of the following 'iterations' calls.
+		 * Context is synchronized after every call so that asynchronous devices are timed correctly.
+		 */
+		Statistics measure(const Context &context, const std::function<void()> &function, int warmup, int iterations);
+
+		Json toJson(const MemoryUsage &usage);
+		/*
+		 * Description of the machine and the build, stored with the results so that runs can be compared.
+		 */
+		Json environment(Device device);
+		/*
+		 * Writes results to a file, or to the standard output if the path is empty or '-'.
+		 */
+		void saveResults(const Json &results, const std::string &path);
+
+	} /* namespace bench */
+} /* namespace avocado */
+
+#endif /* AVOCADO_BENCH_BENCH_UTILS_HPP_ */
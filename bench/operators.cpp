@@ -0,0 +1,380 @@
+/*
+ * operators.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include "operators.hpp"
+#include "bench_utils.hpp"
+
+#include <Avocado/math/activations.hpp>
+#include <Avocado/math/batchnorm.hpp>
+#include <Avocado/math/conversions.hpp>
+#include <Avocado/math/fast_math.hpp>
+#include <Avocado/math/tensor_operations.hpp>
+#include <Avocado/core/Context.hpp>
+#include <Avocado/core/Scalar.hpp>
+#include <Avocado/core/error_handling.hpp>
+
+#if defined(USE_REFERENCE_BACKEND)
+#  include <Avocado/backend/backend_defs.h>
+#  include <ReferenceBackend/reference_backend.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+	using namespace avocado;
+	using namespace avocado::bench;
+
+	std::shared_ptr<Tensor> create_tensor(OperatorCase &result, const Shape &shape, DataType dtype, Device device, double phase = 0.0)
+	{
+		std::vector<double> values(shape.volume());
+		for (size_t i = 0; i < values.size(); i++)
+			values[i] = 0.5 * std::sin(0.37 * i + phase);
+		std::vector<uint8_t> raw(values.size() * sizeOf(dtype));
+		math::changeType(raw.data(), dtype, values.data(), DataType::FLOAT64, values.size());
+
+		std::shared_ptr<Tensor> tensor = std::make_shared<Tensor>(shape, dtype, device);
+		tensor->copyFromHost(raw.data(), values.size());
+		result.tensors.push_back(tensor);
+		return tensor;
+	}
+	std::vector<double> to_double(const Tensor &tensor)
+	{
+		std::vector<uint8_t> raw(tensor.sizeInBytes());
+		tensor.copyToHost(raw.data(), tensor.volume());
+		std::vector<double> result(tensor.volume());
+		math::changeType(result.data(), DataType::FLOAT64, raw.data(), tensor.dtype(), result.size());
+		return result;
+	}
+	double bytes_of(const Tensor &tensor)
+	{
+		return static_cast<double>(tensor.sizeInBytes());
+	}
+	DataType other_type(DataType dtype) noexcept
+	{
+		return (dtype == DataType::FLOAT32) ? DataType::FLOAT16 : DataType::FLOAT32;
+	}
+
+#if defined(USE_REFERENCE_BACKEND)
+	void reference_gemm(Tensor &C, const Tensor &A, const Tensor &B, int batch)
+	{ // gemmBatched is done as a sequence of gemms on views
+		Scalar alpha(1);
+		Scalar beta(0);
+		alpha.toScalingTypeFor(C.dtype());
+		beta.toScalingTypeFor(C.dtype());
+		const Shape shape_A( { A.dimension(A.numberOfDimensions() - 2), A.lastDim() });
+		const Shape shape_B( { B.dimension(B.numberOfDimensions() - 2), B.lastDim() });
+		const Shape shape_C( { C.dimension(C.numberOfDimensions() - 2), C.lastDim() });
+		for (int i = 0; i < batch; i++)
+		{
+			Tensor view_A = const_cast<Tensor&>(A).view(shape_A, i * shape_A.volume());
+			Tensor view_B = const_cast<Tensor&>(B).view(shape_B, i * shape_B.volume());
+			Tensor view_C = C.view(shape_C, i * shape_C.volume());
+			backend::refGemm(0, static_cast<backend::avGemmOperation_t>(GemmOp::OP_N), static_cast<backend::avGemmOperation_t>(GemmOp::OP_N),
+					alpha.data(), view_A.getDescriptor(), view_A.getMemory(), view_B.getDescriptor(), view_B.getMemory(), beta.data(),
+					view_C.getDescriptor(), view_C.getMemory());
+		}
+	}
+#endif
+
+	OperatorCase create_gemm(const Context &context, int size, DataType dtype, int batch)
+	{
+		OperatorCase result;
+		result.name = (batch == 0) ? "gemm" : "gemmBatched";
+		const Shape shape = (batch == 0) ? Shape( { size, size }) : Shape( { batch, size, size });
+		std::shared_ptr<Tensor> A = create_tensor(result, shape, dtype, context.device(), 0.0);
+		std::shared_ptr<Tensor> B = create_tensor(result, shape, dtype, context.device(), 1.57);
+		std::shared_ptr<Tensor> C = create_tensor(result, shape, dtype, context.device());
+		result.shape = shape.toString();
+		result.flops = 2.0 * std::max(1, batch) * size * size * static_cast<double>(size);
+		result.bytes = bytes_of(*A) + bytes_of(*B) + bytes_of(*C);
+		if (batch == 0)
+			result.run = [&context, A, B, C]()
+			{
+				math::gemm(context, GemmOp::OP_N, GemmOp::OP_N, *C, *A, *B, 1, 0);
+			};
+		else
+			result.run = [&context, A, B, C]()
+			{
+				math::gemmBatched(context, GemmOp::OP_N, GemmOp::OP_N, *C, *A, *B, 1, 0);
+			};
+#if defined(USE_REFERENCE_BACKEND)
+		if (context.device().isCPU())
+		{
+			result.output = C.get();
+			result.referenceOutput = std::make_shared<Tensor>(shape, dtype, context.device());
+			std::shared_ptr<Tensor> reference = result.referenceOutput;
+			result.runReference = [A, B, reference, batch]()
+			{
+				reference_gemm(*reference, *A, *B, std::max(1, batch));
+			};
+		}
+#endif
+		return result;
+	}
+	OperatorCase create_binary_op(const Context &context, int size, DataType dtype)
+	{
+		OperatorCase result;
+		result.name = "tensorBinaryOp";
+		const Shape shape( { size, size });
+		std::shared_ptr<Tensor> a = create_tensor(result, shape, dtype, context.device(), 0.0);
+		std::shared_ptr<Tensor> b = create_tensor(result, shape, dtype, context.device(), 1.0);
+		std::shared_ptr<Tensor> c = create_tensor(result, shape, dtype, context.device());
+		result.shape = shape.toString();
+		result.flops = shape.volume();
+		result.bytes = 3.0 * bytes_of(*a);
+		result.run = [&context, a, b, c]()
+		{
+			math::tensorBinaryOp(context, TensorBinaryOp::ADD, 1, *a, 1, *b, 0, *c);
+		};
+		return result;
+	}
+	OperatorCase create_reduce(const Context &context, int size, DataType dtype)
+	{
+		OperatorCase result;
+		result.name = "reduceTensor";
+		const Shape shape( { size, size });
+		std::shared_ptr<Tensor> src = create_tensor(result, shape, dtype, context.device());
+		std::shared_ptr<Tensor> dst = create_tensor(result, Shape( { 1, size }), dtype, context.device());
+		result.shape = shape.toString();
+		result.flops = shape.volume();
+		result.bytes = bytes_of(*src) + bytes_of(*dst);
+		result.run = [&context, src, dst]()
+		{
+			math::reduceTensor(context, TensorReduceOp::ADD, 1, 0, *src, *dst);
+		};
+		return result;
+	}
+	OperatorCase create_activation(const Context &context, int size, DataType dtype)
+	{
+		OperatorCase result;
+		result.name = "activationForward";
+		const Shape shape( { size, size });
+		std::shared_ptr<Tensor> input = create_tensor(result, shape, dtype, context.device());
+		std::shared_ptr<Tensor> output = create_tensor(result, shape, dtype, context.device());
+		result.shape = shape.toString() + " sigmoid";
+		result.flops = 4.0 * shape.volume(); // exp, add, division and scaling
+		result.bytes = 2.0 * bytes_of(*input);
+		result.run = [&context, input, output]()
+		{
+			math::activationForward(context, NonlinearityType::SIGMOID, 1, *input, 0, *output);
+		};
+		return result;
+	}
+	OperatorCase create_softmax(const Context &context, int size, DataType dtype)
+	{
+		OperatorCase result;
+		result.name = "softmaxForward";
+		const Shape shape( { size, size });
+		std::shared_ptr<Tensor> input = create_tensor(result, shape, dtype, context.device());
+		std::shared_ptr<Tensor> output = create_tensor(result, shape, dtype, context.device());
+		result.shape = shape.toString();
+		result.flops = 5.0 * shape.volume(); // max, subtraction, exp, sum and division
+		result.bytes = 2.0 * bytes_of(*input);
+		result.run = [&context, input, output]()
+		{
+			math::softmaxForward(context, SoftmaxMode::PER_CHANNEL, 1, *input, 0, *output);
+		};
+		return result;
+	}
+	OperatorCase create_batchnorm(const Context &context, int size, DataType dtype)
+	{
+		OperatorCase result;
+		result.name = "batchNormForward";
+		const int channels = std::min(size, 256);
+		const Shape shape( { size, size * size / channels, channels });
+		std::shared_ptr<Tensor> input = create_tensor(result, shape, dtype, context.device());
+		std::shared_ptr<Tensor> output = create_tensor(result, shape, dtype, context.device());
+		std::shared_ptr<Tensor> scale = create_tensor(result, Shape( { channels }), dtype, context.device());
+		std::shared_ptr<Tensor> bias = create_tensor(result, Shape( { channels }), dtype, context.device());
+		std::shared_ptr<Tensor> mean = create_tensor(result, Shape( { channels }), dtype, context.device());
+		std::shared_ptr<Tensor> variance = create_tensor(result, Shape( { channels }), dtype, context.device());
+		result.shape = shape.toString();
+		result.flops = 7.0 * shape.volume(); // statistics and normalization
+		result.bytes = 3.0 * bytes_of(*input); // input is read twice
+		result.run = [&context, input, output, scale, bias, mean, variance]()
+		{
+			math::batchNormForward(context, 1, 0, *input, *output, *scale, *bias, *mean, *variance, 1.0e-3, NonlinearityType::LINEAR);
+		};
+		return result;
+	}
+	OperatorCase create_change_type(const Context &context, int size, DataType dtype)
+	{
+		OperatorCase result;
+		result.name = "changeType";
+		const Shape shape( { size, size });
+		std::shared_ptr<Tensor> src = create_tensor(result, shape, dtype, context.device());
+		std::shared_ptr<Tensor> dst = create_tensor(result, shape, other_type(dtype), context.device());
+		result.shape = shape.toString() + " to " + toString(other_type(dtype));
+		result.bytes = bytes_of(*src) + bytes_of(*dst);
+		result.run = [&context, src, dst]()
+		{
+			math::changeType(context, *dst, *src);
+		};
+		return result;
+	}
+	OperatorCase create_concat(const Context &context, int size, DataType dtype, bool split)
+	{
+		OperatorCase result;
+		result.name = split ? "splitTensors" : "concatTensors";
+		const Shape shape( { size, size });
+		std::shared_ptr<Tensor> whole = create_tensor(result, shape, dtype, context.device());
+		std::shared_ptr<std::vector<Tensor>> parts = std::make_shared<std::vector<Tensor>>();
+		for (int i = 0; i < 4; i++)
+			parts->push_back(Tensor(Shape( { size, size / 4 }), dtype, context.device()));
+		result.shape = shape.toString() + " in 4 parts";
+		result.bytes = 2.0 * bytes_of(*whole);
+		if (split)
+			result.run = [&context, whole, parts]()
+			{
+				math::splitTensors(context, *parts, *whole);
+			};
+		else
+			result.run = [&context, whole, parts]()
+			{
+				math::concatTensors(context, *whole, *parts);
+			};
+		return result;
+	}
+	OperatorCase create_transpose(const Context &context, int size, DataType dtype)
+	{
+		OperatorCase result;
+		result.name = "transposeTensor";
+		const Shape shape( { 4, size, size });
+		std::shared_ptr<Tensor> src = create_tensor(result, shape, dtype, context.device());
+		std::shared_ptr<Tensor> dst = create_tensor(result, shape, dtype, context.device());
+		result.shape = shape.toString() + " order {0, 2, 1}";
+		result.bytes = 2.0 * bytes_of(*src);
+		result.run = [&context, src, dst]()
+		{
+			math::transposeTensor(context, *dst, *src, { 0, 2, 1 });
+		};
+		return result;
+	}
+	OperatorCase create_fast_function(const Context &context, const std::string &name, int size, DataType dtype)
+	{
+		if (dtype != DataType::FLOAT32 or not context.device().isCPU())
+			throw LogicError(METHOD_NAME, "'" + name + "' is implemented only for float32 on CPU");
+
+		typedef void (*Function)(FastMathMode, const float*, float*, size_t);
+		Function function = math::fastExp;
+		double flops_per_element = 12.0; // approximate number of arithmetic operations in the FAST kernel
+		if (name == "fastLog")
+		{
+			function = math::fastLog;
+			flops_per_element = 20.0;
+		}
+		if (name == "fastTanh")
+		{
+			function = math::fastTanh;
+			flops_per_element = 24.0;
+		}
+		if (name == "fastSigmoid")
+		{
+			function = math::fastSigmoid;
+			flops_per_element = 14.0;
+		}
+
+		OperatorCase result;
+		result.name = name;
+		const Shape shape( { size, size });
+		std::shared_ptr<Tensor> src = create_tensor(result, shape, dtype, context.device());
+		std::shared_ptr<Tensor> dst = create_tensor(result, shape, dtype, context.device());
+		math::fastExp(FastMathMode::EXACT, reinterpret_cast<const float*>(src->data()), reinterpret_cast<float*>(src->data()), src->volume()); // positive inputs for log
+		result.shape = shape.toString() + ' ' + toString(context.fastMathMode());
+		result.flops = flops_per_element * shape.volume();
+		result.bytes = 2.0 * bytes_of(*src);
+		const FastMathMode mode = context.fastMathMode();
+		result.run = [function, mode, src, dst]()
+		{
+			function(mode, reinterpret_cast<const float*>(src->data()), reinterpret_cast<float*>(dst->data()), src->volume());
+		};
+		return result;
+	}
+}
+
+namespace avocado
+{
+	namespace bench
+	{
+		Roofline Roofline::measure(const Context &context, DataType dtype)
+		{
+			Roofline result;
+			OperatorCase gemm = create_gemm(context, 1024, dtype, 0);
+			const Statistics gemm_time = bench::measure(context, gemm.run, 2, 5);
+			result.peakFlops = gemm.flops / gemm_time.min;
+
+			const Shape shape( { 64 * 1024 * 1024 / static_cast<int>(sizeOf(dtype)) }); // 64MB exceeds any cache
+			Tensor src(shape, dtype, context.device());
+			Tensor dst(shape, dtype, context.device());
+			math::zeroTensor(context, src);
+			math::zeroTensor(context, dst);
+			const Statistics copy_time = bench::measure(context, [&]()
+			{
+				math::copyTensor(context, dst, src);
+			}, 2, 10);
+			result.bandwidth = (bytes_of(src) + bytes_of(dst)) / copy_time.min;
+			return result;
+		}
+		double Roofline::attainableFlops(double intensity) const noexcept
+		{
+			return std::min(peakFlops, bandwidth * intensity);
+		}
+
+		std::vector<std::string> availableOperators()
+		{
+			return std::vector<std::string>( { "gemm", "gemmBatched", "tensorBinaryOp", "reduceTensor", "activationForward", "softmaxForward",
+					"batchNormForward", "changeType", "concatTensors", "splitTensors", "transposeTensor", "fastExp", "fastLog", "fastTanh", "fastSigmoid" });
+		}
+		OperatorCase createOperatorCase(const Context &context, const std::string &name, int size, DataType dtype)
+		{
+			if (not context.device().supportsType(dtype))
+				throw DataTypeNotSupported(METHOD_NAME, dtype);
+			if (size < 4)
+				throw IllegalArgument(METHOD_NAME, "size", "must be at least 4", size);
+
+			if (name == "gemm")
+				return create_gemm(context, size, dtype, 0);
+			if (name == "gemmBatched")
+				return create_gemm(context, size, dtype, 8);
+			if (name == "tensorBinaryOp")
+				return create_binary_op(context, size, dtype);
+			if (name == "reduceTensor")
+				return create_reduce(context, size, dtype);
+			if (name == "activationForward")
+				return create_activation(context, size, dtype);
+			if (name == "softmaxForward")
+				return create_softmax(context, size, dtype);
+			if (name == "batchNormForward")
+				return create_batchnorm(context, size, dtype);
+			if (name == "changeType")
+				return create_change_type(context, size, dtype);
+			if (name == "concatTensors")
+				return create_concat(context, size, dtype, false);
+			if (name == "splitTensors")
+				return create_concat(context, size, dtype, true);
+			if (name == "transposeTensor")
+				return create_transpose(context, size, dtype);
+			if (name == "fastExp" or name == "fastLog" or name == "fastTanh" or name == "fastSigmoid")
+				return create_fast_function(context, name, size, dtype);
+			throw IllegalArgument(METHOD_NAME, "name", "unknown operator", name);
+		}
+		double compareWithReference(const OperatorCase &operatorCase)
+		{
+			if (operatorCase.output == nullptr or operatorCase.referenceOutput == nullptr)
+				throw LogicError(METHOD_NAME, "operator '" + operatorCase.name + "' has no reference implementation");
+			const std::vector<double> tested = to_double(*operatorCase.output);
+			const std::vector<double> reference = to_double(*operatorCase.referenceOutput);
+			double result = 0.0;
+			for (size_t i = 0; i < tested.size(); i++)
+				result = std::max(result, std::fabs(tested[i] - reference[i]));
+			return result;
+		}
+
+	} /* namespace bench */
+} /* namespace avocado */
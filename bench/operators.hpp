@@ -0,0 +1,79 @@
+/*
+ * operators.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#ifndef AVOCADO_BENCH_OPERATORS_HPP_
+#define AVOCADO_BENCH_OPERATORS_HPP_
+
+#include <Avocado/core/Tensor.hpp>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace avocado /* forward declarations */
+{
+	class Context;
+}
+
+namespace avocado
+{
+	namespace bench
+	{
+		/*
+		 * Single configuration of a math:: function together with its nominal amount of work.
+		 * Tensors used by the operation are owned by the case so it can be run repeatedly.
+		 */
+		struct OperatorCase
+		{
+				std::string name;
+				std::string shape; // human readable description of the problem size
+				double flops = 0.0;
+				double bytes = 0.0; // minimal memory traffic, each tensor read or written once
+
+				std::vector<std::shared_ptr<Tensor>> tensors;
+				std::function<void()> run;
+
+				/*
+				 * Optional implementation from the ReferenceBackend writing to 'referenceOutput'.
+				 * Its result is compared with 'output' produced by 'run'.
+				 */
+				std::function<void()> runReference;
+				const Tensor *output = nullptr;
+				std::shared_ptr<Tensor> referenceOutput;
+		};
+
+		/*
+		 * Peak performance of a device measured with large gemm and copy operations.
+		 */
+		struct Roofline
+		{
+				double peakFlops = 0.0; // in FLOP/s
+				double bandwidth = 0.0; // in bytes/s
+
+				static Roofline measure(const Context &context, DataType dtype);
+				/*
+				 * Highest performance achievable by an operation with given arithmetic intensity (flops per byte).
+				 */
+				double attainableFlops(double intensity) const noexcept;
+		};
+
+		std::vector<std::string> availableOperators();
+		/*
+		 * Creates case of given operator with problem size characterized by a single number 'size'.
+		 * Throws if the operator does not support the dtype on the device of the context.
+		 */
+		OperatorCase createOperatorCase(const Context &context, const std::string &name, int size, DataType dtype);
+		/*
+		 * Maximum absolute difference between output and reference output of a case after calling both 'run' and 'runReference'.
+		 */
+		double compareWithReference(const OperatorCase &operatorCase);
+
+	} /* namespace bench */
+} /* namespace avocado */
+
+#endif /* AVOCADO_BENCH_OPERATORS_HPP_ */
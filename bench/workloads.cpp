@@ -0,0 +1,96 @@
+/*
+ * workloads.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include "workloads.hpp"
+
+#include <Avocado/graph/Graph.hpp>
+#include <Avocado/layers/Dense.hpp>
+#include <Avocado/layers/Softmax.hpp>
+#include <Avocado/losses/CrossEntropyLoss.hpp>
+#include <Avocado/losses/MeanSquareLoss.hpp>
+#include <Avocado/optimizers/SGD.hpp>
+#include <Avocado/core/Tensor.hpp>
+#include <Avocado/core/error_handling.hpp>
+
+#include <cmath>
+
+namespace
+{
+	using namespace avocado;
+
+	const int number_of_classes = 10;
+
+	void create_mlp(Graph &graph, int batchSize)
+	{
+		auto x = graph.addInput( { batchSize, 256 });
+		for (int i = 0; i < 3; i++)
+			x = graph.add(Dense(512, "relu"), x);
+		x = graph.add(Dense(64), x);
+		graph.addOutput(x, MeanSquareLoss());
+	}
+	void create_classifier(Graph &graph, int batchSize)
+	{
+		auto x = graph.addInput( { batchSize, 784 });
+		x = graph.add(Dense(256, "relu"), x);
+		x = graph.add(Dense(number_of_classes), x);
+		x = graph.add(Softmax(), x);
+		graph.addOutput(x, CrossEntropyLoss());
+	}
+
+	void fill_input(Tensor &tensor)
+	{
+		std::vector<float> tmp(tensor.volume());
+		for (size_t i = 0; i < tmp.size(); i++)
+			tmp[i] = 0.5f * std::sin(0.37f * i);
+		tensor.copyFromHost(tmp.data(), tmp.size());
+	}
+	void fill_target(Tensor &tensor, bool oneHot)
+	{
+		std::vector<float> tmp(tensor.volume(), 0.0f);
+		const int batch = tensor.firstDim();
+		const int length = static_cast<int>(tensor.volume()) / batch;
+		for (int b = 0; b < batch; b++)
+			for (int i = 0; i < length; i++)
+			{
+				if (oneHot)
+					tmp[b * length + i] = (i == (7 * b) % length) ? 1.0f : 0.0f;
+				else
+					tmp[b * length + i] = 0.1f * std::cos(0.5f * (b + i));
+			}
+		tensor.copyFromHost(tmp.data(), tmp.size());
+	}
+}
+
+namespace avocado
+{
+	namespace bench
+	{
+		std::vector<std::string> availableWorkloads()
+		{
+			return std::vector<std::string>( { "mlp", "classifier" });
+		}
+
+		void createWorkload(Graph &graph, const std::string &name, int batchSize)
+		{
+			if (name == "mlp")
+				create_mlp(graph, batchSize);
+			else
+			{
+				if (name == "classifier")
+					create_classifier(graph, batchSize);
+				else
+					throw IllegalArgument(METHOD_NAME, "name", "unknown workload", name);
+			}
+			graph.setOptimizer(SGD(1.0e-3));
+			graph.init();
+
+			fill_input(graph.getInput());
+			fill_target(graph.getTarget(), name == "classifier");
+		}
+
+	} /* namespace bench */
+} /* namespace avocado */
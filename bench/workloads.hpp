@@ -0,0 +1,40 @@
+/*
+ * workloads.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#ifndef AVOCADO_BENCH_WORKLOADS_HPP_
+#define AVOCADO_BENCH_WORKLOADS_HPP_
+
+#include <string>
+#include <vector>
+
+namespace avocado /* forward declarations */
+{
+	class Graph;
+}
+
+namespace avocado
+{
+	namespace bench
+	{
+		/*
+		 * Canonical models used to track performance between builds:
+		 *  - 'mlp'        : stack of Dense layers with MeanSquareLoss,
+		 *  - 'classifier' : Dense layers followed by Softmax and CrossEntropyLoss.
+		 * Their architecture must not change, otherwise results of different builds cannot be compared.
+		 * There is no convolutional workload as Conv2D has no forward and backward implementation yet.
+		 */
+		std::vector<std::string> availableWorkloads();
+
+		/*
+		 * Builds given workload into an empty graph, initializes it and fills inputs and targets with fixed pseudo-random data.
+		 */
+		void createWorkload(Graph &graph, const std::string &name, int batchSize);
+
+	} /* namespace bench */
+} /* namespace avocado */
+
+#endif /* AVOCADO_BENCH_WORKLOADS_HPP_ */
@@ -9,18 +9,69 @@
 #define AVOCADO_CORE_CONTEXT_HPP_
 
 #include <Avocado/core/Device.hpp>
+#include <Avocado/core/MemoryTracker.hpp>
 #include <Avocado/backend_defs.h>
 
+#include <string>
+#include <vector>
+
 namespace avocado
 {
 
+	/*
+	 * Set of host cores that threads working for a single Context are pinned to.
+	 * Empty group means that threads are not pinned and may run on any core.
+	 */
+	class ThreadGroup
+	{
+		private:
+			std::vector<int> m_cores;
+			int m_numa_node = -1;
+		public:
+			ThreadGroup() = default;
+			ThreadGroup(const std::vector<int> &cores, int numaNode = -1);
+
+			static ThreadGroup forNumaNode(int node);
+			static ThreadGroup forSocket(int socket);
+			/*
+			 * Splits all available cores into given number of disjoint groups.
+			 * Groups never cross NUMA node boundaries unless there are more nodes than groups.
+			 * Number of groups must be in range [1, number of cores], so that none of them is empty.
+			 */
+			static std::vector<ThreadGroup> partition(int numberOfGroups);
+			static std::vector<ThreadGroup> partition(int numberOfGroups, const CpuTopology &topology);
+
+			const std::vector<int>& cores() const noexcept;
+			int numaNode() const noexcept;
+			int size() const noexcept;
+			bool isEmpty() const noexcept;
+			std::string toString() const;
+	};
+
+	/*
+	 * Accuracy of transcendental functions (exp, log, tanh, sigmoid) used by activations, softmax and losses.
+	 * EXACT uses the backend implementation, FAST guarantees error of at most 2 ulp and FASTEST at most 1e-4 relative error.
+	 * Approximations are used only for float32 tensors on CPU, other cases always use the exact implementation.
+	 */
+	enum class FastMathMode
+	{
+		EXACT,
+		FAST,
+		FASTEST
+	};
+	std::string toString(FastMathMode mode);
+	FastMathMode fastMathModeFromString(const std::string &str);
+
 	class Context
 	{
 		private:
 			backend::avContextDescriptor_t m_data = backend::AVOCADO_NULL_DESCRIPTOR;
 			Device m_device;
+			ThreadGroup m_thread_group;
+			FastMathMode m_fast_math_mode = FastMathMode::EXACT;
 		public:
 			Context(Device device = Device::cpu());
+			Context(Device device, const ThreadGroup &group);
 			~Context();
 			Context(const Context &other) = delete;
 			Context(Context &&other);
@@ -30,6 +81,28 @@ namespace avocado
 			Device device() const noexcept;
 			void synchronize() const;
 
+			const ThreadGroup& threadGroup() const noexcept;
+			/*
+			 * Pins the calling thread to the cores of this context and sets the number of OpenMP threads used by parallel regions
+			 * started from the calling thread (other threads are not affected). Must be called from each thread that uses this context.
+			 */
+			void activate() const;
+			/*
+			 * Moves pages of given host memory to the NUMA node of this context.
+			 * Returns false if the memory could not be moved (or if the context is not bound to any NUMA node).
+			 */
+			bool bindToLocalNode(const void *ptr, size_t sizeInBytes) const noexcept;
+
+			/*
+			 * Memory of the device of this context that is currently owned by tensors, and the peak since the last reset.
+			 */
+			MemoryUsage getMemoryUsage() const;
+			MemoryUsage getPeakMemoryUsage() const;
+			void resetPeakMemoryUsage() const;
+
+			void setFastMathMode(FastMathMode mode) noexcept;
+			FastMathMode fastMathMode() const noexcept;
+
 			backend::avContextDescriptor_t getDescriptor() const noexcept;
 			operator backend::avContextDescriptor_t() const noexcept;
 	};
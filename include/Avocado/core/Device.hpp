@@ -9,6 +9,8 @@
 #define CORE_DEVICE_HPP_
 
 #include <string>
+#include <vector>
+#include <cinttypes>
 #include <stdexcept>
 
 namespace avocado /* forward declarations */
@@ -40,6 +42,45 @@ namespace avocado
 		AVX512VL_BW_DQ
 	};
 
+	/*
+	 * Description of the host processors as seen by the operating system.
+	 * Cores are identified by the logical processor index used for thread affinity.
+	 */
+	struct CpuTopology
+	{
+			struct Core
+			{
+					int index = 0; // logical processor index
+					int physicalCore = 0; // index of the physical core within the socket
+					int socket = 0;
+					int numaNode = 0;
+			};
+			struct Cache
+			{
+					int level = 0;
+					int64_t size = 0; // in bytes
+					std::string type;
+					std::vector<int> sharedBy; // logical processors sharing this cache
+			};
+
+			std::vector<Core> cores;
+			std::vector<Cache> caches;
+			std::vector<std::vector<int>> numaNodes; // logical processors belonging to each NUMA node
+			int sockets = 1;
+
+			/*
+			 * Reads the topology from sysfs directory tree rooted at given path (normally "/sys/devices/system/").
+			 */
+			static CpuTopology fromSysfs(const std::string &path);
+
+			int numberOfCores() const noexcept;
+			int numberOfNumaNodes() const noexcept;
+			std::vector<int> coresOfNumaNode(int node) const;
+			std::vector<int> coresOfSocket(int socket) const;
+			int64_t cacheSize(int level, int core = 0) const noexcept;
+			std::string toString() const;
+	};
+
 	class Device
 	{
 		private:
@@ -73,6 +114,7 @@ namespace avocado
 			void setNumberOfThreads(int t) const noexcept;
 			int getNumberOfThreads() const noexcept;
 			CpuSimd simd() const noexcept;
+			static const CpuTopology& cpuTopology();
 
 			//CUDA features
 			int computeCapability() const noexcept;
@@ -0,0 +1,90 @@
+/*
+ * MemoryTracker.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#ifndef AVOCADO_CORE_MEMORYTRACKER_HPP_
+#define AVOCADO_CORE_MEMORYTRACKER_HPP_
+
+#include <Avocado/core/Device.hpp>
+
+#include <array>
+#include <string>
+
+namespace avocado
+{
+	enum class MemoryCategory
+	{
+		OTHER,
+		PARAMETERS,
+		UPDATES,
+		OPTIMIZER_WORKSPACE,
+		ACTIVATIONS,
+		GRADIENTS,
+		BACKUP,
+		WORKSPACE
+	};
+	const int number_of_memory_categories = 8;
+	std::string toString(MemoryCategory c);
+
+	struct MemoryUsage
+	{
+			std::array<size_t, number_of_memory_categories> bytes = { };
+			size_t total = 0; // for peak usage this is the peak of the total, not the sum of peaks of each category
+
+			size_t operator[](MemoryCategory c) const noexcept;
+			std::string toString() const;
+	};
+
+	/*
+	 * Counts bytes of device memory owned by tensors, split into categories.
+	 * Category of new allocations is taken from the innermost MemoryCategoryScope of the calling thread.
+	 */
+	class MemoryTracker
+	{
+		public:
+			/*
+			 * Records peak usage of a device from its creation until its destruction.
+			 */
+			class PeakWatcher
+			{
+					friend class MemoryTracker;
+					Device m_device;
+					MemoryUsage m_peak;
+				public:
+					PeakWatcher(Device device);
+					PeakWatcher(const PeakWatcher &other) = delete;
+					PeakWatcher& operator=(const PeakWatcher &other) = delete;
+					~PeakWatcher();
+					MemoryUsage getPeak() const;
+			};
+
+			static void allocated(Device device, MemoryCategory category, size_t bytes) noexcept;
+			static void freed(Device device, MemoryCategory category, size_t bytes) noexcept;
+			static void changeCategory(Device device, MemoryCategory from, MemoryCategory to, size_t bytes) noexcept;
+
+			static MemoryUsage getCurrentUsage(Device device);
+			/*
+			 * Returns peak usage since the program start or the last call to resetPeakUsage().
+			 */
+			static MemoryUsage getPeakUsage(Device device);
+			static void resetPeakUsage(Device device);
+
+			static MemoryCategory currentCategory() noexcept;
+	};
+
+	class MemoryCategoryScope
+	{
+			MemoryCategory m_previous;
+		public:
+			MemoryCategoryScope(MemoryCategory category) noexcept;
+			MemoryCategoryScope(const MemoryCategoryScope &other) = delete;
+			MemoryCategoryScope& operator=(const MemoryCategoryScope &other) = delete;
+			~MemoryCategoryScope() noexcept;
+	};
+
+} /* namespace avocado */
+
+#endif /* AVOCADO_CORE_MEMORYTRACKER_HPP_ */
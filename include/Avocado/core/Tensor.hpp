@@ -85,12 +85,20 @@ namespace avocado
 			void copyFrom(const Tensor &other);
 			void copyFrom(const Tensor &other, size_t elements);
 
+			/*
+			 * Category under which memory of this tensor is reported by MemoryTracker. Copies keep the category of the original.
+			 */
+			MemoryCategory memoryCategory() const noexcept;
+			void setMemoryCategory(MemoryCategory category) noexcept;
+
 			bool isPageLocked() const;
 			void pageLock();
 			void pageUnlock();
 
 			Tensor view();
 			Tensor view(const Shape &shape, size_t offsetInElements = 0);
+			const Tensor view() const;
+			const Tensor view(const Shape &shape, size_t offsetInElements = 0) const;
 
 			void* data();
 			const void* data() const;
@@ -0,0 +1,108 @@
+/*
+ * DataLoader.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#ifndef AVOCADO_DATA_DATALOADER_HPP_
+#define AVOCADO_DATA_DATALOADER_HPP_
+
+#include <Avocado/core/Tensor.hpp>
+
+#include <condition_variable>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace avocado /* forward declarations */
+{
+	class Dataset;
+	class Graph;
+}
+
+namespace avocado
+{
+
+	/*
+	 * Feeds a graph with batches of samples prepared in the background.
+	 * Worker threads read, decode and shuffle samples into a ring of (page locked) host staging buffers. A separate thread copies
+	 * the oldest ready batch into alternate device buffers, which next() swaps with graph inputs and targets, so the data for step N+1
+	 * is prepared and transferred while step N is being computed. To make it possible next() for step N waits for step N-1 to finish,
+	 * as its buffers become the alternate ones, but not for step N which is launched only after next() returns.
+	 * Batches are delivered in order and the stream is infinite, it continues with a new permutation of samples at every epoch.
+	 */
+	class DataLoader
+	{
+		private:
+			struct Slot
+			{
+					std::vector<Tensor> tensors; // on CPU, inputs followed by targets
+					int64_t batch = -1;
+					int size = 0;
+					bool is_ready = false;
+					std::exception_ptr error;
+			};
+
+			const Dataset &m_dataset;
+			Graph &m_graph;
+			const int m_batch_size;
+			const int64_t m_batches_per_epoch;
+			const bool m_shuffle;
+			const uint64_t m_seed;
+
+			std::vector<Slot> m_slots;
+			std::vector<Tensor> m_alternate; // on the graph device, swapped with graph inputs and targets
+			std::map<int64_t, std::vector<size_t>> m_orderings; // for each epoch that is still being loaded
+
+			int64_t m_next_to_fill = 0;
+			int64_t m_next_to_copy = 0;
+			int64_t m_current_batch = -1;
+			bool m_alternate_is_ready = false;
+			int m_alternate_size = 0;
+			std::exception_ptr m_alternate_error;
+			bool m_is_running = true;
+			std::mutex m_mutex;
+			std::condition_variable m_cond;
+
+			std::vector<std::thread> m_workers;
+			std::thread m_copier;
+		public:
+			/*
+			 * Batch size is the batch dimension of graph inputs. The last batch of each epoch may be smaller.
+			 */
+			DataLoader(const Dataset &dataset, Graph &graph, int numberOfWorkers = 1, int prefetchedBatches = 2, bool shuffle = true,
+					uint64_t seed = 0);
+			DataLoader(const DataLoader &other) = delete;
+			DataLoader(DataLoader &&other) = delete;
+			DataLoader& operator=(const DataLoader &other) = delete;
+			DataLoader& operator=(DataLoader &&other) = delete;
+			~DataLoader();
+
+			int batchSize() const noexcept;
+			int numberOfBatches() const noexcept; // per epoch
+			/*
+			 * Epoch and index within the epoch of the batch returned by the last call to next().
+			 */
+			int currentEpoch() const noexcept;
+			int currentBatch() const noexcept;
+			bool isLastBatchOfEpoch() const noexcept;
+
+			/*
+			 * Waits for the previous step of the graph and for the next batch, then swaps it into graph inputs and targets.
+			 * Returns the number of samples in the batch.
+			 * Exceptions thrown by the dataset are rethrown here.
+			 */
+			int next();
+		private:
+			void worker_loop();
+			void copier_loop();
+			const std::vector<size_t>& get_ordering(int64_t epoch);
+			void fill_slot(Slot &slot, int64_t batch, const std::vector<size_t> &ordering) const;
+	};
+
+} /* namespace avocado */
+
+#endif /* AVOCADO_DATA_DATALOADER_HPP_ */
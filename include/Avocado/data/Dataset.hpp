@@ -0,0 +1,56 @@
+/*
+ * Dataset.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#ifndef AVOCADO_DATA_DATASET_HPP_
+#define AVOCADO_DATA_DATASET_HPP_
+
+#include <Avocado/core/Tensor.hpp>
+
+#include <vector>
+
+namespace avocado
+{
+
+	/*
+	 * Source of training samples read by DataLoader.
+	 * Each sample consists of one tensor per graph input followed by one tensor per graph target.
+	 */
+	class Dataset
+	{
+		public:
+			Dataset() = default;
+			Dataset(const Dataset &other) = delete;
+			Dataset(Dataset &&other) = delete;
+			Dataset& operator=(const Dataset &other) = delete;
+			Dataset& operator=(Dataset &&other) = delete;
+			virtual ~Dataset() = default;
+
+			virtual size_t size() const = 0;
+			/*
+			 * Reads (and decodes) sample with given index into rows of host tensors with batch dimension equal to 1.
+			 * It is called concurrently from many worker threads so it must not modify the dataset.
+			 */
+			virtual void load(size_t index, std::vector<Tensor> &rows) const = 0;
+	};
+
+	/*
+	 * Dataset stored in host memory, the first dimension of each tensor indexes the samples.
+	 */
+	class TensorDataset: public Dataset
+	{
+		private:
+			std::vector<Tensor> m_tensors;
+		public:
+			TensorDataset(const std::vector<Tensor> &tensors);
+
+			size_t size() const;
+			void load(size_t index, std::vector<Tensor> &rows) const;
+	};
+
+} /* namespace avocado */
+
+#endif /* AVOCADO_DATA_DATASET_HPP_ */
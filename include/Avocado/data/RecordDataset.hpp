@@ -0,0 +1,97 @@
+/*
+ * RecordDataset.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#ifndef AVOCADO_DATA_RECORDDATASET_HPP_
+#define AVOCADO_DATA_RECORDDATASET_HPP_
+
+#include <Avocado/data/Dataset.hpp>
+#include <Avocado/core/Shape.hpp>
+#include <Avocado/core/DataType.hpp>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace avocado
+{
+	/*
+	 * Layout of a record file:
+	 *  - 32 byte header with magic "AVRECORD", version, number of records and length of the json description,
+	 *  - json description of the fields (data type and shape of each tensor of a sample),
+	 *  - padding up to the first page boundary,
+	 *  - records of equal size, each field of a record starts at an offset that is a multiple of 64 bytes.
+	 * Fixed record size allows reading any record in O(1) without an index.
+	 */
+	struct RecordField
+	{
+			Shape shape;
+			DataType dtype = DataType::UNKNOWN;
+			size_t offset = 0; // in bytes, from the start of the record
+			size_t sizeInBytes = 0;
+
+			RecordField() = default;
+			RecordField(const Shape &shape, DataType dtype);
+	};
+
+	class RecordWriter
+	{
+		private:
+			std::ofstream m_stream;
+			std::vector<RecordField> m_fields;
+			size_t m_record_size = 0;
+			uint64_t m_number_of_records = 0;
+			std::vector<char> m_buffer;
+		public:
+			RecordWriter(const std::string &path, const std::vector<RecordField> &fields);
+			RecordWriter(const RecordWriter &other) = delete;
+			RecordWriter& operator=(const RecordWriter &other) = delete;
+			~RecordWriter();
+
+			/*
+			 * Appends single sample, one tensor per field (on any device, batch dimension equal to 1 or without it).
+			 */
+			void write(const std::vector<Tensor> &sample);
+			uint64_t numberOfRecords() const noexcept;
+			/*
+			 * Stores the number of records in the header. Called by the destructor if the writer was not closed before.
+			 */
+			void close();
+	};
+
+	/*
+	 * Read-only dataset that maps a record file into memory. Pages are loaded by the system on first access so opening
+	 * a file is instant regardless of its size.
+	 * Each data-parallel worker can open its own shard, which is a contiguous range of records.
+	 */
+	class RecordDataset: public Dataset
+	{
+		private:
+			const char *m_data = nullptr; // the whole mapped file
+			size_t m_file_size = 0;
+			size_t m_data_offset = 0;
+			size_t m_record_size = 0;
+			uint64_t m_number_of_records = 0;
+			uint64_t m_first_record = 0; // of this shard
+			uint64_t m_shard_size = 0;
+			std::vector<RecordField> m_fields;
+		public:
+			RecordDataset(const std::string &path, int shardIndex = 0, int numberOfShards = 1);
+			~RecordDataset();
+
+			size_t size() const; // number of records in this shard
+			uint64_t numberOfRecords() const noexcept; // in the whole file
+			const std::vector<RecordField>& fields() const noexcept;
+			/*
+			 * Pointer to given field of given record (indexed within the shard) inside the mapped file.
+			 */
+			const void* data(size_t index, int field) const;
+			void load(size_t index, std::vector<Tensor> &rows) const;
+	};
+
+} /* namespace avocado */
+
+#endif /* AVOCADO_DATA_RECORDDATASET_HPP_ */
@@ -11,10 +11,14 @@
 #include <Avocado/layers/Layer.hpp>
 #include <Avocado/core/DataType.hpp>
 #include <Avocado/core/Context.hpp>
+#include <Avocado/core/MemoryTracker.hpp>
 #include <Avocado/core/Shape.hpp>
 #include <Avocado/graph/GraphNode.hpp>
+#include <Avocado/graph/Profiler.hpp>
 #include <Avocado/losses/LossFunction.hpp>
+#include <Avocado/optimizers/LearningRateSchedule.hpp>
 
+#include <array>
 #include <memory>
 #include <vector>
 
@@ -37,8 +41,14 @@ namespace avocado
 {
 	typedef int GraphNodeID;
 
+	enum class GraphPhase
+	{
+		FORWARD, BACKWARD, LEARN, SAVE
+	};
+
 	class Graph
 	{
+			friend class Pipeline;
 		private:
 			Context m_context;
 
@@ -46,16 +56,22 @@ namespace avocado
 			std::vector<std::unique_ptr<GraphNode>> m_nodes;
 			std::vector<std::unique_ptr<LossFunction>> m_losses;
 			std::vector<std::unique_ptr<Tensor>> m_targets;
+			std::vector<std::unique_ptr<Tensor>> m_loss_accumulators; // single element tensors on the graph device
+			int m_accumulated_steps = 0;
 
 			std::vector<GraphNode*> m_input_nodes; // non-owning
 			std::vector<GraphNode*> m_output_nodes; // non-owning
 
 			std::unique_ptr<Tensor> m_backup_tensor;
+			std::unique_ptr<Profiler> m_profiler; // null unless profiling is enabled
+			std::unique_ptr<LearningRateSchedule> m_learning_rate_schedule; // null means constant learning rate
+			mutable std::array<MemoryUsage, 4> m_peak_memory_usage; // for each GraphPhase
 
 			DataType m_datatype = DataType::FLOAT32;
 
 		public:
 			Graph(Device device = Device::cpu());
+			Graph(Device device, const ThreadGroup &group);
 
 			Graph(const Graph &other) = delete;
 			Graph& operator=(const Graph &other) = delete;
@@ -88,17 +104,84 @@ namespace avocado
 			int numberOfOutputs() const noexcept;
 			int maxBatchSize() const;
 			void moveTo(Device newDevice);
+			/*
+			 * Binds the graph to given set of host cores. Parameters are moved to the NUMA node of the group
+			 * while intermediate tensors are allocated there on the first use.
+			 */
+			void setThreadGroup(const ThreadGroup &group);
+			/*
+			 * Selects accuracy of transcendental functions used by all layers and losses of this graph.
+			 */
+			void setFastMathMode(FastMathMode mode) noexcept;
 			void setInputShape(const Shape &shape);
 			void setInputShape(const std::vector<Shape> &list);
 
+			/*
+			 * Makes this graph use the parameters of other graph with identical architecture without copying them.
+			 * Parameters are copied on write so each graph can still be trained independently.
+			 */
+			void shareWeightsWith(const Graph &other);
 			void setOptimizer(const Optimizer &optimizer);
 			void setRegularizer(const Regularizer &regularizer);
+			/*
+			 * Schedule is evaluated once per learn() and its value multiplies the learning rate of all optimizers.
+			 * It is saved together with the graph, including the current step.
+			 */
+			void setLearningRateSchedule(const LearningRateSchedule &schedule);
+			void removeLearningRateSchedule() noexcept;
+			bool hasLearningRateSchedule() const noexcept;
+			const LearningRateSchedule& getLearningRateSchedule() const;
+			LearningRateSchedule& getLearningRateSchedule();
+			/*
+			 * Learning rate that will be used by the next learn(), taken from the optimizer of the first trainable layer.
+			 */
+			double getLearningRate() const;
+			/*
+			 * Maintains exponential moving average of all trainable parameters, updated by every learn(). Zero decay disables it.
+			 */
+			void setWeightAveraging(double decay);
+			/*
+			 * Exchanges the parameters with their averages without copying, for evaluation or export. Calling it again restores
+			 * the trained parameters. learn() is not allowed while the averages are in use.
+			 */
+			void swapAveragedWeights();
+			bool usesAveragedWeights() const noexcept;
 			void init();
 			void forward(int batchSize);
 			void backward(int batchSize);
 			std::vector<Scalar> getLoss(int batchSize);
+			/*
+			 * Must be called after backward(). Computes the norm of the updates of all trainable parameters and, if it exceeds 'maxNorm',
+			 * makes the next learn() scale them by maxNorm / norm. Scaling is done within the optimizer step when the optimizer allows it.
+			 * Returns the norm before clipping.
+			 */
+			double clipGradients(double maxNorm);
 			void learn();
 
+			/*
+			 * Loss of every output is accumulated on the device during backward() without synchronizing with the host.
+			 * Returns mean loss per step since the last reset. Reading it synchronizes the context so it should be done only every few steps.
+			 */
+			std::vector<Scalar> getAccumulatedLoss() const;
+			int numberOfAccumulatedSteps() const noexcept;
+			void resetAccumulatedLoss();
+
+			/*
+			 * Enables collection of per-node timings in forward, backward and learn.
+			 * Context is synchronized after every node so profiling should be disabled during normal runs.
+			 */
+			void setProfiling(bool enabled);
+			bool isProfiling() const noexcept;
+			const Profiler& getProfiler() const;
+			Profiler& getProfiler();
+
+			/*
+			 * Returns the highest memory usage of the graph device observed during given phase since the last reset.
+			 * Usage is measured for the whole device so it includes memory used by other graphs at the same time.
+			 */
+			MemoryUsage getPeakMemoryUsage(GraphPhase phase) const;
+			void resetPeakMemoryUsage();
+
 			void print() const;
 			void makeNonTrainable();
 			bool isTrainable() const noexcept;
@@ -111,6 +194,8 @@ namespace avocado
 			const GraphNode& getNode(int index) const;
 			GraphNode& getNode(int index);
 			GraphNodeID getNodeID(const GraphNode *node) const noexcept;
+			GraphNodeID getInputNodeID(int index = 0) const;
+			GraphNodeID getOutputNodeID(int index = 0) const;
 
 			void clear();
 			Json save(SerializedObject &binary_data) const;
@@ -124,6 +209,9 @@ namespace avocado
 			GraphNodeID add_node(const Layer &layer, const std::vector<GraphNodeID> &inputs);
 
 			void create_backup_tensor();
+			Tensor& get_loss_accumulator(int index);
+			void record_peak_memory_usage(GraphPhase phase, const MemoryTracker::PeakWatcher &watcher) const;
+			void bind_parameters_to_local_node();
 
 			Json save_node(const GraphNode *node) const;
 			void load_node(const Json &json);
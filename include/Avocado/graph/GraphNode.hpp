@@ -61,6 +61,12 @@ namespace avocado
 
 			void forward(int batch_size);
 			void backward(int batch_size, Tensor &backup_tensor);
+			/*
+			 * Variants working on rows [firstSample, firstSample + batchSize) of the node tensors.
+			 * In backward, gradient for input 'i' is added to the existing one if accumulate[i] is true, or overwritten otherwise.
+			 */
+			void forward(int batchSize, int firstSample);
+			void backward(int batchSize, int firstSample, Tensor &backup_tensor, const std::vector<bool> &accumulate);
 			void prepareForBackward();
 
 			const Layer& getLayer() const;
@@ -0,0 +1,140 @@
+/*
+ * Pipeline.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#ifndef AVOCADO_GRAPH_PIPELINE_HPP_
+#define AVOCADO_GRAPH_PIPELINE_HPP_
+
+#include <Avocado/core/Context.hpp>
+
+#include <cinttypes>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace avocado /* forward declarations */
+{
+	class Graph;
+	class Tensor;
+}
+
+namespace avocado
+{
+	enum class PipelineSchedule
+	{
+		GPIPE, /* forward of all micro-batches, then backward of all of them */
+		ONE_F_ONE_B /* after a short warmup forward and backward passes alternate, which bounds the number of micro-batches in flight */
+	};
+
+	/*
+	 * Splits a Graph into stages made of contiguous ranges of nodes, each one executed by its own thread (pinned to its own ThreadGroup)
+	 * with its own Context. A batch is divided into micro-batches that flow through the stages so that all of them work concurrently.
+	 * Micro-batches are row slices of the graph tensors, so results end up in the same place as after Graph::forward() and Graph::backward().
+	 * Weight updates of all micro-batches are accumulated, Graph::learn() must be called afterwards as usual.
+	 *
+	 * Note: layers that keep per-batch state between forward and backward (like BatchNormalization) see every micro-batch as a separate batch.
+	 * The graph must not be modified while the pipeline exists.
+	 */
+	class Pipeline
+	{
+		private:
+			class TokenQueue
+			{
+				private:
+					std::mutex m_mutex;
+					std::condition_variable m_cond;
+					std::deque<int> m_tokens;
+					size_t m_capacity;
+					bool m_is_closed = false;
+				public:
+					TokenQueue(size_t capacity);
+					bool push(int token);
+					bool pop(int &token);
+					void close();
+					void reset();
+			};
+			struct Stage
+			{
+					int firstNode = 0;
+					int lastNode = 0; // one past the last node of the stage
+					std::unique_ptr<Context> context;
+					std::unique_ptr<Tensor> backupTensor;
+					std::vector<std::vector<bool>> accumulate; // for each node in the stage, for each of its inputs
+					std::thread worker;
+					std::exception_ptr error;
+			};
+			enum class Task
+			{
+				NONE, FORWARD, TRAIN, EXIT
+			};
+
+			Graph &m_graph;
+			std::vector<std::unique_ptr<Stage>> m_stages;
+			std::vector<std::unique_ptr<TokenQueue>> m_forward_queues; // from stage i to stage i + 1
+			std::vector<std::unique_ptr<TokenQueue>> m_backward_queues; // from stage i + 1 to stage i
+			int m_micro_batches;
+			PipelineSchedule m_schedule;
+
+			std::mutex m_task_mutex;
+			std::condition_variable m_task_cond;
+			std::condition_variable m_finished_cond;
+			Task m_task = Task::NONE;
+			int m_batch_size = 0;
+			std::vector<std::pair<int, int>> m_ranges; // first sample and size of each micro-batch
+			std::unique_ptr<Tensor> m_micro_batch_loss; // single element, added to the loss accumulator of the graph with the weight of the micro-batch
+			uint64_t m_generation = 0;
+			int m_finished_stages = 0;
+		public:
+			/*
+			 * Creates pipeline with stages starting at given node indices (the first one must be 0).
+			 * If no thread groups are given, available cores are partitioned between the stages.
+			 */
+			Pipeline(Graph &graph, const std::vector<int> &firstNodeOfStage, int numberOfMicroBatches, PipelineSchedule schedule =
+					PipelineSchedule::ONE_F_ONE_B, const std::vector<ThreadGroup> &groups = { });
+			/*
+			 * Creates pipeline with given number of stages of roughly equal cost.
+			 */
+			Pipeline(Graph &graph, int numberOfStages, int numberOfMicroBatches, PipelineSchedule schedule = PipelineSchedule::ONE_F_ONE_B);
+			~Pipeline();
+
+			Pipeline(const Pipeline &other) = delete;
+			Pipeline& operator=(const Pipeline &other) = delete;
+			Pipeline(Pipeline &&other) = delete;
+			Pipeline& operator=(Pipeline &&other) = delete;
+
+			int numberOfStages() const noexcept;
+			int numberOfMicroBatches() const noexcept;
+			PipelineSchedule schedule() const noexcept;
+			int firstNodeOfStage(int stage) const;
+			const Context& getContext(int stage) const;
+
+			void forward(int batchSize);
+			/*
+			 * Runs forward pass, loss gradient and backward pass. Equivalent to Graph::forward() followed by Graph::backward().
+			 */
+			void train(int batchSize);
+
+			/*
+			 * Returns indices of first node of each stage so that the stages have similar number of parameters and activations.
+			 */
+			static std::vector<int> balance(const Graph &graph, int numberOfStages);
+		private:
+			void launch(Task task, int batchSize);
+			void worker_loop(int stage);
+			void run_forward(int stage, int microBatch);
+			void run_backward(int stage, int microBatch);
+			void calculate_loss_gradient(int stage, int microBatch);
+			void receive(TokenQueue &queue, int microBatch);
+			void close_queues();
+	};
+
+} /* namespace avocado */
+
+#endif /* AVOCADO_GRAPH_PIPELINE_HPP_ */
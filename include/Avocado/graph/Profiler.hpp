@@ -0,0 +1,93 @@
+/*
+ * Profiler.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#ifndef AVOCADO_GRAPH_PROFILER_HPP_
+#define AVOCADO_GRAPH_PROFILER_HPP_
+
+#include <Avocado/math/descriptor_wrappers.hpp>
+
+#include <chrono>
+#include <cinttypes>
+#include <string>
+#include <vector>
+
+namespace avocado /* forward declarations */
+{
+	class Json;
+	class Context;
+	class GraphNode;
+	class Layer;
+}
+
+namespace avocado
+{
+	enum class ProfilerPhase
+	{
+		FORWARD, BACKWARD, LEARN
+	};
+	std::string toString(ProfilerPhase phase);
+
+	struct ProfilerEvent
+	{
+			std::string name; // name of the layer
+			ProfilerPhase phase = ProfilerPhase::FORWARD;
+			int index = -1; // index of node (forward, backward) or layer (learn)
+			int thread = 0;
+			double start = 0.0; // in microseconds since the profiler was created or cleared
+			double duration = 0.0; // in microseconds
+			double flops = 0.0; // estimated
+			double bytes = 0.0; // estimated number of bytes read and written
+			uint64_t allocations = 0;
+			uint64_t allocatedBytes = 0;
+	};
+
+	/*
+	 * Collects timings of graph nodes. Each measured operation is followed by synchronization of the context so the times are exact,
+	 * but execution is slower than without profiling. Graph does not create profiler unless profiling is enabled.
+	 */
+	class Profiler
+	{
+		public:
+			class Measurement
+			{
+					friend class Profiler;
+					std::chrono::steady_clock::time_point m_start;
+					internal::AllocationStats m_allocations;
+			};
+		private:
+			std::chrono::steady_clock::time_point m_origin;
+			std::vector<ProfilerEvent> m_events;
+			int m_steps = 0;
+		public:
+			Profiler();
+
+			Measurement start() const;
+			void recordNode(const Measurement &measurement, const Context &context, const GraphNode &node, int index, ProfilerPhase phase,
+					int batchSize);
+			void recordLearn(const Measurement &measurement, const Context &context, const Layer &layer, int index);
+			void nextStep() noexcept;
+
+			void clear();
+			int numberOfSteps() const noexcept;
+			const std::vector<ProfilerEvent>& getEvents() const noexcept;
+
+			/*
+			 * Returns trace in the Chrome trace event format that can be opened in chrome://tracing or Perfetto.
+			 */
+			Json getChromeTrace() const;
+			void saveChromeTrace(const std::string &path) const;
+			/*
+			 * Returns table with time, GFLOP/s, GB/s and share of total time for each layer and phase.
+			 */
+			std::string summary() const;
+		private:
+			void record(const Measurement &measurement, const Context &context, ProfilerEvent &&event);
+	};
+
+} /* namespace avocado */
+
+#endif /* AVOCADO_GRAPH_PROFILER_HPP_ */
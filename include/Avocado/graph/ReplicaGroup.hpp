@@ -0,0 +1,97 @@
+/*
+ * ReplicaGroup.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#ifndef AVOCADO_GRAPH_REPLICAGROUP_HPP_
+#define AVOCADO_GRAPH_REPLICAGROUP_HPP_
+
+#include <cinttypes>
+#include <memory>
+#include <vector>
+
+namespace avocado /* forward declarations */
+{
+	class Graph;
+	class Tensor;
+	class Parameter;
+}
+
+namespace avocado
+{
+	/*
+	 * Data-parallel training of local replicas of the same graph with the optimizer state partitioned between them.
+	 * Trainable parameters of a replica are seen as one flattened space divided into equal contiguous slices, one per replica.
+	 * Each replica keeps the optimizer state (e.g. moments of ADAM) only for its own slice, so optimizer memory is reduced by
+	 * the number of replicas. A step averages the updates of all replicas in place into the update of the owner, updates the weights
+	 * of the owner in place on its context and then gathers the updated slice into all other replicas.
+	 * No copies of the weights or updates are made, except staging buffers for replicas on other devices than the owner.
+	 *
+	 * Note: optimizers that need whole parameters (LARS, LAMB) and weight averaging are not supported.
+	 * learn() and clipGradients() of the replicas must not be called, neither must their architecture be changed while the group exists.
+	 */
+	class ReplicaGroup
+	{
+		private:
+			struct Shard
+			{
+					int replica = 0; // owner
+					int parameter = 0; // index in the list of trainable parameters of a replica
+					int64_t offset = 0; // in elements, within the parameter
+					int length = 0;
+					std::unique_ptr<Parameter> master; // views of the owned slice of the weights and update of the owner, together with the optimizer state
+					std::unique_ptr<Tensor> staging; // for updates of replicas on other devices than the owner
+			};
+			std::vector<Graph*> m_replicas; // non-owning
+			std::vector<Shard> m_shards;
+			double m_max_gradient_norm = 0.0; // zero disables clipping
+			double m_last_gradient_norm = 0.0;
+		public:
+			/*
+			 * All replicas must have identical architecture and optimizers. Weights of the first replica are copied to all others.
+			 */
+			ReplicaGroup(const std::vector<Graph*> &replicas);
+			ReplicaGroup(const ReplicaGroup &other) = delete;
+			ReplicaGroup& operator=(const ReplicaGroup &other) = delete;
+			~ReplicaGroup();
+
+			int numberOfReplicas() const noexcept;
+			Graph& getReplica(int index);
+			/*
+			 * Number of elements of the optimized parameters owned by given replica.
+			 */
+			int64_t shardSize(int replica) const;
+			/*
+			 * Clips global norm of the averaged gradients in every learn(), the same scale is applied to all shards.
+			 * Zero disables clipping.
+			 */
+			ReplicaGroup& setGradientClipping(double maxNorm);
+			/*
+			 * Global norm of the averaged gradients of the last learn(), computed only if clipping is enabled.
+			 */
+			double getLastGradientNorm() const noexcept;
+			/*
+			 * Replaces Graph::learn() of all replicas, must be called after backward() of each of them.
+			 * Layer::beforeLearn() and Layer::afterLearn() of all replicas are called around the update.
+			 */
+			void learn();
+		private:
+			/*
+			 * Averages updates of all replicas into the owned slice of the update of the owner.
+			 */
+			void reduce(Shard &shard, const std::vector<std::vector<Parameter*>> &params);
+			/*
+			 * Computes global norm of the averaged updates of all shards.
+			 */
+			double global_norm();
+			/*
+			 * Copies the owned slice of the weights into all other replicas.
+			 */
+			void gather(Shard &shard, const std::vector<std::vector<Parameter*>> &params);
+	};
+
+} /* namespace avocado */
+
+#endif /* AVOCADO_GRAPH_REPLICAGROUP_HPP_ */
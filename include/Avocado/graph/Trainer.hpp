@@ -0,0 +1,144 @@
+/*
+ * Trainer.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#ifndef AVOCADO_GRAPH_TRAINER_HPP_
+#define AVOCADO_GRAPH_TRAINER_HPP_
+
+#include <Avocado/metrics/Metric.hpp>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace avocado /* forward declarations */
+{
+	class Graph;
+	class DataLoader;
+	class LearningRateSchedule;
+	class Trainer;
+}
+
+namespace avocado
+{
+	/*
+	 * Values read from the device at the end of a logging interval or an evaluation.
+	 */
+	struct TrainingLog
+	{
+			int epoch = 0;
+			int64_t step = 0;
+			int steps = 0; // number of steps the values were averaged over
+			double learningRate = 0.0;
+			double samplesPerSecond = 0.0;
+			std::vector<double> loss; // mean per step, for each graph output
+			std::vector<std::pair<std::string, double>> metrics;
+
+			std::string toString() const;
+	};
+
+	/*
+	 * Hooks called by Trainer. Only onLog() and onEvaluation() receive values read from the device,
+	 * other hooks are called without synchronizing the graph context.
+	 */
+	class TrainerCallback
+	{
+		public:
+			virtual ~TrainerCallback() = default;
+			virtual void onTrainingBegin(Trainer &trainer);
+			virtual void onEpochBegin(Trainer &trainer, int epoch);
+			virtual void onStepEnd(Trainer &trainer, int64_t step);
+			virtual void onLog(Trainer &trainer, const TrainingLog &log);
+			virtual void onEvaluation(Trainer &trainer, const TrainingLog &log);
+			virtual void onEpochEnd(Trainer &trainer, int epoch);
+			virtual void onTrainingEnd(Trainer &trainer);
+	};
+
+	/*
+	 * Runs training epochs of a graph fed by a DataLoader.
+	 * Loss and metrics are accumulated on the device and read only every 'log interval' steps (and at the end of each epoch),
+	 * so the time of a step is not affected by logging.
+	 */
+	class Trainer
+	{
+		private:
+			Graph &m_graph;
+			DataLoader &m_train_data;
+			DataLoader *m_validation_data = nullptr; // non-owning
+			std::vector<std::unique_ptr<Metric>> m_metrics;
+			std::vector<std::unique_ptr<Metric>> m_validation_metrics;
+			std::vector<TrainerCallback*> m_callbacks; // non-owning
+
+			double m_max_gradient_norm = 0.0; // zero disables clipping
+			int m_log_interval = 100;
+			int m_evaluation_interval = 1;
+			std::string m_checkpoint_path;
+			int m_checkpoint_interval = 0;
+
+			int m_epoch = 0;
+			int64_t m_step = 0;
+			bool m_stop_requested = false;
+
+			int m_steps_since_log = 0;
+			int64_t m_samples_since_log = 0;
+			std::chrono::steady_clock::time_point m_last_log;
+		public:
+			Trainer(Graph &graph, DataLoader &trainData);
+			Trainer(const Trainer &other) = delete;
+			Trainer& operator=(const Trainer &other) = delete;
+
+			/*
+			 * Validation loader must feed the same graph as the training one.
+			 */
+			Trainer& setValidationData(DataLoader &data);
+			Trainer& addMetric(const Metric &metric);
+			Trainer& addCallback(TrainerCallback &callback);
+			/*
+			 * Sets the schedule in the graph, so it is saved in checkpoints.
+			 */
+			Trainer& setLearningRateSchedule(const LearningRateSchedule &schedule);
+			/*
+			 * Clips global norm of the gradients before every learn(), see Graph::clipGradients(). Zero disables clipping.
+			 */
+			Trainer& setGradientClipping(double maxNorm);
+			Trainer& setLogInterval(int steps);
+			Trainer& setEvaluationInterval(int epochs);
+			/*
+			 * Saves the graph together with the current epoch and step every given number of epochs.
+			 */
+			Trainer& setCheckpoint(const std::string &path, int epochs = 1);
+
+			void fit(int epochs);
+			/*
+			 * Runs a full epoch of validation data without training.
+			 */
+			TrainingLog evaluate();
+			void saveCheckpoint(const std::string &path) const;
+			/*
+			 * Restores the graph (with optimizer states and learning rate schedule), epoch and step saved by saveCheckpoint(),
+			 * so that the next call to fit() resumes the training. The graph keeps its current device, thread group and fast math mode.
+			 */
+			void loadCheckpoint(const std::string &path);
+			/*
+			 * Can be called from callbacks. Training stops after the current step.
+			 * An epoch interrupted this way is not evaluated, checkpointed nor reported by onEpochEnd(), only the steps since the last log are.
+			 */
+			void stop() noexcept;
+
+			int currentEpoch() const noexcept;
+			int64_t currentStep() const noexcept;
+			const Graph& graph() const noexcept;
+			Graph& graph() noexcept;
+		private:
+			void train_step();
+			TrainingLog collect_log();
+	};
+
+} /* namespace avocado */
+
+#endif /* AVOCADO_GRAPH_TRAINER_HPP_ */
@@ -0,0 +1,107 @@
+/*
+ * BatchingServer.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#ifndef AVOCADO_INFERENCE_BATCHINGSERVER_HPP_
+#define AVOCADO_INFERENCE_BATCHINGSERVER_HPP_
+
+#include <Avocado/inference/InferenceSession.hpp>
+#include <Avocado/core/Tensor.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace avocado /* forward declarations */
+{
+	class Graph;
+}
+
+namespace avocado
+{
+	namespace inference
+	{
+		struct ServingStatistics
+		{
+				size_t processedRequests = 0;
+				size_t processedBatches = 0;
+				double totalQueueingDelay = 0.0; // in seconds
+				double maxQueueingDelay = 0.0; // in seconds
+				double totalBatchFill = 0.0; // sum of (batch size / max batch size) over all batches
+				double elapsedTime = 0.0; // in seconds, from the first request to the last completed batch
+
+				double averageQueueingDelay() const noexcept;
+				double averageBatchFill() const noexcept;
+				double throughput() const noexcept; // in requests per second
+				std::string toString() const;
+		};
+
+		/*
+		 * In-process server that groups individual requests into batches.
+		 * Requests are queued and packed into the input tensor until either the maximum batch size is reached or the oldest request
+		 * waited longer than the allowed delay. Then a single forward pass is run and output rows are returned through futures.
+		 */
+		class BatchingServer
+		{
+			private:
+				struct Request
+				{
+						std::vector<Tensor> inputs;
+						std::promise<std::vector<Tensor>> result;
+						std::chrono::steady_clock::time_point arrival;
+				};
+
+				InferenceSession m_session;
+				const int m_max_batch_size;
+				const std::chrono::microseconds m_max_delay;
+
+				std::deque<Request> m_queue;
+				mutable std::mutex m_queue_mutex;
+				std::condition_variable m_queue_cond;
+				bool m_is_running = true;
+
+				ServingStatistics m_statistics;
+				std::chrono::steady_clock::time_point m_first_request = std::chrono::steady_clock::time_point::max();
+				mutable std::mutex m_statistics_mutex;
+
+				std::thread m_worker;
+			public:
+				/*
+				 * Max batch size equal to 0 means that the whole capacity of the model is used.
+				 */
+				BatchingServer(const Graph &model, std::chrono::microseconds maxDelay, int maxBatchSize = 0, const ThreadGroup &group =
+						ThreadGroup());
+				BatchingServer(const BatchingServer &other) = delete;
+				BatchingServer(BatchingServer &&other) = delete;
+				BatchingServer& operator=(const BatchingServer &other) = delete;
+				BatchingServer& operator=(BatchingServer &&other) = delete;
+				~BatchingServer();
+
+				int maxBatchSize() const noexcept;
+				std::chrono::microseconds maxDelay() const noexcept;
+
+				/*
+				 * Submits single sample (one tensor per graph input, without batch dimension or with batch dimension equal to 1).
+				 * The returned future holds one tensor per graph output, allocated on CPU.
+				 */
+				std::future<std::vector<Tensor>> submit(const std::vector<Tensor> &inputs);
+				std::future<std::vector<Tensor>> submit(const Tensor &input);
+
+				ServingStatistics getStatistics() const;
+				void resetStatistics();
+			private:
+				void worker_loop();
+				void process_batch(std::vector<Request> &batch);
+		};
+
+	} /* namespace inference */
+} /* namespace avocado */
+
+#endif /* AVOCADO_INFERENCE_BATCHINGSERVER_HPP_ */
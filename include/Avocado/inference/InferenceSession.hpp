@@ -0,0 +1,86 @@
+/*
+ * InferenceSession.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#ifndef AVOCADO_INFERENCE_INFERENCESESSION_HPP_
+#define AVOCADO_INFERENCE_INFERENCESESSION_HPP_
+
+#include <Avocado/core/Context.hpp>
+#include <Avocado/core/Tensor.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace avocado /* forward declarations */
+{
+	class Graph;
+	class Layer;
+}
+
+namespace avocado
+{
+	namespace inference
+	{
+		/*
+		 * Lightweight executor of a loaded Graph that is used as a read-only compiled model.
+		 * Each session has its own Context and activation arena while the weights are shared with the model,
+		 * so many sessions can run concurrently (one per thread) on a single copy of the parameters.
+		 * The model must not be modified nor destroyed while sessions created from it exist.
+		 */
+		class InferenceSession
+		{
+			private:
+				const Graph &m_model;
+				Context m_context;
+
+				std::vector<std::unique_ptr<Layer>> m_layers; // copies of model layers that refer to the model parameters
+				std::vector<int> m_layer_of_node;
+				std::vector<std::vector<int>> m_inputs_of_node;
+				std::vector<int> m_input_nodes;
+				std::vector<int> m_output_nodes;
+
+				Tensor m_arena; // single allocation for all activations
+				std::vector<Tensor> m_activations; // views into arena, one per node
+			public:
+				InferenceSession(const Graph &model, const ThreadGroup &group = ThreadGroup());
+
+				InferenceSession(const InferenceSession &other) = delete;
+				InferenceSession(InferenceSession &&other) = delete;
+				InferenceSession& operator=(const InferenceSession &other) = delete;
+				InferenceSession& operator=(InferenceSession &&other) = delete;
+
+				const Graph& model() const noexcept;
+				const Context& context() const noexcept;
+				Device device() const noexcept;
+				DataType dtype() const noexcept;
+
+				int numberOfInputs() const noexcept;
+				int numberOfOutputs() const noexcept;
+				int maxBatchSize() const;
+				/*
+				 * Size of memory used by activations of this session.
+				 */
+				size_t sizeInBytes() const noexcept;
+
+				const Tensor& getInput(int index = 0) const;
+				const Tensor& getOutput(int index = 0) const;
+				Tensor& getInput(int index = 0);
+				Tensor& getOutput(int index = 0);
+				/*
+				 * Output of given node of the model, valid until the next forward(). Nodes whose outputs are never needed at the same time
+				 * may share memory.
+				 */
+				const Tensor& getActivation(int node) const;
+
+				void forward(int batchSize);
+			private:
+				void plan_activations();
+		};
+
+	} /* namespace inference */
+} /* namespace avocado */
+
+#endif /* AVOCADO_INFERENCE_INFERENCESESSION_HPP_ */
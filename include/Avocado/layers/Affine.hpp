@@ -38,7 +38,7 @@ namespace avocado
 			void forward(const std::vector<Tensor> &input, Tensor &output, Scalar alpha, Scalar beta);
 			void backward(const std::vector<Tensor> &input, const Tensor &output, std::vector<Tensor> &gradientIn, Tensor &gradientOut, Scalar alpha, Scalar beta);
 
-			void learn();
+			void afterLearn();
 	};
 
 } /* namespace avocado */
@@ -49,7 +49,8 @@ namespace avocado
 			void init();
 			void forward(const std::vector<Tensor> &input, Tensor &output, Scalar alpha, Scalar beta);
 			void backward(const std::vector<Tensor> &input, const Tensor &output, std::vector<Tensor> &gradientIn, Tensor &gradientOut, Scalar alpha, Scalar beta);
-			void learn();
+			void beforeLearn();
+			void afterLearn();
 	};
 
 } /* namespace avocado */
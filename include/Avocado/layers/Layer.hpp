@@ -67,6 +67,10 @@ namespace avocado
 			virtual Shape getOutputShape() const = 0;
 			virtual Shape getWeightShape() const;
 			virtual Shape getBiasShape() const;
+			/*
+			 * Rough estimate of the number of floating point operations done by the forward pass for given batch size.
+			 */
+			virtual double estimateFlops(int batchSize) const;
 
 			Device device() const;
 			DataType dtype() const noexcept;
@@ -78,6 +82,11 @@ namespace avocado
 			const Parameter& getBias() const;
 
 			virtual void changeContext(Context &context);
+			/*
+			 * Makes this layer use the parameters of other layer without copying them.
+			 * Optimizer and regularizer of this layer are kept. Parameters are copied on write, for example once this layer starts training.
+			 */
+			virtual void shareParametersWith(const Layer &other);
 
 			virtual void init();
 			virtual Layer& setInitializer(const Initializer &initializer);
@@ -88,7 +97,13 @@ namespace avocado
 			virtual void backward(const std::vector<Tensor> &input, const Tensor &output, std::vector<Tensor> &gradientIn, Tensor &gradientOut,
 					Scalar alpha, Scalar beta) = 0;
 
-			virtual void learn();
+			virtual void learn(double learningRateMultiplier);
+			/*
+			 * Called by learn() before and after the update of weights and bias.
+			 * Code that updates the parameters by itself (for example ReplicaGroup) must call them around the update.
+			 */
+			virtual void beforeLearn();
+			virtual void afterLearn();
 
 			friend bool sameId(const Layer &lhs, const Layer &rhs) noexcept;
 	};
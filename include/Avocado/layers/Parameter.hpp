@@ -30,12 +30,16 @@ namespace avocado
 	class Parameter
 	{
 		private:
-			Tensor m_param;
+			std::shared_ptr<Tensor> m_param; // may be shared with other parameters, copied on first write
 			std::unique_ptr<Tensor> m_update;
 			std::unique_ptr<Optimizer> m_optimizer;
 			std::unique_ptr<Regularizer> m_regularizer;
 			std::unique_ptr<Initializer> m_initializer;
+			std::shared_ptr<Tensor> m_average; // exponential moving average of the parameter, null if disabled
+			double m_average_decay = 0.0;
+			bool m_is_average_swapped = false;
 			int m_accumulated_updates = 0;
+			double m_gradient_scale = 1.0; // applied to the update in the next learn()
 			bool m_is_trainable = true;
 
 		public:
@@ -47,6 +51,18 @@ namespace avocado
 			Parameter(const Json &json, const SerializedObject &binary_data);
 			Parameter(const Shape &shape, DataType dtype, Device device, bool trainable = true);
 
+			/*
+			 * Makes this parameter refer to the same tensor as the other one, without copying it.
+			 * The tensor is copied when either of the parameters is written to (learn, init, conversion, mutableParam()).
+			 */
+			void shareStorageWith(const Parameter &other);
+			bool isShared() const noexcept;
+			/*
+			 * Makes this parameter operate in place on elements [offset, offset + length) of the flattened tensor and update of the other one.
+			 * No memory is allocated, so the views must be made again if the other parameter reallocates its tensors.
+			 */
+			void viewSliceOf(Parameter &other, int64_t offset, int length);
+
 			void setTrainable(bool t);
 			bool isTrainable() const noexcept;
 
@@ -55,6 +71,30 @@ namespace avocado
 
 			void setRegularizer(const Regularizer &regularizer) noexcept;
 			Regularizer& getRegularizer() const;
+			bool hasRegularizer() const noexcept;
+			/*
+			 * Decoupled weight decay of the regularizer (zero if there is none), applied by the optimizer.
+			 */
+			double getWeightDecay() const noexcept;
+			/*
+			 * Scale of the update used by the next learn() only, set by gradient clipping. It is applied within the optimizer step when possible.
+			 */
+			void setGradientScale(double scale) noexcept;
+			double getGradientScale() const noexcept;
+
+			/*
+			 * Enables exponential moving average of the parameter, average = decay * average + (1 - decay) * param,
+			 * updated by the optimizer after every step. Zero decay disables it.
+			 */
+			void setAveraging(double decay);
+			double getAveragingDecay() const noexcept;
+			bool hasAverage() const noexcept;
+			Tensor& getAverage();
+			/*
+			 * Exchanges the parameter with its average without copying. learn() is not allowed until it is swapped back.
+			 */
+			void swapAverage();
+			bool isAverageSwapped() const noexcept;
 
 			void setInitializer(const Initializer &initializer) noexcept;
 			Initializer& getInitializer() const;
@@ -66,16 +106,22 @@ namespace avocado
 			int getBatch() const noexcept;
 
 			const Tensor& getParam() const;
-			Tensor& getParam();
+			/*
+			 * Access for modifying the tensor directly, makes private copy of it first if it is shared.
+			 */
+			Tensor& mutableParam();
 			Tensor& getUpdate();
 
 			void moveTo(Device newDevice);
 			void convertTo(const Context &context, DataType newType);
 			void init(const Context &context);
-			void learn(const Context &context);
+			void learn(const Context &context, double learningRateMultiplier);
 
 			Json serialize(SerializedObject &binary_data) const;
 			void unserialize(const Json &json, const SerializedObject &binary_data);
+		private:
+			void detach();
+			void load_average(const Json &json, const SerializedObject &binary_data);
 	};
 
 } /* namespace avocado */
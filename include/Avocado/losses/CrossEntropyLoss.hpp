@@ -9,6 +9,7 @@
 #define AVOCADO_LOSSES_CROSSENTROPYLOSS_HPP_
 
 #include <Avocado/losses/LossFunction.hpp>
+#include <Avocado/math/activations.hpp>
 
 namespace avocado
 {
@@ -16,13 +17,22 @@ namespace avocado
 	class CrossEntropyLoss: public LossFunction
 	{
 			bool m_is_combined_with_layer = false;
+			bool m_is_combined_with_softmax = false;
+			SoftmaxMode m_softmax_mode = SoftmaxMode::PER_CHANNEL;
 		public:
-			CrossEntropyLoss() = default;
+			CrossEntropyLoss(TargetFormat targetFormat = TargetFormat::DENSE);
 
 			bool tryCombineWith(const Layer &layer) noexcept;
 
 			Scalar getLoss(const Context &context, const Tensor &output, const Tensor &target) const;
 			void getGradient(const Context &context, Tensor &gradient, const Tensor &output, const Tensor &target) const;
+			void getGradientAndAccumulateLoss(const Context &context, Tensor &gradient, const Tensor &output, const Tensor &target,
+					Tensor &accumulator) const;
+			bool isGradientAveragedOverBatch() const noexcept;
+			bool isFusedWithLayer() const noexcept;
+			Scalar getFusedLossAndGradient(const Context &context, Tensor &gradient, const Tensor &input, Tensor &output, const Tensor &target) const;
+			void getFusedLossAndGradient(const Context &context, Tensor &gradient, const Tensor &input, Tensor &output, const Tensor &target,
+					Tensor &accumulator) const;
 
 			std::string name() const;
 			CrossEntropyLoss* clone() const;
@@ -17,12 +17,14 @@ namespace avocado
 	{
 			bool m_is_combined_with_layer = false;
 		public:
-			KLDivergenceLoss() = default;
+			KLDivergenceLoss(TargetFormat targetFormat = TargetFormat::DENSE);
 
 			bool tryCombineWith(const Layer &layer) noexcept;
 
 			Scalar getLoss(const Context &context, const Tensor &output, const Tensor &target) const;
 			void getGradient(const Context &context, Tensor &gradient, const Tensor &output, const Tensor &target) const;
+			void getGradientAndAccumulateLoss(const Context &context, Tensor &gradient, const Tensor &output, const Tensor &target,
+					Tensor &accumulator) const;
 
 			std::string name() const;
 			KLDivergenceLoss* clone() const;
@@ -8,6 +8,9 @@
 #ifndef AVOCADO_LOSSES_LOSSFUNCTION_HPP_
 #define AVOCADO_LOSSES_LOSSFUNCTION_HPP_
 
+#include <Avocado/core/DataType.hpp>
+#include <Avocado/core/Shape.hpp>
+
 #include <memory>
 #include <string>
 #include <stdexcept>
@@ -24,9 +27,18 @@ namespace avocado /* forward declarations */
 
 namespace avocado
 {
+	enum class TargetFormat
+	{
+		DENSE, /**< Target has the same shape and data type as the output. */
+		CLASS_INDEX /**< Target is INT32 tensor with shape of the output without the last dimension, holding index of the correct class. */
+	};
+	std::string toString(TargetFormat format);
+	TargetFormat targetFormatFromString(const std::string &str);
 
 	class LossFunction
 	{
+		protected:
+			TargetFormat m_target_format = TargetFormat::DENSE;
 		public:
 			LossFunction() = default;
 			LossFunction(const LossFunction &other) = delete;
@@ -37,8 +49,39 @@ namespace avocado
 
 			virtual bool tryCombineWith(const Layer &layer) noexcept;
 
+			TargetFormat targetFormat() const noexcept;
+			Shape getTargetShape(const Shape &outputShape) const;
+			DataType getTargetType(DataType outputType) const noexcept;
+
 			virtual Scalar getLoss(const Context &context, const Tensor &output, const Tensor &target) const = 0;
 			virtual void getGradient(const Context &context, Tensor &gradient, const Tensor &output, const Tensor &target) const = 0;
+			/*
+			 * Computes the gradient as getGradient() and adds the loss value (as returned by getLoss()) to the single element 'accumulator' tensor.
+			 * Built-in losses do it in a single pass over output and target without reading anything back to the host.
+			 * Default implementation calls getGradient() and getLoss().
+			 */
+			virtual void getGradientAndAccumulateLoss(const Context &context, Tensor &gradient, const Tensor &output, const Tensor &target,
+					Tensor &accumulator) const;
+			/*
+			 * Returns true if the gradient is divided by the batch size (so gradients of several sub-batches must be rescaled before summing them).
+			 */
+			virtual bool isGradientAveragedOverBatch() const noexcept;
+			/*
+			 * Returns true if the loss was combined with a layer (see tryCombineWith()) that can be fused into getFusedLossAndGradient().
+			 */
+			virtual bool isFusedWithLayer() const noexcept;
+			/*
+			 * Computes output of the combined layer from its input, gradient of the loss with respect to that input and returns the same value as getLoss(),
+			 * all in a single pass.
+			 */
+			virtual Scalar getFusedLossAndGradient(const Context &context, Tensor &gradient, const Tensor &input, Tensor &output,
+					const Tensor &target) const;
+			/*
+			 * Same as above, but adds the loss value to the single element 'accumulator' tensor instead of returning it,
+			 * so nothing has to be read back to the host. Default implementation calls the above method.
+			 */
+			virtual void getFusedLossAndGradient(const Context &context, Tensor &gradient, const Tensor &input, Tensor &output,
+					const Tensor &target, Tensor &accumulator) const;
 
 			virtual std::string name() const = 0;
 			virtual LossFunction* clone() const = 0;
@@ -20,6 +20,8 @@ namespace avocado
 
 			Scalar getLoss(const Context &context, const Tensor &output, const Tensor &target) const;
 			void getGradient(const Context &context, Tensor &gradient, const Tensor &output, const Tensor &target) const;
+			void getGradientAndAccumulateLoss(const Context &context, Tensor &gradient, const Tensor &output, const Tensor &target,
+					Tensor &accumulator) const;
 
 			std::string name() const;
 			MeanSquareLoss* clone() const;
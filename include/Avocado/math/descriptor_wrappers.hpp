@@ -10,6 +10,7 @@
 
 #include <Avocado/backend_defs.h>
 #include <Avocado/core/Device.hpp>
+#include <Avocado/core/MemoryTracker.hpp>
 #include <cstdint>
 #include <cstddef>
 #include <array>
@@ -27,9 +28,21 @@ namespace avocado
 {
 	namespace internal
 	{
+		struct AllocationStats
+		{
+				uint64_t allocations = 0;
+				uint64_t allocatedBytes = 0;
+		};
+		/*
+		 * Counters of device memory allocations made by the calling thread.
+		 */
+		const AllocationStats& getAllocationStats() noexcept;
+
 		class MemoryDescWrapper
 		{
 				backend::avMemoryDescriptor_t m_descriptor = backend::AVOCADO_NULL_DESCRIPTOR;
+				size_t m_allocated_bytes = 0; // zero for views
+				MemoryCategory m_category = MemoryCategory::OTHER;
 			public:
 				MemoryDescWrapper() = default;
 				MemoryDescWrapper(Device device, size_t sizeInBytes);
@@ -40,6 +53,8 @@ namespace avocado
 				MemoryDescWrapper& operator=(MemoryDescWrapper &&other);
 				~MemoryDescWrapper();
 				Device device() const noexcept;
+				MemoryCategory category() const noexcept;
+				void setCategory(MemoryCategory category) noexcept;
 				operator backend::avMemoryDescriptor_t() const noexcept
 				{
 					return m_descriptor;
@@ -0,0 +1,53 @@
+/*
+ * fast_math.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#ifndef AVOCADO_MATH_FAST_MATH_HPP_
+#define AVOCADO_MATH_FAST_MATH_HPP_
+
+#include <Avocado/core/Context.hpp>
+
+#include <cstddef>
+
+namespace avocado /* forward declarations */
+{
+	class Tensor;
+	class Scalar;
+	enum class NonlinearityType;
+	enum class SoftmaxMode;
+}
+
+namespace avocado
+{
+	namespace math
+	{
+		/*
+		 * Element-wise functions of host arrays (src and dst may point to the same array) with accuracy given by the mode.
+		 * The widest SIMD extension supported by the processor is used (AVX-512, AVX2 or SSE2), EXACT mode uses std:: functions.
+		 * Results that would be denormal are flushed to zero in FAST and FASTEST modes.
+		 */
+		void fastExp(FastMathMode mode, const float *src, float *dst, size_t elements);
+		void fastLog(FastMathMode mode, const float *src, float *dst, size_t elements);
+		void fastTanh(FastMathMode mode, const float *src, float *dst, size_t elements);
+		void fastSigmoid(FastMathMode mode, const float *src, float *dst, size_t elements);
+
+	} /* namespace math */
+
+	namespace internal
+	{
+		/*
+		 * Host implementations used by math:: functions when the context allows approximations.
+		 * They return false (without doing anything) if the arguments are not supported, then the backend must be called.
+		 */
+		bool fast_activation_forward(const Context &context, NonlinearityType activation, const Scalar &alpha, const Tensor &input,
+				const Scalar &beta, Tensor &output);
+		bool fast_softmax_forward(const Context &context, SoftmaxMode mode, const Scalar &alpha, const Tensor &input, const Scalar &beta,
+				Tensor &output);
+		bool fast_cross_entropy_loss(const Context &context, const Tensor &output, const Tensor &target, Scalar &result);
+	} /* namespace internal */
+} /* namespace avocado */
+
+#endif /* AVOCADO_MATH_FAST_MATH_HPP_ */
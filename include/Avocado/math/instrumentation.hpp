@@ -0,0 +1,149 @@
+/*
+ * instrumentation.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#ifndef AVOCADO_MATH_INSTRUMENTATION_HPP_
+#define AVOCADO_MATH_INSTRUMENTATION_HPP_
+
+#include <Avocado/core/Context.hpp>
+#include <Avocado/core/Device.hpp>
+#include <Avocado/core/DataType.hpp>
+#include <Avocado/core/Shape.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace avocado /* forward declarations */
+{
+	class Tensor;
+}
+
+namespace avocado
+{
+	namespace math
+	{
+		struct OperationInfo
+		{
+				const char *name;
+				Device device;
+				std::vector<Shape> shapes; // of all tensor arguments in the order of declaration
+				std::vector<DataType> dtypes;
+
+				OperationInfo(const char *name, Device device);
+				std::string toString() const;
+		};
+
+		/*
+		 * Interface for receiving information about every operation dispatched through math:: functions.
+		 * Hook may be called concurrently from many threads.
+		 */
+		class InstrumentationHook
+		{
+			public:
+				virtual ~InstrumentationHook() = default;
+				/*
+				 * Elapsed time is in seconds, measured after synchronizing the context.
+				 */
+				virtual void onOperation(const OperationInfo &info, double elapsedTime) = 0;
+		};
+
+		/*
+		 * Registers hook that will be called after every operation (the hook is not owned). Passing nullptr disables instrumentation.
+		 * When no hook is registered the only cost is a single check per operation.
+		 */
+		void setInstrumentationHook(InstrumentationHook *hook) noexcept;
+		InstrumentationHook* getInstrumentationHook() noexcept;
+
+		/*
+		 * Collects histogram of latencies (with power-of-two buckets in microseconds) for each operation and shapes of its arguments.
+		 */
+		class LatencyHistogram: public InstrumentationHook
+		{
+			private:
+				struct Entry
+				{
+						size_t count = 0;
+						double totalTime = 0.0;
+						double minTime = 0.0;
+						double maxTime = 0.0;
+						std::vector<size_t> buckets;
+				};
+				mutable std::mutex m_mutex;
+				std::map<std::string, Entry> m_entries;
+			public:
+				void onOperation(const OperationInfo &info, double elapsedTime);
+				void clear();
+				std::string toString() const;
+		};
+
+		/*
+		 * Keeps given number of the slowest calls.
+		 */
+		class SlowestCalls: public InstrumentationHook
+		{
+			private:
+				mutable std::mutex m_mutex;
+				std::vector<std::pair<double, OperationInfo>> m_calls; // min-heap ordered by time
+				size_t m_capacity;
+			public:
+				SlowestCalls(size_t numberOfCalls = 10);
+				void onOperation(const OperationInfo &info, double elapsedTime);
+				void clear();
+				/*
+				 * Returns stored calls sorted from the slowest one.
+				 */
+				std::vector<std::pair<double, OperationInfo>> getCalls() const;
+				std::string toString() const;
+		};
+
+	} /* namespace math */
+
+	namespace internal
+	{
+		extern std::atomic<math::InstrumentationHook*> instrumentation_hook;
+
+		/*
+		 * Placed at the beginning of every math:: function. Does nothing if no hook is registered.
+		 */
+		class OperationScope
+		{
+			private:
+				std::unique_ptr<math::OperationInfo> m_info; // created only when instrumentation is enabled
+				const Context &m_context;
+				std::chrono::steady_clock::time_point m_start;
+			public:
+				template<typename ... Args>
+				OperationScope(const char *name, const Context &context, const Args &... args) :
+						m_context(context)
+				{
+					if (instrumentation_hook.load(std::memory_order_relaxed) != nullptr)
+					{
+						m_info = std::make_unique<math::OperationInfo>(name, context.device());
+						(add_argument(args), ...);
+						m_start = std::chrono::steady_clock::now();
+					}
+				}
+				OperationScope(const OperationScope &other) = delete;
+				OperationScope& operator=(const OperationScope &other) = delete;
+				~OperationScope()
+				{
+					if (m_info != nullptr)
+						finish();
+				}
+			private:
+				void add_argument(const Tensor &tensor);
+				void add_argument(const std::vector<Tensor> &list);
+				void finish() noexcept;
+		};
+	} /* namespace internal */
+} /* namespace avocado */
+
+#endif /* AVOCADO_MATH_INSTRUMENTATION_HPP_ */
@@ -9,6 +9,7 @@
 #define AVOCADO_MATH_TRAINING_HPP_
 
 #include <Avocado/math/descriptor_wrappers.hpp>
+#include <Avocado/math/activations.hpp>
 
 #include <array>
 
@@ -36,7 +37,9 @@ namespace avocado
 	enum class OptimizerType
 	{
 		SGD,
-		ADAM
+		ADAM,
+		LARS, /**< Computed by the library, not by the backend. */
+		LAMB /**< Computed by the library, not by the backend. */
 	};
 	class OptimizerConfig
 	{
@@ -77,13 +80,61 @@ namespace avocado
 	{
 
 		Scalar calcMetricFunction(const Context &context, MetricType metricType, const Tensor &output, const Tensor &target);
+		/*
+		 * Adds the number of rows of the output for which the target class is among k highest outputs to the single element INT64 'counter' tensor.
+		 * Target is either dense (the class is the index of its maximum) or holds class indices.
+		 */
+		void accumulateTopKAccuracy(const Context &context, int k, const Tensor &output, const Tensor &target, Tensor &counter);
+		/*
+		 * Increments element [target class, predicted class] of the INT64 'matrix' tensor for every row of the output.
+		 */
+		void accumulateConfusionMatrix(const Context &context, const Tensor &output, const Tensor &target, Tensor &matrix);
 
 		Scalar calcLossFunction(const Context &context, LossType lossType, const Tensor &output, const Tensor &target);
 		void calcLossGradient(const Context &context, LossType lossType, Scalar alpha, Scalar beta, Tensor &gradient, const Tensor &output,
 				const Tensor &target, bool isFused);
+		/*
+		 * Computes gradient as calcLossGradient() and adds lossScale * loss (as returned by calcLossFunction()) to the single element 'accumulator' tensor.
+		 * On CPU both are computed in a single pass for float32 and float64 while other devices and data types use separate kernels.
+		 */
+		void calcLossGradientAndAccumulate(const Context &context, LossType lossType, Scalar alpha, Scalar beta, Tensor &gradient,
+				const Tensor &output, const Tensor &target, bool isFused, double lossScale, Tensor &accumulator);
+		/*
+		 * Fused softmax and cross-entropy loss, computed in a single pass over the input (logits).
+		 * Sets output = softmax(input), gradient = alpha * (output - target) + beta * gradient (the gradient of the loss with respect to the input)
+		 * and returns the loss summed over all elements. Logarithm of the output is taken from numerically stable log-softmax of the input.
+		 */
+		Scalar softmaxCrossEntropy(const Context &context, SoftmaxMode mode, Scalar alpha, Scalar beta, const Tensor &input, Tensor &output,
+				Tensor &gradient, const Tensor &target);
+		/*
+		 * Same as above, but instead of returning the loss adds lossScale * loss to the single element 'accumulator' tensor.
+		 * On CPU it is done in the same pass for float32 and float64, other devices use calcLossGradientAndAccumulate().
+		 */
+		void softmaxCrossEntropy(const Context &context, SoftmaxMode mode, Scalar alpha, Scalar beta, const Tensor &input, Tensor &output,
+				Tensor &gradient, const Tensor &target, double lossScale, Tensor &accumulator);
 
-		void optimizerLearn(const Context &context, OptimizerConfig &config, Scalar alpha, Scalar beta, Tensor &weight, const Tensor &update,
-				Tensor &workspace);
+		/*
+		 * Performs single optimizer step on 'weight' using gradient 'update'. The step computed with the learning rate of the config
+		 * is scaled by alpha, weight is scaled by beta.
+		 * Gradient is multiplied by 'gradientScale' within the step if the optimizer allows it (SGD without momentum),
+		 * otherwise 'update' is scaled in place before the step.
+		 * If 'average' is not null it is updated after the step as average = averageDecay * average + (1 - averageDecay) * weight.
+		 * LARS and LAMB are not supported, see layerwiseAdaptiveLearn().
+		 */
+		void optimizerLearn(const Context &context, OptimizerConfig &config, Scalar alpha, Scalar beta, Tensor &weight, Tensor &update,
+				Tensor &workspace, double gradientScale = 1.0, Tensor *average = nullptr, double averageDecay = 0.0);
+		/*
+		 * Same as optimizerLearn() for the optimizers computed by the library (LARS, LAMB). 'step' is the number of steps made so far,
+		 * it is counted by the caller so that the config (and its backend descriptor) does not change between steps.
+		 * Gradient scale is applied within the step and the average is updated in the same pass.
+		 */
+		void layerwiseAdaptiveLearn(const Context &context, const OptimizerConfig &config, int64_t step, Scalar alpha, Scalar beta, Tensor &weight,
+				const Tensor &update, Tensor &workspace, double gradientScale = 1.0, Tensor *average = nullptr, double averageDecay = 0.0);
+		/*
+		 * Returns square root of the sum of squares of all elements of all tensors. On CPU it is a single parallel pass over all of them,
+		 * on other devices norms of the tensors are reduced into one device tensor which is then read with single synchronization.
+		 */
+		double globalNorm2(const Context &context, const std::vector<Tensor*> &tensors);
 
 		Scalar applyRegularizerL2(const Context &context, Tensor &gradient, const Tensor &weight, Tensor &update, Scalar scale, Scalar offset,
 				bool calcLoss);
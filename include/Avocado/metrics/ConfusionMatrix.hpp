@@ -0,0 +1,43 @@
+/*
+ * ConfusionMatrix.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#ifndef AVOCADO_METRICS_CONFUSIONMATRIX_HPP_
+#define AVOCADO_METRICS_CONFUSIONMATRIX_HPP_
+
+#include <Avocado/metrics/Metric.hpp>
+
+#include <vector>
+
+namespace avocado
+{
+
+	/*
+	 * Counts samples for each pair of target and predicted (argmax) class. The value of the metric is the overall accuracy.
+	 */
+	class ConfusionMatrix: public Metric
+	{
+			std::unique_ptr<Tensor> m_matrix; // allocated on the first update with the number of classes of the output
+		public:
+			ConfusionMatrix() = default;
+			~ConfusionMatrix();
+
+			void update(const Context &context, const Tensor &output, const Tensor &target);
+			void reset();
+			Scalar getValue() const;
+			/*
+			 * Returns matrix of counts in row-major order, where rows correspond to target classes and columns to predicted ones.
+			 */
+			std::vector<int64_t> getMatrix() const;
+			int numberOfClasses() const noexcept;
+
+			std::string name() const;
+			ConfusionMatrix* clone() const;
+	};
+
+} /* namespace avocado */
+
+#endif /* AVOCADO_METRICS_CONFUSIONMATRIX_HPP_ */
@@ -0,0 +1,42 @@
+/*
+ * MeanLoss.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#ifndef AVOCADO_METRICS_MEANLOSS_HPP_
+#define AVOCADO_METRICS_MEANLOSS_HPP_
+
+#include <Avocado/metrics/Metric.hpp>
+#include <Avocado/losses/LossFunction.hpp>
+
+namespace avocado
+{
+
+	/*
+	 * Mean value of a loss function per batch.
+	 */
+	class MeanLoss: public Metric
+	{
+			std::unique_ptr<LossFunction> m_loss;
+			std::unique_ptr<Tensor> m_sum; // allocated on the first update
+			int64_t m_batches = 0;
+		public:
+			MeanLoss() = default;
+			MeanLoss(const LossFunction &loss);
+			~MeanLoss();
+
+			void update(const Context &context, const Tensor &output, const Tensor &target);
+			void reset();
+			Scalar getValue() const;
+
+			std::string name() const;
+			MeanLoss* clone() const;
+			Json serialize(SerializedObject &binary_data) const;
+			void unserialize(const Json &json, const SerializedObject &binary_data);
+	};
+
+} /* namespace avocado */
+
+#endif /* AVOCADO_METRICS_MEANLOSS_HPP_ */
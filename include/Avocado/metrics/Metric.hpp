@@ -24,7 +24,9 @@ namespace avocado /* forward declarations */
 
 namespace avocado
 {
-
+	/*
+	 * Metrics are accumulated over many batches in tensors on the device and synchronized with the host only when the value is read.
+	 */
 	class Metric
 	{
 		public:
@@ -35,7 +37,15 @@ namespace avocado
 			Metric& operator=(Metric &&other) = delete;
 			virtual ~Metric() = default;
 
-			virtual Scalar getMetric(const Context &context, const Tensor &output, const Tensor &target, Tensor &workspace) const = 0;
+			/*
+			 * Adds results for a batch. Target is either dense (with the same shape as the output) or holds class indices.
+			 */
+			virtual void update(const Context &context, const Tensor &output, const Tensor &target) = 0;
+			virtual void reset() = 0;
+			/*
+			 * Returns the value accumulated since the last reset.
+			 */
+			virtual Scalar getValue() const = 0;
 
 			virtual std::string name() const = 0;
 			virtual Metric* clone() const = 0;
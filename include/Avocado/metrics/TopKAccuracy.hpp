@@ -0,0 +1,40 @@
+/*
+ * TopKAccuracy.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#ifndef AVOCADO_METRICS_TOPKACCURACY_HPP_
+#define AVOCADO_METRICS_TOPKACCURACY_HPP_
+
+#include <Avocado/metrics/Metric.hpp>
+
+namespace avocado
+{
+
+	/*
+	 * Fraction of samples for which the target class is among k highest outputs (k = 1 gives the usual argmax accuracy).
+	 */
+	class TopKAccuracy: public Metric
+	{
+			int m_k = 1;
+			std::unique_ptr<Tensor> m_correct; // allocated on the first update
+			int64_t m_samples = 0;
+		public:
+			TopKAccuracy(int k = 1);
+			~TopKAccuracy();
+
+			void update(const Context &context, const Tensor &output, const Tensor &target);
+			void reset();
+			Scalar getValue() const;
+
+			std::string name() const;
+			TopKAccuracy* clone() const;
+			Json serialize(SerializedObject &binary_data) const;
+			void unserialize(const Json &json, const SerializedObject &binary_data);
+	};
+
+} /* namespace avocado */
+
+#endif /* AVOCADO_METRICS_TOPKACCURACY_HPP_ */
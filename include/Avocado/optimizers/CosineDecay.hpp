@@ -0,0 +1,39 @@
+/*
+ * CosineDecay.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#ifndef AVOCADO_OPTIMIZERS_COSINEDECAY_HPP_
+#define AVOCADO_OPTIMIZERS_COSINEDECAY_HPP_
+
+#include <Avocado/optimizers/LearningRateSchedule.hpp>
+
+namespace avocado
+{
+	/*
+	 * After optional linear warmup the multiplier decays from 1 to 'minMultiplier' along half of the cosine period
+	 * and stays at 'minMultiplier' afterwards.
+	 */
+	class CosineDecay: public LearningRateSchedule
+	{
+		private:
+			int64_t m_decay_steps = 1;
+			double m_min_multiplier = 0.0;
+			int64_t m_warmup_steps = 0;
+		public:
+			CosineDecay() = default;
+			CosineDecay(int64_t decaySteps, double minMultiplier = 0.0, int64_t warmupSteps = 0);
+
+			double getMultiplier(int64_t step) const noexcept;
+
+			std::string name() const;
+			CosineDecay* clone() const;
+			Json serialize(SerializedObject &binary_data) const;
+			void unserialize(const Json &json, const SerializedObject &binary_data);
+	};
+
+} /* namespace avocado */
+
+#endif /* AVOCADO_OPTIMIZERS_COSINEDECAY_HPP_ */
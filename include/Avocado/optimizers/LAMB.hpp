@@ -0,0 +1,53 @@
+/*
+ * LAMB.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#ifndef AVOCADO_OPTIMIZERS_LAMB_HPP_
+#define AVOCADO_OPTIMIZERS_LAMB_HPP_
+
+#include <Avocado/optimizers/Optimizer.hpp>
+#include <Avocado/core/Tensor.hpp>
+#include <Avocado/math/training.hpp>
+
+#include <memory>
+
+namespace avocado
+{
+	/*
+	 * ADAM with decoupled weight decay whose step is scaled by trust ratio ||w|| / ||step||, computed separately for each parameter.
+	 * See https://arxiv.org/abs/1904.00962
+	 */
+	class LAMB: public Optimizer
+	{
+		private:
+			std::unique_ptr<Tensor> m_workspace;
+			OptimizerConfig m_config;
+			int64_t m_steps = 0; // kept here instead of in the config, so its descriptor does not change every step
+		public:
+			LAMB() = default;
+			LAMB(double learningRate, double weightDecay = 0.01);
+
+			LAMB& setBeta1(double beta1);
+			LAMB& setBeta2(double beta2);
+			LAMB& setEpsilon(double epsilon);
+
+			float getLearningRate() const noexcept;
+			void setLearningRate(double learningRate) noexcept;
+			int getSteps() const noexcept;
+
+			void restart() noexcept;
+			void moveTo(Device newDevice);
+			void learn(const Context &context, Parameter &param, double learningRateMultiplier);
+
+			std::string name() const;
+			LAMB* clone() const;
+			Json serialize(SerializedObject &binary_data) const;
+			void unserialize(const Json &json, const SerializedObject &binary_data);
+	};
+
+} /* namespace avocado */
+
+#endif /* AVOCADO_OPTIMIZERS_LAMB_HPP_ */
@@ -0,0 +1,49 @@
+/*
+ * LARS.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#ifndef AVOCADO_OPTIMIZERS_LARS_HPP_
+#define AVOCADO_OPTIMIZERS_LARS_HPP_
+
+#include <Avocado/optimizers/Optimizer.hpp>
+#include <Avocado/core/Tensor.hpp>
+#include <Avocado/math/training.hpp>
+
+#include <memory>
+
+namespace avocado
+{
+	/*
+	 * SGD with layer-wise learning rate scaled by trust ratio = trustCoefficient * ||w|| / (||g|| + weightDecay * ||w||),
+	 * computed separately for each parameter (trust ratio is 1 if either norm is zero). See https://arxiv.org/abs/1708.03888
+	 */
+	class LARS: public Optimizer
+	{
+		private:
+			std::unique_ptr<Tensor> m_workspace;
+			OptimizerConfig m_config;
+			int64_t m_steps = 0; // kept here instead of in the config, so its descriptor does not change every step
+		public:
+			LARS() = default;
+			LARS(double learningRate, double beta = 0.9, double trustCoefficient = 0.001, double weightDecay = 0.0, bool useNesterov = false);
+
+			float getLearningRate() const noexcept;
+			void setLearningRate(double learningRate) noexcept;
+			int getSteps() const noexcept;
+
+			void restart() noexcept;
+			void moveTo(Device newDevice);
+			void learn(const Context &context, Parameter &param, double learningRateMultiplier);
+
+			std::string name() const;
+			LARS* clone() const;
+			Json serialize(SerializedObject &binary_data) const;
+			void unserialize(const Json &json, const SerializedObject &binary_data);
+	};
+
+} /* namespace avocado */
+
+#endif /* AVOCADO_OPTIMIZERS_LARS_HPP_ */
@@ -0,0 +1,58 @@
+/*
+ * LearningRateSchedule.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#ifndef AVOCADO_OPTIMIZERS_LEARNINGRATESCHEDULE_HPP_
+#define AVOCADO_OPTIMIZERS_LEARNINGRATESCHEDULE_HPP_
+
+#include <cinttypes>
+#include <memory>
+#include <string>
+
+namespace avocado /* forward declarations */
+{
+	class Json;
+	class SerializedObject;
+}
+
+namespace avocado
+{
+	/*
+	 * Schedule returns a multiplier of the learning rate set in the optimizers. It is evaluated on the host once per Graph::learn()
+	 * and passed to the update as a scalar argument, so optimizer descriptors are not modified during training.
+	 */
+	class LearningRateSchedule
+	{
+		protected:
+			int64_t m_step = 0;
+		public:
+			LearningRateSchedule() = default;
+			LearningRateSchedule(const LearningRateSchedule &other) = delete;
+			LearningRateSchedule(LearningRateSchedule &&other) = delete;
+			LearningRateSchedule& operator=(const LearningRateSchedule &other) = delete;
+			LearningRateSchedule& operator=(LearningRateSchedule &&other) = delete;
+			virtual ~LearningRateSchedule() = default;
+
+			virtual double getMultiplier(int64_t step) const noexcept = 0;
+			/*
+			 * Returns the multiplier for the current step and advances to the next one.
+			 */
+			double next() noexcept;
+			int64_t getStep() const noexcept;
+			void setStep(int64_t step) noexcept;
+
+			virtual std::string name() const = 0;
+			virtual LearningRateSchedule* clone() const = 0;
+			virtual Json serialize(SerializedObject &binary_data) const;
+			virtual void unserialize(const Json &json, const SerializedObject &binary_data);
+	};
+
+	void registerLearningRateSchedule(const LearningRateSchedule &schedule);
+	std::unique_ptr<LearningRateSchedule> loadLearningRateSchedule(const Json &json, const SerializedObject &binary_data);
+
+} /* namespace avocado */
+
+#endif /* AVOCADO_OPTIMIZERS_LEARNINGRATESCHEDULE_HPP_ */
@@ -0,0 +1,36 @@
+/*
+ * LinearWarmup.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#ifndef AVOCADO_OPTIMIZERS_LINEARWARMUP_HPP_
+#define AVOCADO_OPTIMIZERS_LINEARWARMUP_HPP_
+
+#include <Avocado/optimizers/LearningRateSchedule.hpp>
+
+namespace avocado
+{
+	/*
+	 * Multiplier grows linearly from 1/warmupSteps to 1 and stays there afterwards.
+	 */
+	class LinearWarmup: public LearningRateSchedule
+	{
+		private:
+			int64_t m_warmup_steps = 1;
+		public:
+			LinearWarmup() = default;
+			LinearWarmup(int64_t warmupSteps);
+
+			double getMultiplier(int64_t step) const noexcept;
+
+			std::string name() const;
+			LinearWarmup* clone() const;
+			Json serialize(SerializedObject &binary_data) const;
+			void unserialize(const Json &json, const SerializedObject &binary_data);
+	};
+
+} /* namespace avocado */
+
+#endif /* AVOCADO_OPTIMIZERS_LINEARWARMUP_HPP_ */
@@ -0,0 +1,84 @@
+/*
+ * OffloadedWorkspace.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#ifndef AVOCADO_OPTIMIZERS_OFFLOADEDWORKSPACE_HPP_
+#define AVOCADO_OPTIMIZERS_OFFLOADEDWORKSPACE_HPP_
+
+#include <Avocado/core/DataType.hpp>
+
+#include <memory>
+#include <string>
+
+namespace avocado /* forward declarations */
+{
+	class Json;
+	class SerializedObject;
+	class Context;
+	class Tensor;
+	class Scalar;
+	class OptimizerConfig;
+}
+
+namespace avocado
+{
+	/*
+	 * Optimizer workspace kept in a memory-mapped temporary file instead of a tensor, so that the optimizer state of large models
+	 * does not have to fit in memory. The file is created in given directory and removed when the workspace is destroyed.
+	 * The workspace consists of 'slots', each of the size of the parameter (1 for SGD momentum, 2 for ADAM moments), stored one after another.
+	 * An update streams the workspace through a small staging tensor in sequential chunks, the next chunk is prefetched
+	 * by the system while the current one is updated.
+	 */
+	class OffloadedWorkspace
+	{
+		private:
+			std::string m_directory;
+			char *m_data = nullptr; // the whole mapped file
+			size_t m_size_in_bytes = 0;
+			int64_t m_volume = 0;
+			DataType m_dtype = DataType::UNKNOWN;
+			int m_chunk_size = 0; // in elements of a single slot
+			std::unique_ptr<Tensor> m_staging; // on the device of the parameter, created on first use
+		public:
+			static const int default_chunk_size = 1 << 20;
+
+			OffloadedWorkspace(const std::string &directory, int64_t volume, DataType dtype, int chunkSize = default_chunk_size);
+			/*
+			 * Loads the workspace directly into the mapped file from the format written by Tensor::serialize().
+			 */
+			OffloadedWorkspace(const std::string &directory, const Json &json, const SerializedObject &binary_data, int chunkSize =
+					default_chunk_size);
+			OffloadedWorkspace(const OffloadedWorkspace &other);
+			OffloadedWorkspace& operator=(const OffloadedWorkspace &other) = delete;
+			~OffloadedWorkspace();
+
+			const std::string& directory() const noexcept;
+			int64_t volume() const noexcept;
+			DataType dtype() const noexcept;
+			int chunkSize() const noexcept;
+
+			void zeroall();
+			/*
+			 * Releases the staging tensor, it is created again on the device of the next update.
+			 */
+			void releaseStaging() noexcept;
+			/*
+			 * Same as math::optimizerLearn() with this workspace, but performed chunk by chunk. Supported only for optimizers computed
+			 * by the backend, as the layer-wise ones (LARS, LAMB) need norms of the whole parameter.
+			 */
+			void learn(const Context &context, OptimizerConfig &config, const Scalar &alpha, const Scalar &beta, Tensor &weight, Tensor &update,
+					double gradientScale = 1.0, Tensor *average = nullptr, double averageDecay = 0.0);
+			/*
+			 * Writes the workspace in the same format as Tensor::serialize(), so it can be loaded either offloaded or not.
+			 */
+			Json serialize(SerializedObject &binary_data) const;
+		private:
+			void create_mapping();
+	};
+
+} /* namespace avocado */
+
+#endif /* AVOCADO_OPTIMIZERS_OFFLOADEDWORKSPACE_HPP_ */
@@ -0,0 +1,41 @@
+/*
+ * OneCycle.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#ifndef AVOCADO_OPTIMIZERS_ONECYCLE_HPP_
+#define AVOCADO_OPTIMIZERS_ONECYCLE_HPP_
+
+#include <Avocado/optimizers/LearningRateSchedule.hpp>
+
+namespace avocado
+{
+	/*
+	 * One-cycle policy, see https://arxiv.org/abs/1708.07120
+	 * Multiplier rises from 1/divFactor to 1 during the first 'pctStart' of the steps and then anneals to 1/(divFactor * finalDivFactor),
+	 * both phases follow the cosine curve. Learning rate of the optimizers is the maximal one.
+	 */
+	class OneCycle: public LearningRateSchedule
+	{
+		private:
+			int64_t m_total_steps = 1;
+			double m_pct_start = 0.3;
+			double m_div_factor = 25.0;
+			double m_final_div_factor = 1.0e4;
+		public:
+			OneCycle() = default;
+			OneCycle(int64_t totalSteps, double pctStart = 0.3, double divFactor = 25.0, double finalDivFactor = 1.0e4);
+
+			double getMultiplier(int64_t step) const noexcept;
+
+			std::string name() const;
+			OneCycle* clone() const;
+			Json serialize(SerializedObject &binary_data) const;
+			void unserialize(const Json &json, const SerializedObject &binary_data);
+	};
+
+} /* namespace avocado */
+
+#endif /* AVOCADO_OPTIMIZERS_ONECYCLE_HPP_ */
@@ -8,6 +8,7 @@
 #ifndef AVOCADO_OPTIMIZERS_OPTIMIZER_HPP_
 #define AVOCADO_OPTIMIZERS_OPTIMIZER_HPP_
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <stdexcept>
@@ -19,6 +20,9 @@ namespace avocado /* forward declarations */
 	class Parameter;
 	class Device;
 	class Context;
+	class Tensor;
+	class OptimizerConfig;
+	class OffloadedWorkspace;
 }
 
 namespace avocado
@@ -40,12 +44,29 @@ namespace avocado
 
 			virtual void restart() noexcept = 0;
 			virtual void moveTo(Device newDevice) = 0;
-			virtual void learn(const Context &context, Parameter &param) = 0;
+			/*
+			 * Learning rate multiplier is the value of the learning rate schedule for the current step.
+			 * It is passed to the update as a scalar so the optimizer descriptor does not have to be changed.
+			 */
+			virtual void learn(const Context &context, Parameter &param, double learningRateMultiplier) = 0;
 
 			virtual std::string name() const = 0;
 			virtual Optimizer* clone() const = 0;
 			virtual Json serialize(SerializedObject &binary_data) const = 0;
 			virtual void unserialize(const Json &json, const SerializedObject &binary_data) = 0;
+		protected:
+			/*
+			 * Performs optimizer step on the parameter, including its weight decay, gradient scale and moving average.
+			 */
+			static void learn_step(const Context &context, OptimizerConfig &config, Parameter &param, double learningRateMultiplier,
+					Tensor &workspace);
+			static void learn_step(const Context &context, OptimizerConfig &config, Parameter &param, double learningRateMultiplier,
+					OffloadedWorkspace &workspace);
+			/*
+			 * Variant for the optimizers computed by the library, with the number of steps made so far kept by the optimizer.
+			 */
+			static void learn_step(const Context &context, const OptimizerConfig &config, int64_t step, Parameter &param,
+					double learningRateMultiplier, Tensor &workspace);
 	};
 
 	void registerOptimizer(const Optimizer &opt);
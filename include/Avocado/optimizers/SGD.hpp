@@ -9,6 +9,7 @@
 #define AVOCADO_OPTIMIZERS_SGD_HPP_
 
 #include <Avocado/optimizers/Optimizer.hpp>
+#include <Avocado/optimizers/OffloadedWorkspace.hpp>
 #include <Avocado/core/Tensor.hpp>
 #include <Avocado/math/training.hpp>
 
@@ -20,6 +21,9 @@ namespace avocado
 	{
 		private:
 			std::unique_ptr<Tensor> m_workspace;
+			std::unique_ptr<OffloadedWorkspace> m_offloaded_workspace;
+			std::string m_offload_directory; // empty if the workspace is kept in a tensor
+			int m_offload_chunk_size = OffloadedWorkspace::default_chunk_size;
 			OptimizerConfig m_config;
 		public:
 			SGD() = default;
@@ -31,13 +35,20 @@ namespace avocado
 			 */
 			SGD(double learningRate, double beta = 0.0, bool useNesterov = false);
 
+			/*
+			 * Keeps the momentum in a memory-mapped file created in given directory instead of the memory of the device, see OffloadedWorkspace.
+			 * The directory is not saved by serialize(), so a loaded optimizer keeps the state in memory until this method is called again.
+			 */
+			SGD& offloadWorkspace(const std::string &directory, int chunkSize = OffloadedWorkspace::default_chunk_size);
+			bool isWorkspaceOffloaded() const noexcept;
+
 			float getLearningRate() const noexcept;
 			void setLearningRate(double lr) noexcept;
 			int getSteps() const noexcept;
 
 			void restart() noexcept;
 			void moveTo(Device newDevice);
-			void learn(const Context &context, Parameter &param);
+			void learn(const Context &context, Parameter &param, double learningRateMultiplier);
 
 			std::string name() const;
 			SGD* clone() const;
@@ -0,0 +1,37 @@
+/*
+ * StepDecay.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#ifndef AVOCADO_OPTIMIZERS_STEPDECAY_HPP_
+#define AVOCADO_OPTIMIZERS_STEPDECAY_HPP_
+
+#include <Avocado/optimizers/LearningRateSchedule.hpp>
+
+namespace avocado
+{
+	/*
+	 * Multiplier is equal to gamma^(step / stepSize) (integer division).
+	 */
+	class StepDecay: public LearningRateSchedule
+	{
+		private:
+			int64_t m_step_size = 1;
+			double m_gamma = 0.1;
+		public:
+			StepDecay() = default;
+			StepDecay(int64_t stepSize, double gamma = 0.1);
+
+			double getMultiplier(int64_t step) const noexcept;
+
+			std::string name() const;
+			StepDecay* clone() const;
+			Json serialize(SerializedObject &binary_data) const;
+			void unserialize(const Json &json, const SerializedObject &binary_data);
+	};
+
+} /* namespace avocado */
+
+#endif /* AVOCADO_OPTIMIZERS_STEPDECAY_HPP_ */
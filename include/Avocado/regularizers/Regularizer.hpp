@@ -35,6 +35,11 @@ namespace avocado
 			virtual ~Regularizer() = default;
 
 			virtual void apply(const Context &context, Parameter &param) = 0;
+			/*
+			 * Decay per unit of learning rate that the optimizer applies by scaling the weights within its own update.
+			 * Regularizers returning non-zero value are not applied separately.
+			 */
+			virtual double getWeightDecay() const noexcept;
 
 			virtual std::string name() const = 0;
 			virtual Regularizer* clone() const = 0;
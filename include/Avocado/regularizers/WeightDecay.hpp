@@ -0,0 +1,38 @@
+/*
+ * WeightDecay.hpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#ifndef AVOCADO_REGULARIZERS_WEIGHTDECAY_HPP_
+#define AVOCADO_REGULARIZERS_WEIGHTDECAY_HPP_
+
+#include <Avocado/regularizers/Regularizer.hpp>
+
+namespace avocado
+{
+	/*
+	 * Decoupled weight decay (as in AdamW or SGDW, see https://arxiv.org/abs/1711.05101).
+	 * Each step the optimizer scales the weights by (1 - learning rate * decay) in the same pass that applies the update,
+	 * instead of adding the penalty gradient in a separate pass as RegularizerL2 does.
+	 */
+	class WeightDecay: public Regularizer
+	{
+			double m_decay = 0.0;
+		public:
+			WeightDecay() = default;
+			WeightDecay(double decay);
+
+			void apply(const Context &context, Parameter &param);
+			double getWeightDecay() const noexcept;
+
+			std::string name() const;
+			WeightDecay* clone() const;
+			Json serialize(SerializedObject &binary_data) const;
+			void unserialize(const Json &json, const SerializedObject &binary_data);
+	};
+
+} /* namespace avocado */
+
+#endif /* AVOCADO_REGULARIZERS_WEIGHTDECAY_HPP_ */
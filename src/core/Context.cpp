@@ -12,8 +12,175 @@
 #include <algorithm>
 #include <iostream>
 
+#include <omp.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+namespace
+{
+	/* constants from <numaif.h>, defined here to avoid dependency on libnuma */
+	const int MPOL_BIND = 2;
+	const unsigned MPOL_MF_MOVE = 1u << 1;
+
+	int common_numa_node(const std::vector<int> &cores)
+	{
+		const avocado::CpuTopology &topology = avocado::Device::cpuTopology();
+		int result = -1;
+		for (size_t i = 0; i < cores.size(); i++)
+			for (size_t j = 0; j < topology.cores.size(); j++)
+				if (topology.cores[j].index == cores[i])
+				{
+					if (result != -1 and result != topology.cores[j].numaNode)
+						return -1;
+					result = topology.cores[j].numaNode;
+				}
+		return result;
+	}
+	std::vector<int> split_range(const std::vector<int> &values, int parts, int index)
+	{
+		const size_t begin = (values.size() * index) / parts;
+		const size_t end = (values.size() * (index + 1)) / parts;
+		return std::vector<int>(values.begin() + begin, values.begin() + end);
+	}
+}
+
 namespace avocado
 {
+	ThreadGroup::ThreadGroup(const std::vector<int> &cores, int numaNode) :
+			m_cores(cores),
+			m_numa_node(numaNode)
+	{
+		if (numaNode < -1 || numaNode >= Device::cpuTopology().numberOfNumaNodes())
+			throw IndexOutOfBounds(METHOD_NAME, "numaNode", numaNode, Device::cpuTopology().numberOfNumaNodes());
+		if (m_numa_node == -1)
+			m_numa_node = common_numa_node(cores);
+	}
+	ThreadGroup ThreadGroup::forNumaNode(int node)
+	{
+		return ThreadGroup(Device::cpuTopology().coresOfNumaNode(node), node);
+	}
+	ThreadGroup ThreadGroup::forSocket(int socket)
+	{
+		return ThreadGroup(Device::cpuTopology().coresOfSocket(socket));
+	}
+	std::vector<ThreadGroup> ThreadGroup::partition(int numberOfGroups)
+	{
+		return partition(numberOfGroups, Device::cpuTopology());
+	}
+	std::vector<ThreadGroup> ThreadGroup::partition(int numberOfGroups, const CpuTopology &topology)
+	{
+		if (numberOfGroups <= 0)
+			throw IllegalArgument(METHOD_NAME, "numberOfGroups", "must be positive", numberOfGroups);
+
+		std::vector<int> nodes;
+		int nb_cores = 0;
+		for (int i = 0; i < topology.numberOfNumaNodes(); i++)
+			if (not topology.numaNodes[i].empty())
+			{
+				nodes.push_back(i);
+				nb_cores += topology.numaNodes[i].size();
+			}
+		if (nodes.empty())
+			throw IllegalArgument(METHOD_NAME, "topology has no cores");
+		if (numberOfGroups > nb_cores)
+			throw IllegalArgument(METHOD_NAME, "numberOfGroups", "must not exceed the number of cores (" + std::to_string(nb_cores) + ")",
+					numberOfGroups);
+
+		std::vector<ThreadGroup> result(numberOfGroups); // filled directly as the topology may not be the one of this machine
+		const int nb_nodes = static_cast<int>(nodes.size());
+		if (numberOfGroups >= nb_nodes)
+		{
+			std::vector<int> groups_in_node(nb_nodes);
+			int excess = 0;
+			for (int i = 0; i < nb_nodes; i++)
+			{
+				const int node_size = topology.numaNodes[nodes[i]].size();
+				groups_in_node[i] = numberOfGroups / nb_nodes + static_cast<int>(i < numberOfGroups % nb_nodes);
+				excess += std::max(0, groups_in_node[i] - node_size);
+				groups_in_node[i] = std::min(groups_in_node[i], node_size);
+			}
+			for (int i = 0; i < nb_nodes and excess > 0; i++)
+			{ // groups that do not fit into small nodes are moved to those with spare cores, so no group is empty
+				const int moved = std::min(excess, static_cast<int>(topology.numaNodes[nodes[i]].size()) - groups_in_node[i]);
+				groups_in_node[i] += moved;
+				excess -= moved;
+			}
+
+			int index = 0;
+			for (int i = 0; i < nb_nodes; i++)
+				for (int j = 0; j < groups_in_node[i]; j++, index++)
+				{
+					result[index].m_cores = split_range(topology.numaNodes[nodes[i]], groups_in_node[i], j);
+					result[index].m_numa_node = nodes[i];
+				}
+		}
+		else
+		{
+			for (int i = 0; i < numberOfGroups; i++)
+			{
+				const std::vector<int> merged_nodes = split_range(nodes, numberOfGroups, i);
+				for (int node : merged_nodes)
+					result[i].m_cores.insert(result[i].m_cores.end(), topology.numaNodes[node].begin(), topology.numaNodes[node].end());
+				result[i].m_numa_node = (merged_nodes.size() == 1) ? merged_nodes[0] : -1;
+			}
+		}
+		return result;
+	}
+	const std::vector<int>& ThreadGroup::cores() const noexcept
+	{
+		return m_cores;
+	}
+	int ThreadGroup::numaNode() const noexcept
+	{
+		return m_numa_node;
+	}
+	int ThreadGroup::size() const noexcept
+	{
+		return static_cast<int>(m_cores.size());
+	}
+	bool ThreadGroup::isEmpty() const noexcept
+	{
+		return m_cores.empty();
+	}
+	std::string ThreadGroup::toString() const
+	{
+		std::string result = "{";
+		for (size_t i = 0; i < m_cores.size(); i++)
+			result += ((i == 0) ? "" : ",") + std::to_string(m_cores[i]);
+		return result + "} on NUMA node " + std::to_string(m_numa_node);
+	}
+
+	std::string toString(FastMathMode mode)
+	{
+		switch (mode)
+		{
+			default:
+			case FastMathMode::EXACT:
+				return "exact";
+			case FastMathMode::FAST:
+				return "fast";
+			case FastMathMode::FASTEST:
+				return "fastest";
+		}
+	}
+	FastMathMode fastMathModeFromString(const std::string &str)
+	{
+		if (str == "exact")
+			return FastMathMode::EXACT;
+		if (str == "fast")
+			return FastMathMode::FAST;
+		if (str == "fastest")
+			return FastMathMode::FASTEST;
+		throw LogicError(METHOD_NAME, "unknown fast math mode '" + str + "'");
+	}
+
+	Context::Context(Device device, const ThreadGroup &group) :
+			Context(device)
+	{
+		m_thread_group = group;
+	}
 	Context::Context(Device device) :
 			m_device(device)
 	{
@@ -41,7 +208,9 @@ namespace avocado
 	}
 	Context::Context(Context &&other) :
 			m_data(other.m_data),
-			m_device(other.m_device)
+			m_device(other.m_device),
+			m_thread_group(other.m_thread_group),
+			m_fast_math_mode(other.m_fast_math_mode)
 	{
 		other.m_data = backend::AVOCADO_NULL_DESCRIPTOR;
 	}
@@ -49,6 +218,8 @@ namespace avocado
 	{
 		std::swap(this->m_data, other.m_data);
 		std::swap(this->m_device, other.m_device);
+		std::swap(this->m_thread_group, other.m_thread_group);
+		std::swap(this->m_fast_math_mode, other.m_fast_math_mode);
 		return *this;
 	}
 	Context::~Context()
@@ -101,6 +272,67 @@ namespace avocado
 			}
 		}
 	}
+	const ThreadGroup& Context::threadGroup() const noexcept
+	{
+		return m_thread_group;
+	}
+	void Context::activate() const
+	{
+		if (m_thread_group.isEmpty())
+			return;
+
+		thread_local std::vector<int> pinned_cores; // avoids repeated system calls when the same thread group is activated again
+		if (pinned_cores != m_thread_group.cores())
+		{
+			cpu_set_t set;
+			CPU_ZERO(&set);
+			for (int core : m_thread_group.cores())
+				CPU_SET(core, &set);
+			int status = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &set);
+			if (status != 0)
+				throw RuntimeError(METHOD_NAME, "could not pin thread to cores " + m_thread_group.toString());
+			pinned_cores = m_thread_group.cores();
+		}
+		// OpenMP thread count is a per-thread setting, so parallel regions started from this thread use the size of the group
+		// without affecting other contexts (Device::setNumberOfThreads() would change it globally). Worker threads inherit the affinity.
+		omp_set_num_threads(m_thread_group.size());
+	}
+	bool Context::bindToLocalNode(const void *ptr, size_t sizeInBytes) const noexcept
+	{
+		const int node = m_thread_group.numaNode();
+		if (ptr == nullptr or sizeInBytes == 0 or node < 0 or Device::cpuTopology().numberOfNumaNodes() < 2)
+			return false;
+
+		const uintptr_t page_size = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+		const uintptr_t begin = reinterpret_cast<uintptr_t>(ptr) & ~(page_size - 1);
+		const uintptr_t end = reinterpret_cast<uintptr_t>(ptr) + sizeInBytes;
+
+		const int bits = 8 * sizeof(unsigned long);
+		std::vector<unsigned long> mask(node / bits + 1, 0ul);
+		mask[node / bits] |= 1ul << (node % bits);
+		long status = syscall(SYS_mbind, begin, end - begin, MPOL_BIND, mask.data(), mask.size() * bits + 1, MPOL_MF_MOVE);
+		return status == 0;
+	}
+	MemoryUsage Context::getMemoryUsage() const
+	{
+		return MemoryTracker::getCurrentUsage(m_device);
+	}
+	MemoryUsage Context::getPeakMemoryUsage() const
+	{
+		return MemoryTracker::getPeakUsage(m_device);
+	}
+	void Context::resetPeakMemoryUsage() const
+	{
+		MemoryTracker::resetPeakUsage(m_device);
+	}
+	void Context::setFastMathMode(FastMathMode mode) noexcept
+	{
+		m_fast_math_mode = mode;
+	}
+	FastMathMode Context::fastMathMode() const noexcept
+	{
+		return m_fast_math_mode;
+	}
 	backend::avContextDescriptor_t Context::getDescriptor() const noexcept
 	{
 		return m_data;
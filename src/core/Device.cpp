@@ -13,6 +13,8 @@
 #include <cstring>
 #include <vector>
 #include <iostream>
+#include <fstream>
+#include <algorithm>
 
 namespace
 {
@@ -157,6 +159,117 @@ namespace
 		return result[index];
 	}
 
+	std::string read_sysfs(const std::string &path)
+	{
+		std::ifstream file(path);
+		std::string result;
+		if (file.good())
+			std::getline(file, result);
+		return result;
+	}
+	int read_sysfs_int(const std::string &path, int defaultValue)
+	{
+		std::string tmp = read_sysfs(path);
+		if (tmp.empty())
+			return defaultValue;
+		return std::atoi(tmp.data());
+	}
+	std::vector<int> parse_cpu_list(const std::string &str) // parses lists in format like "0-3,8,10-11"
+	{
+		std::vector<int> result;
+		size_t pos = 0;
+		while (pos < str.size())
+		{
+			size_t end = std::min(str.find(',', pos), str.size());
+			std::string range = str.substr(pos, end - pos);
+			size_t dash = range.find('-');
+			if (dash == std::string::npos)
+				result.push_back(std::atoi(range.data()));
+			else
+				for (int i = std::atoi(range.data()); i <= std::atoi(range.data() + dash + 1); i++)
+					result.push_back(i);
+			pos = end + 1;
+		}
+		return result;
+	}
+	int64_t parse_cache_size(const std::string &str) // parses sizes in format like "32K"
+	{
+		int64_t result = std::atoll(str.data());
+		if (str.find('K') != std::string::npos)
+			result <<= 10;
+		if (str.find('M') != std::string::npos)
+			result <<= 20;
+		return result;
+	}
+	CpuTopology detect_cpu_topology(const std::string &root)
+	{
+		const std::string path = root + "cpu/";
+		CpuTopology result;
+
+		std::vector<int> online = parse_cpu_list(read_sysfs(path + "online"));
+		if (online.empty()) // no sysfs, assume single socket and single NUMA node
+			for (int i = 0; i < std::max(1, cpu_features().cores); i++)
+				online.push_back(i);
+
+		std::vector<int> socket_ids;
+		for (size_t i = 0; i < online.size(); i++)
+		{
+			const std::string cpu_path = path + "cpu" + std::to_string(online[i]) + "/";
+			CpuTopology::Core core;
+			core.index = online[i];
+			core.physicalCore = read_sysfs_int(cpu_path + "topology/core_id", online[i]);
+
+			const int package_id = read_sysfs_int(cpu_path + "topology/physical_package_id", 0);
+			if (std::find(socket_ids.begin(), socket_ids.end(), package_id) == socket_ids.end())
+				socket_ids.push_back(package_id);
+			core.socket = std::find(socket_ids.begin(), socket_ids.end(), package_id) - socket_ids.begin();
+			result.cores.push_back(core);
+
+			for (int j = 0;; j++)
+			{
+				const std::string cache_path = cpu_path + "cache/index" + std::to_string(j) + "/";
+				std::string size = read_sysfs(cache_path + "size");
+				if (size.empty())
+					break;
+				CpuTopology::Cache cache;
+				cache.level = read_sysfs_int(cache_path + "level", 0);
+				cache.size = parse_cache_size(size);
+				cache.type = read_sysfs(cache_path + "type");
+				cache.sharedBy = parse_cpu_list(read_sysfs(cache_path + "shared_cpu_list"));
+				if (cache.sharedBy.empty())
+					cache.sharedBy.push_back(online[i]);
+
+				bool already_listed = std::any_of(result.caches.begin(), result.caches.end(), [&](const CpuTopology::Cache &c)
+				{	return c.level == cache.level and c.type == cache.type and c.sharedBy == cache.sharedBy;});
+				if (not already_listed)
+					result.caches.push_back(cache);
+			}
+		}
+		result.sockets = std::max(1, static_cast<int>(socket_ids.size()));
+
+		std::vector<int> nodes = parse_cpu_list(read_sysfs(root + "node/online"));
+		for (size_t i = 0; i < nodes.size(); i++)
+		{
+			std::vector<int> cpus = parse_cpu_list(read_sysfs(root + "node/node" + std::to_string(nodes[i]) + "/cpulist"));
+			if (static_cast<int>(result.numaNodes.size()) <= nodes[i])
+				result.numaNodes.resize(nodes[i] + 1);
+			for (size_t j = 0; j < cpus.size(); j++)
+				for (size_t k = 0; k < result.cores.size(); k++)
+					if (result.cores[k].index == cpus[j])
+					{
+						result.cores[k].numaNode = nodes[i];
+						result.numaNodes[nodes[i]].push_back(cpus[j]);
+					}
+		}
+		if (result.numaNodes.empty()) // no NUMA information, all cores belong to node 0
+		{
+			result.numaNodes.resize(1);
+			for (size_t i = 0; i < result.cores.size(); i++)
+				result.numaNodes[0].push_back(result.cores[i].index);
+		}
+		return result;
+	}
+
 	const char* get_simd_name(CpuSimd s)
 	{
 		switch (s)
@@ -190,6 +303,54 @@ namespace
 
 namespace avocado
 {
+	CpuTopology CpuTopology::fromSysfs(const std::string &path)
+	{
+		std::string root = path;
+		if (not root.empty() and root.back() != '/')
+			root += '/';
+		return detect_cpu_topology(root);
+	}
+	int CpuTopology::numberOfCores() const noexcept
+	{
+		return static_cast<int>(cores.size());
+	}
+	int CpuTopology::numberOfNumaNodes() const noexcept
+	{
+		return static_cast<int>(numaNodes.size());
+	}
+	std::vector<int> CpuTopology::coresOfNumaNode(int node) const
+	{
+		if (node < 0 || node >= numberOfNumaNodes())
+			throw IndexOutOfBounds(METHOD_NAME, "node", node, numberOfNumaNodes());
+		return numaNodes[node];
+	}
+	std::vector<int> CpuTopology::coresOfSocket(int socket) const
+	{
+		if (socket < 0 || socket >= sockets)
+			throw IndexOutOfBounds(METHOD_NAME, "socket", socket, sockets);
+		std::vector<int> result;
+		for (size_t i = 0; i < cores.size(); i++)
+			if (cores[i].socket == socket)
+				result.push_back(cores[i].index);
+		return result;
+	}
+	int64_t CpuTopology::cacheSize(int level, int core) const noexcept
+	{
+		for (size_t i = 0; i < caches.size(); i++)
+			if (caches[i].level == level and caches[i].type != "Instruction")
+				if (std::find(caches[i].sharedBy.begin(), caches[i].sharedBy.end(), core) != caches[i].sharedBy.end())
+					return caches[i].size;
+		return 0;
+	}
+	std::string CpuTopology::toString() const
+	{
+		std::string result = std::to_string(sockets) + " socket(s), " + std::to_string(numberOfCores()) + " core(s), "
+				+ std::to_string(numberOfNumaNodes()) + " NUMA node(s)";
+		for (int level = 1; level <= 3; level++)
+			if (cacheSize(level) > 0)
+				result += ", L" + std::to_string(level) + " " + std::to_string(cacheSize(level) >> 10) + "KB";
+		return result;
+	}
 
 	Device::Device(DeviceType type, int index) :
 			m_type(type),
@@ -384,6 +545,11 @@ namespace avocado
 		else
 			return CpuSimd::NONE;
 	}
+	const CpuTopology& Device::cpuTopology()
+	{
+		static const CpuTopology result = CpuTopology::fromSysfs("/sys/devices/system/");
+		return result;
+	}
 
 //CUDA features
 	int Device::computeCapability() const noexcept
@@ -438,6 +604,7 @@ namespace avocado
 	std::string Device::hardwareInfo()
 	{
 		std::string result = Device::cpu().toString() + " = " + Device::cpu().info() + '\n';
+		result += "CPU topology = " + Device::cpuTopology().toString() + '\n';
 		for (int i = 0; i < Device::numberOfCudaDevices(); i++)
 			result += Device::cuda(i).toString() + " = " + Device::cuda(i).info() + '\n';
 		for (int i = 0; i < Device::numberOfOpenCLDevices(); i++)
@@ -0,0 +1,171 @@
+/*
+ * MemoryTracker.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <Avocado/core/MemoryTracker.hpp>
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+	using namespace avocado;
+
+	struct DeviceUsage
+	{
+			MemoryUsage current;
+			MemoryUsage peak;
+			std::vector<MemoryTracker::PeakWatcher*> watchers;
+	};
+
+	/* allocations are rare compared to other operations so a single lock is enough
+	 * both objects are never destroyed as tensors with static storage duration may be released after them */
+	std::mutex& tracker_mutex()
+	{
+		static std::mutex *result = new std::mutex();
+		return *result;
+	}
+	DeviceUsage& get_usage(Device device)
+	{
+		static std::map<std::pair<int, int>, DeviceUsage> *result = new std::map<std::pair<int, int>, DeviceUsage>();
+		return (*result)[ { static_cast<int>(device.type()), device.index() }];
+	}
+	MemoryCategory& current_category() noexcept
+	{
+		thread_local MemoryCategory result = MemoryCategory::OTHER;
+		return result;
+	}
+	void update_peak(MemoryUsage &peak, const MemoryUsage &current) noexcept
+	{
+		for (int i = 0; i < number_of_memory_categories; i++)
+			peak.bytes[i] = std::max(peak.bytes[i], current.bytes[i]);
+		peak.total = std::max(peak.total, current.total);
+	}
+}
+
+namespace avocado
+{
+	std::string toString(MemoryCategory c)
+	{
+		switch (c)
+		{
+			default:
+			case MemoryCategory::OTHER:
+				return "other";
+			case MemoryCategory::PARAMETERS:
+				return "parameters";
+			case MemoryCategory::UPDATES:
+				return "updates";
+			case MemoryCategory::OPTIMIZER_WORKSPACE:
+				return "optimizer workspace";
+			case MemoryCategory::ACTIVATIONS:
+				return "activations";
+			case MemoryCategory::GRADIENTS:
+				return "gradients";
+			case MemoryCategory::BACKUP:
+				return "backup";
+			case MemoryCategory::WORKSPACE:
+				return "workspace";
+		}
+	}
+
+	size_t MemoryUsage::operator[](MemoryCategory c) const noexcept
+	{
+		return bytes[static_cast<int>(c)];
+	}
+	std::string MemoryUsage::toString() const
+	{
+		std::string result = "total = " + std::to_string(total);
+		for (int i = 0; i < number_of_memory_categories; i++)
+			result += ", " + avocado::toString(static_cast<MemoryCategory>(i)) + " = " + std::to_string(bytes[i]);
+		return result;
+	}
+
+	MemoryTracker::PeakWatcher::PeakWatcher(Device device) :
+			m_device(device)
+	{
+		std::lock_guard<std::mutex> lock(tracker_mutex());
+		DeviceUsage &usage = get_usage(m_device);
+		m_peak = usage.current;
+		usage.watchers.push_back(this);
+	}
+	MemoryTracker::PeakWatcher::~PeakWatcher()
+	{
+		std::lock_guard<std::mutex> lock(tracker_mutex());
+		std::vector<PeakWatcher*> &watchers = get_usage(m_device).watchers;
+		watchers.erase(std::find(watchers.begin(), watchers.end(), this));
+	}
+	MemoryUsage MemoryTracker::PeakWatcher::getPeak() const
+	{
+		std::lock_guard<std::mutex> lock(tracker_mutex());
+		return m_peak;
+	}
+
+	void MemoryTracker::allocated(Device device, MemoryCategory category, size_t bytes) noexcept
+	{
+		std::lock_guard<std::mutex> lock(tracker_mutex());
+		DeviceUsage &usage = get_usage(device);
+		usage.current.bytes[static_cast<int>(category)] += bytes;
+		usage.current.total += bytes;
+		update_peak(usage.peak, usage.current);
+		for (size_t i = 0; i < usage.watchers.size(); i++)
+			update_peak(usage.watchers[i]->m_peak, usage.current);
+	}
+	void MemoryTracker::freed(Device device, MemoryCategory category, size_t bytes) noexcept
+	{
+		std::lock_guard<std::mutex> lock(tracker_mutex());
+		DeviceUsage &usage = get_usage(device);
+		usage.current.bytes[static_cast<int>(category)] -= bytes;
+		usage.current.total -= bytes;
+	}
+	void MemoryTracker::changeCategory(Device device, MemoryCategory from, MemoryCategory to, size_t bytes) noexcept
+	{
+		if (from == to)
+			return;
+		std::lock_guard<std::mutex> lock(tracker_mutex());
+		DeviceUsage &usage = get_usage(device);
+		usage.current.bytes[static_cast<int>(from)] -= bytes;
+		usage.current.bytes[static_cast<int>(to)] += bytes;
+		update_peak(usage.peak, usage.current);
+		for (size_t i = 0; i < usage.watchers.size(); i++)
+			update_peak(usage.watchers[i]->m_peak, usage.current);
+	}
+
+	MemoryUsage MemoryTracker::getCurrentUsage(Device device)
+	{
+		std::lock_guard<std::mutex> lock(tracker_mutex());
+		return get_usage(device).current;
+	}
+	MemoryUsage MemoryTracker::getPeakUsage(Device device)
+	{
+		std::lock_guard<std::mutex> lock(tracker_mutex());
+		return get_usage(device).peak;
+	}
+	void MemoryTracker::resetPeakUsage(Device device)
+	{
+		std::lock_guard<std::mutex> lock(tracker_mutex());
+		DeviceUsage &usage = get_usage(device);
+		usage.peak = usage.current;
+	}
+
+	MemoryCategory MemoryTracker::currentCategory() noexcept
+	{
+		return current_category();
+	}
+
+	MemoryCategoryScope::MemoryCategoryScope(MemoryCategory category) noexcept :
+			m_previous(current_category())
+	{
+		current_category() = category;
+	}
+	MemoryCategoryScope::~MemoryCategoryScope() noexcept
+	{
+		current_category() = m_previous;
+	}
+
+} /* namespace avocado */
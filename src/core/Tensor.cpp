@@ -58,6 +58,7 @@ namespace avocado
 		if (other.isOwning())
 		{
 			m_memory_descriptor = internal::MemoryDescWrapper(m_device, sizeInBytes());
+			m_memory_descriptor.setCategory(other.memoryCategory());
 			internal::copy_memory(get_default_context(m_device), m_memory_descriptor, 0, other.m_memory_descriptor, 0, sizeInBytes());
 		}
 		else
@@ -70,10 +71,12 @@ namespace avocado
 			m_tensor_descriptor(std::move(other.m_tensor_descriptor)),
 			m_memory_descriptor(std::move(other.m_memory_descriptor)),
 			m_owning_tensor_pointer(other.m_owning_tensor_pointer),
-			m_memory_offset(other.m_memory_offset)
+			m_memory_offset(other.m_memory_offset),
+			m_is_page_locked(other.m_is_page_locked)
 	{
 		create_stride();
 		other.m_owning_tensor_pointer = nullptr;
+		other.m_is_page_locked = false;
 	}
 	Tensor::~Tensor() noexcept
 	{
@@ -93,6 +96,7 @@ namespace avocado
 				}
 				else
 					m_memory_descriptor = internal::MemoryDescWrapper(m_device, other.sizeInBytes());
+				m_memory_descriptor.setCategory(other.memoryCategory());
 				internal::copy_memory(get_default_context(m_device), m_memory_descriptor, 0, other.m_memory_descriptor, 0, other.sizeInBytes());
 			}
 			else
@@ -119,6 +123,7 @@ namespace avocado
 			std::swap(this->m_memory_descriptor, other.m_memory_descriptor);
 			std::swap(this->m_owning_tensor_pointer, other.m_owning_tensor_pointer);
 			std::swap(this->m_memory_offset, other.m_memory_offset);
+			std::swap(this->m_is_page_locked, other.m_is_page_locked);
 		}
 		return *this;
 	}
@@ -207,6 +212,7 @@ namespace avocado
 			return;
 
 		internal::MemoryDescWrapper newMemDesc(newDevice, sizeInBytes());
+		newMemDesc.setCategory(memoryCategory());
 		internal::copy_memory(get_default_context(m_device), newMemDesc, 0, m_memory_descriptor, 0, sizeInBytes());
 		std::swap(m_memory_descriptor, newMemDesc);
 
@@ -234,12 +240,24 @@ namespace avocado
 		else
 		{
 			internal::MemoryDescWrapper newMemDesc(m_device, sizeInBytes());
+			newMemDesc.setCategory(memoryCategory());
 			internal::change_type(get_default_context(m_device), newMemDesc, newType, m_memory_descriptor, m_dtype, volume());
 			std::swap(m_memory_descriptor, newMemDesc);
 		}
 		m_dtype = newType;
 		m_tensor_descriptor.set(m_shape, m_dtype);
 	}
+	MemoryCategory Tensor::memoryCategory() const noexcept
+	{
+		if (isView())
+			return m_owning_tensor_pointer->memoryCategory();
+		return m_memory_descriptor.category();
+	}
+	void Tensor::setMemoryCategory(MemoryCategory category) noexcept
+	{
+		if (isOwning())
+			m_memory_descriptor.setCategory(category);
+	}
 	void Tensor::zeroall()
 	{
 		internal::set_memory(get_default_context(m_device), m_memory_descriptor, 0, sizeInBytes(), nullptr, 0);
@@ -311,6 +329,14 @@ namespace avocado
 	{
 		return view(shape(), 0);
 	}
+	const Tensor Tensor::view() const
+	{
+		return view(shape(), 0);
+	}
+	const Tensor Tensor::view(const Shape &shape, size_t offsetInElements) const
+	{
+		return const_cast<Tensor*>(this)->view(shape, offsetInElements); // returned view is const so it cannot be used to modify this tensor
+	}
 	Tensor Tensor::view(const Shape &shape, size_t offsetInElements)
 	{
 		if (this->isView())
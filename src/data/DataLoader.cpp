@@ -0,0 +1,254 @@
+/*
+ * DataLoader.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <Avocado/data/DataLoader.hpp>
+#include <Avocado/data/Dataset.hpp>
+#include <Avocado/graph/Graph.hpp>
+#include <Avocado/core/error_handling.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+namespace
+{
+	using namespace avocado;
+
+	int number_of_targets(const Graph &graph)
+	{
+		return graph.isTrainable() ? graph.numberOfOutputs() : 0;
+	}
+	Shape row_shape(const Tensor &batch)
+	{
+		Shape result(batch.shape());
+		result[0] = 1;
+		return result;
+	}
+}
+
+namespace avocado
+{
+	DataLoader::DataLoader(const Dataset &dataset, Graph &graph, int numberOfWorkers, int prefetchedBatches, bool shuffle, uint64_t seed) :
+			m_dataset(dataset),
+			m_graph(graph),
+			m_batch_size(graph.maxBatchSize()),
+			m_batches_per_epoch((dataset.size() + std::max(1, m_batch_size) - 1) / std::max(1, m_batch_size)),
+			m_shuffle(shuffle),
+			m_seed(seed)
+	{
+		if (dataset.size() == 0)
+			throw IllegalArgument(METHOD_NAME, "dataset", "must not be empty", 0);
+		if (m_batch_size <= 0)
+			throw UninitializedObject(METHOD_NAME, "graph has no inputs");
+		if (numberOfWorkers < 1)
+			throw IllegalArgument(METHOD_NAME, "numberOfWorkers", "must be positive", numberOfWorkers);
+		if (prefetchedBatches < 1)
+			throw IllegalArgument(METHOD_NAME, "prefetchedBatches", "must be positive", prefetchedBatches);
+
+		std::vector<Tensor*> graph_tensors;
+		for (int i = 0; i < graph.numberOfInputs(); i++)
+			graph_tensors.push_back(&graph.getInput(i));
+		for (int i = 0; i < number_of_targets(graph); i++)
+			graph_tensors.push_back(&graph.getTarget(i));
+
+		m_slots = std::vector<Slot>(prefetchedBatches);
+		for (size_t i = 0; i < m_slots.size(); i++)
+		{
+			m_slots[i].tensors.reserve(graph_tensors.size()); // page locked tensors are never moved afterwards
+			for (size_t j = 0; j < graph_tensors.size(); j++)
+			{
+				m_slots[i].tensors.emplace_back(graph_tensors[j]->shape(), graph_tensors[j]->dtype(), Device::cpu());
+				if (not graph.device().isCPU())
+					m_slots[i].tensors.back().pageLock();
+			}
+		}
+		for (size_t j = 0; j < graph_tensors.size(); j++)
+		{
+			m_alternate.emplace_back(graph_tensors[j]->shape(), graph_tensors[j]->dtype(), graph.device());
+			m_alternate.back().setMemoryCategory(graph_tensors[j]->memoryCategory());
+		}
+
+		for (int i = 0; i < numberOfWorkers; i++)
+			m_workers.push_back(std::thread(&DataLoader::worker_loop, this));
+		m_copier = std::thread(&DataLoader::copier_loop, this);
+	}
+	DataLoader::~DataLoader()
+	{
+		{
+			std::lock_guard lock(m_mutex);
+			m_is_running = false;
+		}
+		m_cond.notify_all();
+		for (size_t i = 0; i < m_workers.size(); i++)
+			m_workers[i].join();
+		m_copier.join();
+	}
+
+	int DataLoader::batchSize() const noexcept
+	{
+		return m_batch_size;
+	}
+	int DataLoader::numberOfBatches() const noexcept
+	{
+		return static_cast<int>(m_batches_per_epoch);
+	}
+	int DataLoader::currentEpoch() const noexcept
+	{
+		return (m_current_batch < 0) ? 0 : static_cast<int>(m_current_batch / m_batches_per_epoch);
+	}
+	int DataLoader::currentBatch() const noexcept
+	{
+		return (m_current_batch < 0) ? -1 : static_cast<int>(m_current_batch % m_batches_per_epoch);
+	}
+	bool DataLoader::isLastBatchOfEpoch() const noexcept
+	{
+		return currentBatch() == m_batches_per_epoch - 1;
+	}
+
+	int DataLoader::next()
+	{
+		// buffers of the graph are swapped into the alternate ones and refilled by the copier, so the previous step which used them
+		// must be finished, while the step that is about to use the new batch (not yet launched) can overlap with that copy
+		m_graph.context().synchronize();
+
+		std::unique_lock lock(m_mutex);
+		m_cond.wait(lock, [this]()
+		{	return m_alternate_is_ready;});
+
+		m_alternate_is_ready = false;
+		m_current_batch++;
+		if (m_alternate_error != nullptr)
+		{
+			std::exception_ptr error = m_alternate_error;
+			m_alternate_error = nullptr;
+			lock.unlock();
+			m_cond.notify_all();
+			std::rethrow_exception(error);
+		}
+
+		for (int i = 0; i < m_graph.numberOfInputs(); i++)
+		{
+			if (m_graph.getInput(i).shape() != m_alternate[i].shape() or m_graph.getInput(i).device() != m_alternate[i].device())
+				throw LogicError(METHOD_NAME, "graph inputs were changed after creating the data loader");
+			std::swap(m_graph.getInput(i), m_alternate[i]);
+		}
+		for (int i = 0; i < number_of_targets(m_graph); i++)
+		{
+			Tensor &alternate = m_alternate[m_graph.numberOfInputs() + i];
+			if (m_graph.getTarget(i).shape() != alternate.shape() or m_graph.getTarget(i).device() != alternate.device())
+				throw LogicError(METHOD_NAME, "graph targets were changed after creating the data loader");
+			std::swap(m_graph.getTarget(i), alternate);
+		}
+		const int result = m_alternate_size;
+		lock.unlock();
+		m_cond.notify_all();
+		return result;
+	}
+
+	void DataLoader::worker_loop()
+	{
+		while (true)
+		{
+			std::unique_lock lock(m_mutex);
+			m_cond.wait(lock, [this]()
+			{	return m_next_to_fill < m_next_to_copy + static_cast<int64_t>(m_slots.size()) or not m_is_running;});
+			if (not m_is_running)
+				return;
+
+			const int64_t batch = m_next_to_fill++;
+			Slot &slot = m_slots[batch % m_slots.size()];
+			const std::vector<size_t> &ordering = get_ordering(batch / m_batches_per_epoch);
+			lock.unlock();
+
+			try
+			{
+				fill_slot(slot, batch, ordering);
+			} catch (...)
+			{
+				slot.error = std::current_exception();
+			}
+
+			lock.lock();
+			slot.batch = batch;
+			slot.is_ready = true;
+			lock.unlock();
+			m_cond.notify_all();
+		}
+	}
+	void DataLoader::copier_loop()
+	{
+		while (true)
+		{
+			std::unique_lock lock(m_mutex);
+			m_cond.wait(lock, [this]()
+			{	return (m_slots[m_next_to_copy % m_slots.size()].is_ready and not m_alternate_is_ready) or not m_is_running;});
+			if (not m_is_running)
+				return;
+			Slot &slot = m_slots[m_next_to_copy % m_slots.size()];
+			lock.unlock();
+
+			std::exception_ptr error = slot.error;
+			if (error == nullptr)
+			{
+				try
+				{ // the step that used alternate buffers was finished in next() before swapping them out of the graph
+					for (size_t i = 0; i < m_alternate.size(); i++)
+						m_alternate[i].copyFrom(slot.tensors[i]);
+				} catch (...)
+				{
+					error = std::current_exception();
+				}
+			}
+
+			lock.lock();
+			m_alternate_size = slot.size;
+			m_alternate_error = error;
+			m_alternate_is_ready = true;
+			slot.is_ready = false;
+			slot.error = nullptr;
+			m_next_to_copy++;
+			lock.unlock();
+			m_cond.notify_all();
+		}
+	}
+	const std::vector<size_t>& DataLoader::get_ordering(int64_t epoch)
+	{
+		// batches of older epochs have all been copied so their orderings are no longer needed
+		m_orderings.erase(m_orderings.begin(), m_orderings.lower_bound(m_next_to_copy / m_batches_per_epoch));
+
+		auto iter = m_orderings.find(epoch);
+		if (iter == m_orderings.end())
+		{
+			std::vector<size_t> ordering(m_dataset.size());
+			std::iota(ordering.begin(), ordering.end(), 0);
+			if (m_shuffle)
+			{
+				std::mt19937_64 generator(m_seed + epoch);
+				std::shuffle(ordering.begin(), ordering.end(), generator);
+			}
+			iter = m_orderings.insert( { epoch, std::move(ordering) }).first;
+		}
+		return iter->second;
+	}
+	void DataLoader::fill_slot(Slot &slot, int64_t batch, const std::vector<size_t> &ordering) const
+	{
+		const size_t first = (batch % m_batches_per_epoch) * m_batch_size;
+		slot.size = static_cast<int>(std::min(ordering.size() - first, static_cast<size_t>(m_batch_size)));
+
+		std::vector<Tensor> rows(slot.tensors.size());
+		for (int i = 0; i < slot.size; i++)
+		{
+			for (size_t j = 0; j < slot.tensors.size(); j++)
+			{
+				const Shape shape = row_shape(slot.tensors[j]);
+				rows[j] = slot.tensors[j].view(shape, shape.volume() * i);
+			}
+			m_dataset.load(ordering[first + i], rows);
+		}
+	}
+
+} /* namespace avocado */
@@ -0,0 +1,50 @@
+/*
+ * Dataset.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <Avocado/data/Dataset.hpp>
+#include <Avocado/core/error_handling.hpp>
+
+#include <cstring>
+
+namespace avocado
+{
+	TensorDataset::TensorDataset(const std::vector<Tensor> &tensors) :
+			m_tensors(tensors)
+	{
+		if (m_tensors.empty())
+			throw IllegalArgument(METHOD_NAME, "tensors", "must not be empty", 0);
+		for (size_t i = 0; i < m_tensors.size(); i++)
+		{
+			if (m_tensors[i].firstDim() != m_tensors[0].firstDim())
+				throw ShapeMismatch(METHOD_NAME, m_tensors[0].shape(), m_tensors[i].shape());
+			m_tensors[i].moveTo(Device::cpu());
+		}
+	}
+
+	size_t TensorDataset::size() const
+	{
+		return m_tensors[0].firstDim();
+	}
+	void TensorDataset::load(size_t index, std::vector<Tensor> &rows) const
+	{
+		if (rows.size() != m_tensors.size())
+			throw IllegalArgument(METHOD_NAME, "rows", "must contain " + std::to_string(m_tensors.size()) + " tensors",
+					static_cast<int>(rows.size()));
+		for (size_t i = 0; i < rows.size(); i++)
+		{
+			const size_t row_volume = m_tensors[i].volume() / m_tensors[i].firstDim();
+			if (static_cast<size_t>(rows[i].volume()) != row_volume)
+				throw ShapeMismatch(METHOD_NAME, m_tensors[i].shape(), rows[i].shape());
+			if (rows[i].dtype() != m_tensors[i].dtype())
+				throw DataTypeMismatch(METHOD_NAME, m_tensors[i].dtype(), rows[i].dtype());
+
+			const size_t row_bytes = sizeOf(rows[i].dtype()) * row_volume;
+			std::memcpy(rows[i].data(), reinterpret_cast<const uint8_t*>(m_tensors[i].data()) + index * row_bytes, row_bytes);
+		}
+	}
+
+} /* namespace avocado */
@@ -0,0 +1,240 @@
+/*
+ * RecordDataset.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <Avocado/data/RecordDataset.hpp>
+#include <Avocado/core/Tensor.hpp>
+#include <Avocado/core/error_handling.hpp>
+#include <Avocado/utils/json.hpp>
+
+#include <cstddef>
+#include <cstring>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace
+{
+	using namespace avocado;
+
+	const char magic[8] = { 'A', 'V', 'R', 'E', 'C', 'O', 'R', 'D' };
+	const uint32_t version = 1;
+	const size_t field_alignment = 64;
+	const size_t page_size = 4096;
+
+	struct FileHeader
+	{
+			char magic[8];
+			uint32_t version;
+			uint32_t reserved;
+			uint64_t number_of_records;
+			uint64_t description_length;
+	};
+	static_assert(sizeof(FileHeader) == 32, "record file header must be 32 bytes");
+
+	size_t round_up(size_t value, size_t alignment) noexcept
+	{
+		return (value + alignment - 1) / alignment * alignment;
+	}
+	/* sets offsets of the fields and returns size of the record */
+	size_t create_layout(std::vector<RecordField> &fields) noexcept
+	{
+		size_t result = 0;
+		for (size_t i = 0; i < fields.size(); i++)
+		{
+			fields[i].offset = result;
+			result = round_up(result + fields[i].sizeInBytes, field_alignment);
+		}
+		return result;
+	}
+	Json describe(const std::vector<RecordField> &fields, size_t recordSize)
+	{
+		Json result;
+		result["fields"] = Json(JsonType::Array);
+		for (size_t i = 0; i < fields.size(); i++)
+			result["fields"][i] = Json( { { "dtype", toString(fields[i].dtype) }, { "shape", fields[i].shape.toJson() } });
+		result["alignment"] = field_alignment;
+		result["record size"] = recordSize;
+		return result;
+	}
+}
+
+namespace avocado
+{
+	RecordField::RecordField(const Shape &shape, DataType dtype) :
+			shape(shape),
+			dtype(dtype),
+			sizeInBytes(sizeOf(dtype) * shape.volume())
+	{
+	}
+
+	RecordWriter::RecordWriter(const std::string &path, const std::vector<RecordField> &fields) :
+			m_stream(path, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc),
+			m_fields(fields)
+	{
+		if (m_fields.empty())
+			throw IllegalArgument(METHOD_NAME, "fields", "must not be empty", 0);
+		if (not m_stream.is_open())
+			throw RuntimeError(METHOD_NAME, "could not create file '" + path + "'");
+		for (size_t i = 0; i < m_fields.size(); i++)
+			m_fields[i] = RecordField(m_fields[i].shape, m_fields[i].dtype);
+		m_record_size = create_layout(m_fields);
+		m_buffer.assign(m_record_size, 0);
+
+		const std::string description = describe(m_fields, m_record_size).dump();
+		FileHeader header;
+		std::memcpy(header.magic, magic, sizeof(magic));
+		header.version = version;
+		header.reserved = 0;
+		header.number_of_records = 0; // updated in close()
+		header.description_length = description.size();
+
+		m_stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		m_stream.write(description.data(), description.size());
+		const std::vector<char> padding(round_up(sizeof(header) + description.size(), page_size) - sizeof(header) - description.size(), 0);
+		m_stream.write(padding.data(), padding.size());
+	}
+	RecordWriter::~RecordWriter()
+	{
+		try
+		{
+			close();
+		} catch (...)
+		{
+		}
+	}
+	void RecordWriter::write(const std::vector<Tensor> &sample)
+	{
+		if (not m_stream.is_open())
+			throw LogicError(METHOD_NAME, "writer has been closed");
+		if (sample.size() != m_fields.size())
+			throw IllegalArgument(METHOD_NAME, "sample", "must contain " + std::to_string(m_fields.size()) + " tensors",
+					static_cast<int>(sample.size()));
+		for (size_t i = 0; i < sample.size(); i++)
+		{
+			if (sample[i].volume() != m_fields[i].shape.volume())
+				throw ShapeMismatch(METHOD_NAME, m_fields[i].shape, sample[i].shape());
+			if (sample[i].dtype() != m_fields[i].dtype)
+				throw DataTypeMismatch(METHOD_NAME, m_fields[i].dtype, sample[i].dtype());
+			sample[i].copyToHost(m_buffer.data() + m_fields[i].offset, sample[i].volume());
+		}
+		m_stream.write(m_buffer.data(), m_buffer.size());
+		if (not m_stream.good())
+			throw RuntimeError(METHOD_NAME, "could not write record");
+		m_number_of_records++;
+	}
+	uint64_t RecordWriter::numberOfRecords() const noexcept
+	{
+		return m_number_of_records;
+	}
+	void RecordWriter::close()
+	{
+		if (not m_stream.is_open())
+			return;
+		m_stream.seekp(offsetof(FileHeader, number_of_records));
+		m_stream.write(reinterpret_cast<const char*>(&m_number_of_records), sizeof(m_number_of_records));
+		m_stream.close();
+		if (m_stream.fail())
+			throw RuntimeError(METHOD_NAME, "could not finalize record file");
+	}
+
+	RecordDataset::RecordDataset(const std::string &path, int shardIndex, int numberOfShards)
+	{
+		if (numberOfShards < 1)
+			throw IllegalArgument(METHOD_NAME, "numberOfShards", "must be positive", numberOfShards);
+		if (shardIndex < 0 || shardIndex >= numberOfShards)
+			throw IllegalArgument(METHOD_NAME, "shardIndex", "must be in range [0, " + std::to_string(numberOfShards) + ")", shardIndex);
+
+		const int fd = ::open(path.c_str(), O_RDONLY);
+		if (fd == -1)
+			throw RuntimeError(METHOD_NAME, "could not open file '" + path + "'");
+		struct stat info;
+		if (::fstat(fd, &info) == -1 or info.st_size < static_cast<off_t>(sizeof(FileHeader)))
+		{
+			::close(fd);
+			throw RuntimeError(METHOD_NAME, "'" + path + "' is not a record file");
+		}
+		m_file_size = info.st_size;
+		void *ptr = ::mmap(nullptr, m_file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		::close(fd); // the mapping keeps the file open
+		if (ptr == MAP_FAILED)
+			throw RuntimeError(METHOD_NAME, "could not map file '" + path + "'");
+		m_data = reinterpret_cast<const char*>(ptr);
+		::madvise(ptr, m_file_size, MADV_RANDOM); // samples are read in shuffled order so read-ahead would be wasted
+
+		try
+		{
+			FileHeader header;
+			std::memcpy(&header, m_data, sizeof(header));
+			if (std::memcmp(header.magic, magic, sizeof(magic)) != 0 or header.version != version)
+				throw RuntimeError(METHOD_NAME, "'" + path + "' is not a record file");
+			if (sizeof(header) + header.description_length > m_file_size)
+				throw RuntimeError(METHOD_NAME, "'" + path + "' is truncated");
+
+			const Json description = Json::load(std::string(m_data + sizeof(header), header.description_length));
+			for (int i = 0; i < description["fields"].size(); i++)
+			{
+				const Json &field = description["fields"][i];
+				m_fields.push_back(RecordField(Shape(field["shape"]), typeFromString(field["dtype"])));
+			}
+			m_record_size = create_layout(m_fields);
+			if (m_record_size != static_cast<size_t>(description["record size"]))
+				throw RuntimeError(METHOD_NAME, "'" + path + "' has inconsistent record size");
+
+			m_number_of_records = header.number_of_records;
+			m_data_offset = round_up(sizeof(header) + header.description_length, page_size);
+			if (m_data_offset + m_number_of_records * m_record_size > m_file_size)
+				throw RuntimeError(METHOD_NAME, "'" + path + "' is truncated");
+		} catch (...)
+		{
+			::munmap(const_cast<char*>(m_data), m_file_size);
+			throw;
+		}
+
+		m_first_record = m_number_of_records * shardIndex / numberOfShards;
+		m_shard_size = m_number_of_records * (shardIndex + 1) / numberOfShards - m_first_record;
+	}
+	RecordDataset::~RecordDataset()
+	{
+		::munmap(const_cast<char*>(m_data), m_file_size);
+	}
+
+	size_t RecordDataset::size() const
+	{
+		return m_shard_size;
+	}
+	uint64_t RecordDataset::numberOfRecords() const noexcept
+	{
+		return m_number_of_records;
+	}
+	const std::vector<RecordField>& RecordDataset::fields() const noexcept
+	{
+		return m_fields;
+	}
+	const void* RecordDataset::data(size_t index, int field) const
+	{
+		if (index >= m_shard_size)
+			throw IndexOutOfBounds(METHOD_NAME, "index", index, m_shard_size);
+		return m_data + m_data_offset + (m_first_record + index) * m_record_size + m_fields.at(field).offset;
+	}
+	void RecordDataset::load(size_t index, std::vector<Tensor> &rows) const
+	{
+		if (rows.size() != m_fields.size())
+			throw IllegalArgument(METHOD_NAME, "rows", "must contain " + std::to_string(m_fields.size()) + " tensors",
+					static_cast<int>(rows.size()));
+		for (size_t i = 0; i < rows.size(); i++)
+		{
+			if (rows[i].volume() != m_fields[i].shape.volume())
+				throw ShapeMismatch(METHOD_NAME, m_fields[i].shape, rows[i].shape());
+			if (rows[i].dtype() != m_fields[i].dtype)
+				throw DataTypeMismatch(METHOD_NAME, m_fields[i].dtype, rows[i].dtype());
+			std::memcpy(rows[i].data(), data(index, i), m_fields[i].sizeInBytes);
+		}
+	}
+
+} /* namespace avocado */
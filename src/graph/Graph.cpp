@@ -11,6 +11,8 @@
 #include <Avocado/core/Context.hpp>
 #include <Avocado/core/Scalar.hpp>
 #include <Avocado/layers/Input.hpp>
+#include <Avocado/math/tensor_operations.hpp>
+#include <Avocado/math/training.hpp>
 #include <Avocado/utils/json.hpp>
 
 #include <Avocado/inference/calibration.hpp>
@@ -47,6 +49,10 @@ namespace avocado
 			m_context(device)
 	{
 	}
+	Graph::Graph(Device device, const ThreadGroup &group) :
+			m_context(device, group)
+	{
+	}
 
 	Device Graph::device() const noexcept
 	{
@@ -127,7 +133,13 @@ namespace avocado
 	Tensor& Graph::getTarget(int index)
 	{
 		if (m_targets.at(index) == nullptr)
-			m_targets.at(index) = std::make_unique<Tensor>(getOutput(index).shape(), dtype(), device());
+		{
+			const LossFunction *loss = m_losses.at(index).get();
+			const Shape shape = (loss == nullptr) ? getOutput(index).shape() : loss->getTargetShape(getOutput(index).shape());
+			const DataType type = (loss == nullptr) ? dtype() : loss->getTargetType(dtype());
+			m_targets.at(index) = std::make_unique<Tensor>(shape, type, device());
+			m_targets.at(index)->setMemoryCategory(MemoryCategory::ACTIVATIONS);
+		}
 		return *(m_targets.at(index));
 	}
 
@@ -160,7 +172,9 @@ namespace avocado
 		if (newDevice == device())
 			return;
 
-		m_context = Context(newDevice);
+		const FastMathMode mode = m_context.fastMathMode();
+		m_context = Context(newDevice, m_context.threadGroup());
+		m_context.setFastMathMode(mode);
 		for (size_t i = 0; i < m_layers.size(); i++)
 			m_layers.at(i)->changeContext(m_context);
 		for (size_t i = 0; i < m_nodes.size(); i++)
@@ -170,6 +184,21 @@ namespace avocado
 		for (size_t i = 0; i < m_targets.size(); i++)
 			if (m_targets.at(i) != nullptr)
 				m_targets.at(i)->moveTo(newDevice);
+		for (size_t i = 0; i < m_loss_accumulators.size(); i++)
+			if (m_loss_accumulators.at(i) != nullptr)
+				m_loss_accumulators.at(i)->moveTo(newDevice);
+	}
+	void Graph::setThreadGroup(const ThreadGroup &group)
+	{
+		const FastMathMode mode = m_context.fastMathMode();
+		m_context = Context(device(), group); // layers keep pointer to m_context so they will see the new one
+		m_context.setFastMathMode(mode);
+		m_context.activate();
+		bind_parameters_to_local_node();
+	}
+	void Graph::setFastMathMode(FastMathMode mode) noexcept
+	{
+		m_context.setFastMathMode(mode);
 	}
 	void Graph::setInputShape(const Shape &shape)
 	{
@@ -185,6 +214,23 @@ namespace avocado
 		m_backup_tensor = nullptr;
 	}
 
+	void Graph::shareWeightsWith(const Graph &other)
+	{
+		if (this == &other)
+			return;
+		if (numberOfLayers() != other.numberOfLayers())
+			throw LogicError(METHOD_NAME, "graphs have different number of layers");
+		for (int i = 0; i < numberOfLayers(); i++)
+		{
+			if (getLayer(i).name() != other.getLayer(i).name())
+				throw LogicError(METHOD_NAME,
+						"layer " + std::to_string(i) + " is '" + getLayer(i).name() + "' but '" + other.getLayer(i).name() + "' in other graph");
+			if (getLayer(i).getWeightShape() != other.getLayer(i).getWeightShape())
+				throw ShapeMismatch(METHOD_NAME, getLayer(i).getWeightShape(), other.getLayer(i).getWeightShape());
+		}
+		for (int i = 0; i < numberOfLayers(); i++)
+			m_layers.at(i)->shareParametersWith(other.getLayer(i));
+	}
 	void Graph::setOptimizer(const Optimizer &optimizer)
 	{
 		if (not isTrainable())
@@ -199,20 +245,103 @@ namespace avocado
 		for (size_t i = 0; i < m_layers.size(); i++)
 			m_layers.at(i)->setRegularizer(regularizer);
 	}
+	void Graph::setLearningRateSchedule(const LearningRateSchedule &schedule)
+	{
+		m_learning_rate_schedule = std::unique_ptr<LearningRateSchedule>(schedule.clone());
+	}
+	void Graph::removeLearningRateSchedule() noexcept
+	{
+		m_learning_rate_schedule = nullptr;
+	}
+	bool Graph::hasLearningRateSchedule() const noexcept
+	{
+		return m_learning_rate_schedule != nullptr;
+	}
+	const LearningRateSchedule& Graph::getLearningRateSchedule() const
+	{
+		if (m_learning_rate_schedule == nullptr)
+			throw UninitializedObject(METHOD_NAME, "learning rate schedule has not been set");
+		return *m_learning_rate_schedule;
+	}
+	LearningRateSchedule& Graph::getLearningRateSchedule()
+	{
+		if (m_learning_rate_schedule == nullptr)
+			throw UninitializedObject(METHOD_NAME, "learning rate schedule has not been set");
+		return *m_learning_rate_schedule;
+	}
+	double Graph::getLearningRate() const
+	{
+		const double multiplier = hasLearningRateSchedule() ? m_learning_rate_schedule->getMultiplier(m_learning_rate_schedule->getStep()) : 1.0;
+		for (int i = 0; i < numberOfLayers(); i++)
+			if (getLayer(i).getWeights().isTrainable() and getLayer(i).getWeights().shape().volume() > 0)
+				return getLayer(i).getWeights().getOptimizer().getLearningRate() * multiplier;
+		return 0.0;
+	}
+	void Graph::setWeightAveraging(double decay)
+	{
+		if (not isTrainable())
+			throw LogicError(METHOD_NAME, "Graph is not trainable");
+		for (int i = 0; i < numberOfLayers(); i++)
+		{
+			if (m_layers.at(i)->getWeights().isTrainable())
+				m_layers.at(i)->getWeights().setAveraging(decay);
+			if (m_layers.at(i)->getBias().isTrainable())
+				m_layers.at(i)->getBias().setAveraging(decay);
+		}
+	}
+	void Graph::swapAveragedWeights()
+	{
+		for (int i = 0; i < numberOfLayers(); i++)
+		{
+			if (m_layers.at(i)->getWeights().hasAverage())
+				m_layers.at(i)->getWeights().swapAverage();
+			if (m_layers.at(i)->getBias().hasAverage())
+				m_layers.at(i)->getBias().swapAverage();
+		}
+	}
+	bool Graph::usesAveragedWeights() const noexcept
+	{
+		for (int i = 0; i < numberOfLayers(); i++)
+			if (m_layers.at(i)->getWeights().isAverageSwapped() or m_layers.at(i)->getBias().isAverageSwapped())
+				return true;
+		return false;
+	}
 	void Graph::init()
 	{
+		m_context.activate();
 		for (size_t i = 0; i < m_layers.size(); i++)
 			m_layers.at(i)->init();
+		bind_parameters_to_local_node();
 	}
 	void Graph::forward(int batchSize)
 	{
-		for (size_t i = 0; i < m_nodes.size(); i++)
-			m_nodes.at(i)->forward(batchSize);
+		m_context.activate();
+		MemoryTracker::PeakWatcher watcher(device());
+		MemoryCategoryScope scope(MemoryCategory::WORKSPACE);
+		if (m_profiler == nullptr)
+		{
+			for (size_t i = 0; i < m_nodes.size(); i++)
+				m_nodes.at(i)->forward(batchSize);
+		}
+		else
+		{
+			for (size_t i = 0; i < m_nodes.size(); i++)
+				if (not m_nodes.at(i)->isInputNode())
+				{
+					const Profiler::Measurement measurement = m_profiler->start();
+					m_nodes.at(i)->forward(batchSize);
+					m_profiler->recordNode(measurement, m_nodes.at(i)->getLayer().context(), *m_nodes.at(i), i, ProfilerPhase::FORWARD, batchSize);
+				}
+		}
+		record_peak_memory_usage(GraphPhase::FORWARD, watcher);
 	}
 	void Graph::backward(int batchSize)
 	{
 		if (not isTrainable())
 			throw LogicError(METHOD_NAME, "Graph is not trainable");
+		m_context.activate();
+		MemoryTracker::PeakWatcher watcher(device());
+		MemoryCategoryScope scope(MemoryCategory::WORKSPACE);
 		if (m_backup_tensor == nullptr)
 			create_backup_tensor();
 		for (size_t i = 0; i < m_nodes.size(); i++)
@@ -220,33 +349,40 @@ namespace avocado
 
 		for (size_t i = 0; i < m_targets.size(); i++)
 		{
-			Shape tmp(getTarget(i).shape());
+			Shape tmp(getOutputShape(i));
 			tmp[0] = batchSize;
+			Shape target_shape(getTarget(i).shape());
+			target_shape[0] = batchSize;
 			Tensor gradient = getGradient(i).view(tmp);
 			Tensor output = getOutput(i).view(tmp);
-			Tensor target = getTarget(i).view(tmp);
-			m_losses.at(i)->getGradient(context(), gradient, output, target);
-			for (int j = 0; j < 10; j++)
-				std::cout << gradient.get<float>( { 0, j }) << " ";
-			std::cout << '\n';
-
-			for (int j = 0; j < 10; j++)
-				std::cout << output.get<float>( { 0, j }) << " ";
-			std::cout << '\n';
-			for (int j = 0; j < 10; j++)
-				std::cout << output.get<float>( { 1, j }) << " ";
-			std::cout << std::endl;
-
-			for (int j = 0; j < 10; j++)
-				std::cout << target.get<float>( { 0, j }) << " ";
-			std::cout << '\n';
-			for (int j = 0; j < 10; j++)
-				std::cout << target.get<float>( { 1, j }) << " ";
-			std::cout << std::endl << std::endl;
+			Tensor target = getTarget(i).view(target_shape);
+			Tensor &accumulator = get_loss_accumulator(i);
+			if (m_losses.at(i)->isFusedWithLayer())
+			{ // output layer is bypassed during backward so the gradient with respect to its input is stored in place of its gradient
+				Tensor input = m_output_nodes.at(i)->getInputNode(0)->getOutputTensor().view(tmp);
+				m_losses.at(i)->getFusedLossAndGradient(context(), gradient, input, output, target, accumulator);
+			}
+			else
+				m_losses.at(i)->getGradientAndAccumulateLoss(context(), gradient, output, target, accumulator);
 		}
+		m_accumulated_steps++;
 
-		for (int i = static_cast<int>(m_nodes.size()) - 1; i >= 0; i--)
-			m_nodes.at(i)->backward(batchSize, *m_backup_tensor);
+		if (m_profiler == nullptr)
+		{
+			for (int i = static_cast<int>(m_nodes.size()) - 1; i >= 0; i--)
+				m_nodes.at(i)->backward(batchSize, *m_backup_tensor);
+		}
+		else
+		{
+			for (int i = static_cast<int>(m_nodes.size()) - 1; i >= 0; i--)
+				if (not m_nodes.at(i)->isInputNode())
+				{
+					const Profiler::Measurement measurement = m_profiler->start();
+					m_nodes.at(i)->backward(batchSize, *m_backup_tensor);
+					m_profiler->recordNode(measurement, m_nodes.at(i)->getLayer().context(), *m_nodes.at(i), i, ProfilerPhase::BACKWARD, batchSize);
+				}
+		}
+		record_peak_memory_usage(GraphPhase::BACKWARD, watcher);
 	}
 	std::vector<Scalar> Graph::getLoss(int batchSize)
 	{
@@ -256,21 +392,128 @@ namespace avocado
 		std::vector<Scalar> result(numberOfOutputs());
 		for (size_t i = 0; i < m_targets.size(); i++)
 		{
-			Shape tmp(getTarget(i).shape());
+			Shape tmp(getOutputShape(i));
 			tmp[0] = batchSize;
+			Shape target_shape(getTarget(i).shape());
+			target_shape[0] = batchSize;
 			Tensor output = getOutput(i).view(tmp);
-			Tensor target = getTarget(i).view(tmp);
+			Tensor target = getTarget(i).view(target_shape);
 			result.at(i) = m_losses.at(i)->getLoss(context(), output, target);
 		}
 		return result;
 	}
-	void Graph::learn()
+	std::vector<Scalar> Graph::getAccumulatedLoss() const
+	{
+		std::vector<Scalar> result(numberOfOutputs());
+		const double scale = (m_accumulated_steps == 0) ? 0.0 : 1.0 / m_accumulated_steps;
+		m_context.synchronize();
+		for (size_t i = 0; i < m_loss_accumulators.size(); i++)
+			if (m_loss_accumulators.at(i) != nullptr)
+			{
+				if (dtype() == DataType::FLOAT64)
+					result.at(i) = scale * m_loss_accumulators.at(i)->get<double>( { 0 });
+				else
+					result.at(i) = scale * m_loss_accumulators.at(i)->get<float>( { 0 });
+			}
+		return result;
+	}
+	int Graph::numberOfAccumulatedSteps() const noexcept
+	{
+		return m_accumulated_steps;
+	}
+	void Graph::resetAccumulatedLoss()
+	{
+		for (size_t i = 0; i < m_loss_accumulators.size(); i++)
+			if (m_loss_accumulators.at(i) != nullptr)
+				m_loss_accumulators.at(i)->zeroall();
+		m_accumulated_steps = 0;
+	}
+	double Graph::clipGradients(double maxNorm)
 	{
 		if (not isTrainable())
 			throw LogicError(METHOD_NAME, "Graph is not trainable");
+		if (maxNorm <= 0.0)
+			throw IllegalArgument(METHOD_NAME, "maxNorm must be positive");
 
+		std::vector<Parameter*> params;
 		for (int i = 0; i < numberOfLayers(); i++)
-			m_layers.at(i)->learn();
+		{
+			Parameter *tmp[2] = { &(m_layers.at(i)->getWeights()), &(m_layers.at(i)->getBias()) };
+			for (int j = 0; j < 2; j++)
+				if (tmp[j]->isTrainable() and tmp[j]->shape().volume() > 0)
+					params.push_back(tmp[j]);
+		}
+		std::vector<Tensor*> updates;
+		for (size_t i = 0; i < params.size(); i++)
+			updates.push_back(&(params[i]->getUpdate()));
+
+		m_context.activate();
+		const double norm = math::globalNorm2(m_context, updates);
+		const double scale = (norm > maxNorm) ? maxNorm / norm : 1.0;
+		for (size_t i = 0; i < params.size(); i++)
+			params[i]->setGradientScale(scale);
+		return norm;
+	}
+	void Graph::learn()
+	{
+		if (not isTrainable())
+			throw LogicError(METHOD_NAME, "Graph is not trainable");
+		if (usesAveragedWeights())
+			throw LogicError(METHOD_NAME, "averaged weights must be swapped out before learning");
+
+		const double multiplier = hasLearningRateSchedule() ? m_learning_rate_schedule->next() : 1.0;
+		m_context.activate();
+		MemoryTracker::PeakWatcher watcher(device());
+		MemoryCategoryScope scope(MemoryCategory::WORKSPACE);
+		if (m_profiler == nullptr)
+		{
+			for (int i = 0; i < numberOfLayers(); i++)
+				m_layers.at(i)->learn(multiplier);
+		}
+		else
+		{
+			for (int i = 0; i < numberOfLayers(); i++)
+			{
+				const Profiler::Measurement measurement = m_profiler->start();
+				m_layers.at(i)->learn(multiplier);
+				m_profiler->recordLearn(measurement, m_layers.at(i)->context(), *m_layers.at(i), i);
+			}
+			m_profiler->nextStep();
+		}
+		record_peak_memory_usage(GraphPhase::LEARN, watcher);
+	}
+
+	void Graph::setProfiling(bool enabled)
+	{
+		if (enabled and m_profiler == nullptr)
+			m_profiler = std::make_unique<Profiler>();
+		if (not enabled)
+			m_profiler = nullptr;
+	}
+	bool Graph::isProfiling() const noexcept
+	{
+		return m_profiler != nullptr;
+	}
+	const Profiler& Graph::getProfiler() const
+	{
+		if (m_profiler == nullptr)
+			throw LogicError(METHOD_NAME, "profiling is not enabled");
+		return *m_profiler;
+	}
+	Profiler& Graph::getProfiler()
+	{
+		if (m_profiler == nullptr)
+			throw LogicError(METHOD_NAME, "profiling is not enabled");
+		return *m_profiler;
+	}
+
+	MemoryUsage Graph::getPeakMemoryUsage(GraphPhase phase) const
+	{
+		return m_peak_memory_usage.at(static_cast<int>(phase));
+	}
+	void Graph::resetPeakMemoryUsage()
+	{
+		m_peak_memory_usage.fill(MemoryUsage());
 	}
 
 	void Graph::print() const
@@ -350,6 +593,14 @@ namespace avocado
 	{
 		return index_of_node(node);
 	}
+	GraphNodeID Graph::getInputNodeID(int index) const
+	{
+		return index_of_node(m_input_nodes.at(index));
+	}
+	GraphNodeID Graph::getOutputNodeID(int index) const
+	{
+		return index_of_node(m_output_nodes.at(index));
+	}
 
 	void Graph::clear()
 	{
@@ -358,16 +609,20 @@ namespace avocado
 		m_nodes.clear();
 		m_losses.clear();
 		m_targets.clear();
+		m_loss_accumulators.clear();
+		m_accumulated_steps = 0;
 
 		m_input_nodes.clear();
 		m_output_nodes.clear();
 
 		m_backup_tensor.reset();
+		m_learning_rate_schedule.reset();
 
 		m_datatype = DataType::FLOAT32;
 	}
 	Json Graph::save(SerializedObject &binary_data) const
 	{
+		MemoryTracker::PeakWatcher watcher(device());
 		Json result;
 		result["losses"] = Json(JsonType::Array);
 		for (size_t i = 0; i < m_losses.size(); i++)
@@ -384,6 +639,8 @@ namespace avocado
 		result["nodes"] = Json(JsonType::Array);
 		for (int i = 0; i < static_cast<int>(m_nodes.size()); i++)
 			result["nodes"][i] = save_node(m_nodes[i].get());
+		result["learning rate schedule"] = hasLearningRateSchedule() ? m_learning_rate_schedule->serialize(binary_data) : Json();
+		record_peak_memory_usage(GraphPhase::SAVE, watcher);
 		return result;
 	}
 	void Graph::load(const Json &json, const SerializedObject &binary_data)
@@ -406,9 +663,14 @@ namespace avocado
 		const Json &nodes = json["nodes"];
 		for (int i = 0; i < nodes.size(); i++)
 			load_node(nodes[i]);
+		for (size_t i = 0; i < m_losses.size() and i < m_output_nodes.size(); i++) // same as in addOutput()
+			if (m_losses[i] != nullptr and m_losses[i]->tryCombineWith(m_output_nodes[i]->getLayer()))
+				m_output_nodes[i]->bypassDuringBackward();
 
 		for (int i = 0; i < numberOfLayers(); i++)
 			getLayer(i).loadParameters(layers[i], binary_data);
+		if (json.hasKey("learning rate schedule") and not json["learning rate schedule"].isNull())
+			m_learning_rate_schedule = loadLearningRateSchedule(json["learning rate schedule"], binary_data);
 	}
 
 	GraphNodeID Graph::add_node(const Layer &layer, const std::vector<GraphNodeID> &inputs)
@@ -502,6 +764,39 @@ namespace avocado
 		for (size_t i = 0; i < m_nodes.size(); i++)
 			tmp = std::max(tmp, m_nodes[i]->getBackupStorage());
 		m_backup_tensor = std::make_unique<Tensor>(Shape( { tmp }), dtype(), device());
+		m_backup_tensor->setMemoryCategory(MemoryCategory::BACKUP);
+	}
+	Tensor& Graph::get_loss_accumulator(int index)
+	{
+		if (m_loss_accumulators.size() < m_losses.size())
+			m_loss_accumulators.resize(m_losses.size());
+		if (m_loss_accumulators.at(index) == nullptr)
+		{
+			m_loss_accumulators.at(index) = std::make_unique<Tensor>(Shape( { 1 }), dtype(), device());
+			m_loss_accumulators.at(index)->setMemoryCategory(MemoryCategory::OTHER);
+			m_loss_accumulators.at(index)->zeroall();
+		}
+		return *(m_loss_accumulators.at(index));
+	}
+	void Graph::record_peak_memory_usage(GraphPhase phase, const MemoryTracker::PeakWatcher &watcher) const
+	{
+		const MemoryUsage usage = watcher.getPeak();
+		MemoryUsage &peak = m_peak_memory_usage.at(static_cast<int>(phase));
+		for (int i = 0; i < number_of_memory_categories; i++)
+			peak.bytes[i] = std::max(peak.bytes[i], usage.bytes[i]);
+		peak.total = std::max(peak.total, usage.total);
+	}
+	void Graph::bind_parameters_to_local_node()
+	{
+		if (not device().isCPU() or m_context.threadGroup().numaNode() == -1)
+			return;
+		for (int i = 0; i < numberOfLayers(); i++)
+		{
+			const Tensor &weights = getLayer(i).getWeights().getParam();
+			m_context.bindToLocalNode(weights.data(), weights.sizeInBytes());
+			const Tensor &bias = getLayer(i).getBias().getParam();
+			m_context.bindToLocalNode(bias.data(), bias.sizeInBytes());
+		}
 	}
 
 	Json Graph::save_node(const GraphNode *node) const
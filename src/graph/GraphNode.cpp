@@ -11,6 +11,8 @@
 #include <Avocado/core/error_handling.hpp>
 #include <Avocado/core/Scalar.hpp>
 
+#include <cassert>
+
 namespace
 {
 	template<typename T>
@@ -36,11 +38,11 @@ namespace
 		removeByIndex(vec, tmp);
 	}
 
-	avocado::Tensor change_batch(int batch_size, avocado::Tensor &other)
+	avocado::Tensor change_batch(int batch_size, avocado::Tensor &other, int first_sample = 0)
 	{
 		avocado::Shape tmp(other.shape());
 		tmp[0] = batch_size;
-		return other.view(tmp);
+		return other.view(tmp, static_cast<size_t>(first_sample) * tmp.volumeWithoutFirstDim());
 	}
 }
 
@@ -133,29 +135,46 @@ namespace avocado
 	}
 
 	void GraphNode::forward(int batchSize)
+	{
+		forward(batchSize, 0);
+	}
+	void GraphNode::backward(int batchSize, Tensor &backup_tensor)
+	{
+		if (isInputNode())
+			return;
+
+		std::vector<bool> accumulate(numberOfInputs());
+		for (int i = 0; i < numberOfInputs(); i++)
+			accumulate[i] = getInputNode(i)->m_done_backward;
+		backward(batchSize, 0, backup_tensor, accumulate);
+		for (int i = 0; i < numberOfInputs(); i++)
+			getInputNode(i)->m_done_backward = true;
+	}
+	void GraphNode::forward(int batchSize, int firstSample)
 	{
 		if (this->isInputNode())
 			return;
 
 		std::vector<Tensor> input(numberOfInputs());
 		for (int i = 0; i < numberOfInputs(); i++)
-			input[i] = change_batch(batchSize, getInputNode(i)->getOutputTensor());
-		Tensor output = change_batch(batchSize, this->getOutputTensor());
+			input[i] = change_batch(batchSize, getInputNode(i)->getOutputTensor(), firstSample);
+		Tensor output = change_batch(batchSize, this->getOutputTensor(), firstSample);
 
 		getLayer().forward(input, output, 1, 0);
 	}
-	void GraphNode::backward(int batchSize, Tensor &backup_tensor)
+	void GraphNode::backward(int batchSize, int firstSample, Tensor &backup_tensor, const std::vector<bool> &accumulate)
 	{
 		if (isInputNode())
 			return;
+		assert(static_cast<int>(accumulate.size()) == numberOfInputs());
 
 		std::vector<Tensor> input(numberOfInputs());
 		std::vector<Tensor> gradient_prev(numberOfInputs());
 		size_t offset = 0;
 		for (int i = 0; i < numberOfInputs(); i++)
 		{
-			input[i] = change_batch(batchSize, getInputNode(i)->getOutputTensor());
-			if (getInputNode(i)->m_done_backward == true) // gradient is propagated into temporary tensor and later added with the proper one
+			input[i] = change_batch(batchSize, getInputNode(i)->getOutputTensor(), firstSample);
+			if (accumulate[i]) // gradient is propagated into temporary tensor and later added with the proper one
 			{
 				Shape tmp_shape(getInputNode(i)->getOutputShape());
 				tmp_shape[0] = batchSize;
@@ -163,10 +182,10 @@ namespace avocado
 				offset += gradient_prev[i].volume();
 			}
 			else
-				gradient_prev[i] = change_batch(batchSize, getInputNode(i)->getGradientTensor());
+				gradient_prev[i] = change_batch(batchSize, getInputNode(i)->getGradientTensor(), firstSample);
 		}
-		Tensor output = change_batch(batchSize, this->getOutputTensor());
-		Tensor gradient_next = change_batch(batchSize, this->getGradientTensor());
+		Tensor output = change_batch(batchSize, this->getOutputTensor(), firstSample);
+		Tensor gradient_next = change_batch(batchSize, this->getGradientTensor(), firstSample);
 
 		if (m_is_bypassed_during_backward)
 			math::copyTensor(m_layer->context(), gradient_prev[0], gradient_next);
@@ -174,15 +193,11 @@ namespace avocado
 			m_layer->backward(input, output, gradient_prev, gradient_next, 1, 0);
 
 		for (int i = 0; i < numberOfInputs(); i++)
-		{
-			if (getInputNode(i)->m_done_backward == true) // here the temporary gradient tensor is added to the appropriate tensor
+			if (accumulate[i]) // here the temporary gradient tensor is added to the appropriate tensor
 			{
-				Tensor tmp = getInputNode(i)->getGradientTensor().view(gradient_prev[i].shape());
-				math::addTensors(m_layer->context(), gradient_prev[i], tmp, 1, 1);
+				Tensor tmp = change_batch(batchSize, getInputNode(i)->getGradientTensor(), firstSample);
+				math::addTensors(m_layer->context(), tmp, gradient_prev[i], 1, 1);
 			}
-			else
-				getInputNode(i)->m_done_backward = true;
-		}
 	}
 	void GraphNode::prepareForBackward()
 	{
@@ -211,7 +226,10 @@ namespace avocado
 	Tensor& GraphNode::getOutputTensor()
 	{
 		if (m_output_tensor == nullptr)
+		{
 			m_output_tensor = std::make_unique<Tensor>(getOutputShape(), getLayer().dtype(), getLayer().device());
+			m_output_tensor->setMemoryCategory(MemoryCategory::ACTIVATIONS);
+		}
 		return *m_output_tensor;
 	}
 	const Tensor& GraphNode::getGradientTensor() const
@@ -223,7 +241,10 @@ namespace avocado
 	Tensor& GraphNode::getGradientTensor()
 	{
 		if (m_gradient_tensor == nullptr)
+		{
 			m_gradient_tensor = std::make_unique<Tensor>(getOutputShape(), getLayer().dtype(), getLayer().device());
+			m_gradient_tensor->setMemoryCategory(MemoryCategory::GRADIENTS);
+		}
 		return *m_gradient_tensor;
 	}
 
@@ -240,7 +261,7 @@ namespace avocado
 	}
 	void GraphNode::bypassDuringBackward() noexcept
 	{
-		m_is_bypassed_during_backward = false;
+		m_is_bypassed_during_backward = true;
 	}
 
 	void GraphNode::link(GraphNode *prev, GraphNode *next)
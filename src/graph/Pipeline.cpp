@@ -0,0 +1,456 @@
+/*
+ * Pipeline.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <Avocado/graph/Pipeline.hpp>
+#include <Avocado/graph/Graph.hpp>
+#include <Avocado/graph/GraphNode.hpp>
+#include <Avocado/core/Tensor.hpp>
+#include <Avocado/core/Scalar.hpp>
+#include <Avocado/core/error_handling.hpp>
+#include <Avocado/math/tensor_operations.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <unordered_map>
+
+namespace
+{
+	/* thrown inside worker when other stage has failed and the queues were closed */
+	struct PipelineAborted
+	{
+	};
+}
+
+namespace avocado
+{
+	Pipeline::TokenQueue::TokenQueue(size_t capacity) :
+			m_capacity(std::max(static_cast<size_t>(1), capacity))
+	{
+	}
+	bool Pipeline::TokenQueue::push(int token)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_cond.wait(lock, [this]()
+		{	return m_is_closed or m_tokens.size() < m_capacity;});
+		if (m_is_closed)
+			return false;
+		m_tokens.push_back(token);
+		lock.unlock();
+		m_cond.notify_all();
+		return true;
+	}
+	bool Pipeline::TokenQueue::pop(int &token)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_cond.wait(lock, [this]()
+		{	return m_is_closed or not m_tokens.empty();});
+		if (m_is_closed)
+			return false;
+		token = m_tokens.front();
+		m_tokens.pop_front();
+		lock.unlock();
+		m_cond.notify_all();
+		return true;
+	}
+	void Pipeline::TokenQueue::close()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_is_closed = true;
+		m_cond.notify_all();
+	}
+	void Pipeline::TokenQueue::reset()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_is_closed = false;
+		m_tokens.clear();
+	}
+
+	Pipeline::Pipeline(Graph &graph, const std::vector<int> &firstNodeOfStage, int numberOfMicroBatches, PipelineSchedule schedule,
+			const std::vector<ThreadGroup> &groups) :
+			m_graph(graph),
+			m_micro_batches(numberOfMicroBatches),
+			m_schedule(schedule)
+	{
+		const int number_of_stages = firstNodeOfStage.size();
+		if (number_of_stages == 0)
+			throw IllegalArgument(METHOD_NAME, "pipeline must have at least one stage");
+		if (numberOfMicroBatches <= 0)
+			throw IllegalArgument(METHOD_NAME, "numberOfMicroBatches", "must be positive", numberOfMicroBatches);
+		if (firstNodeOfStage.front() != 0)
+			throw IllegalArgument(METHOD_NAME, "first stage must start at node 0");
+		for (int i = 1; i < number_of_stages; i++)
+			if (firstNodeOfStage[i] <= firstNodeOfStage[i - 1] or firstNodeOfStage[i] >= graph.numberOfNodes())
+				throw IllegalArgument(METHOD_NAME, "stages must be non-empty and ordered");
+		if (not groups.empty() and static_cast<int>(groups.size()) != number_of_stages)
+			throw IllegalArgument(METHOD_NAME, "number of thread groups must be equal to the number of stages");
+
+		const std::vector<ThreadGroup> thread_groups = groups.empty() ? ThreadGroup::partition(number_of_stages) : groups;
+		std::unordered_map<const Layer*, int> stage_of_layer;
+		for (int s = 0; s < number_of_stages; s++)
+		{
+			m_stages.push_back(std::make_unique<Stage>());
+			Stage &stage = *m_stages.back();
+			stage.firstNode = firstNodeOfStage[s];
+			stage.lastNode = (s + 1 < number_of_stages) ? firstNodeOfStage[s + 1] : graph.numberOfNodes();
+			stage.context = std::make_unique<Context>(graph.device(), thread_groups.at(s));
+			stage.context->setFastMathMode(graph.context().fastMathMode());
+			for (int i = stage.firstNode; i < stage.lastNode; i++)
+			{
+				const Layer *layer = &(graph.getNode(i).getLayer());
+				auto tmp = stage_of_layer.find(layer);
+				if (tmp != stage_of_layer.end() and tmp->second != s)
+					throw LogicError(METHOD_NAME, "layer '" + layer->name() + "' is shared between stages " + std::to_string(tmp->second) + " and "
+							+ std::to_string(s));
+				stage_of_layer[layer] = s;
+			}
+		}
+		for (size_t i = 0; i < graph.m_output_nodes.size(); i++)
+			if (graph.m_losses.at(i) != nullptr and graph.getNodeID(graph.m_output_nodes[i]) < m_stages.back()->firstNode)
+				throw LogicError(METHOD_NAME, "output " + std::to_string(i) + " with a loss function must be in the last stage");
+
+		/* Gradients are propagated in reverse node order, so the first consumer of each node can overwrite its gradient
+		 * while the following ones add to it. Because micro-batches use disjoint rows, this order is the same for all of them. */
+		std::vector<bool> has_gradient(graph.numberOfNodes(), false);
+		for (int s = number_of_stages - 1; s >= 0; s--)
+		{
+			Stage &stage = *m_stages[s];
+			stage.accumulate.resize(stage.lastNode - stage.firstNode);
+			int backup_size = 1;
+			for (int i = stage.lastNode - 1; i >= stage.firstNode; i--)
+			{
+				GraphNode &node = graph.getNode(i);
+				std::vector<bool> &flags = stage.accumulate[i - stage.firstNode];
+				flags.resize(node.numberOfInputs());
+				int tmp = 0;
+				for (int j = 0; j < node.numberOfInputs(); j++)
+				{
+					const int input_id = graph.getNodeID(node.getInputNode(j));
+					flags[j] = has_gradient[input_id];
+					has_gradient[input_id] = true;
+					if (flags[j])
+						tmp += node.getInputNode(j)->getOutputShape().volume();
+				}
+				backup_size = std::max(backup_size, tmp);
+			}
+			stage.backupTensor = std::make_unique<Tensor>(Shape( { backup_size }), graph.dtype(), graph.device());
+			stage.backupTensor->setMemoryCategory(MemoryCategory::BACKUP);
+		}
+
+		for (int s = 0; s + 1 < number_of_stages; s++)
+		{
+			m_forward_queues.push_back(std::make_unique<TokenQueue>(number_of_stages));
+			m_backward_queues.push_back(std::make_unique<TokenQueue>(number_of_stages));
+		}
+
+		for (int s = 0; s < number_of_stages; s++)
+		{
+			Stage &stage = *m_stages[s];
+			for (int i = stage.firstNode; i < stage.lastNode; i++)
+				graph.getNode(i).getLayer().changeContext(*stage.context);
+		}
+		for (int s = 0; s < number_of_stages; s++)
+			m_stages[s]->worker = std::thread([this, s]()
+			{
+				this->worker_loop(s);
+			});
+	}
+	Pipeline::Pipeline(Graph &graph, int numberOfStages, int numberOfMicroBatches, PipelineSchedule schedule) :
+			Pipeline(graph, balance(graph, numberOfStages), numberOfMicroBatches, schedule)
+	{
+	}
+	Pipeline::~Pipeline()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_task_mutex);
+			m_task = Task::EXIT;
+			m_generation++;
+		}
+		m_task_cond.notify_all();
+		close_queues();
+		for (size_t s = 0; s < m_stages.size(); s++)
+			if (m_stages[s]->worker.joinable())
+				m_stages[s]->worker.join();
+
+		for (int i = 0; i < m_graph.numberOfNodes(); i++)
+			m_graph.getNode(i).getLayer().changeContext(m_graph.m_context);
+	}
+
+	int Pipeline::numberOfStages() const noexcept
+	{
+		return static_cast<int>(m_stages.size());
+	}
+	int Pipeline::numberOfMicroBatches() const noexcept
+	{
+		return m_micro_batches;
+	}
+	PipelineSchedule Pipeline::schedule() const noexcept
+	{
+		return m_schedule;
+	}
+	int Pipeline::firstNodeOfStage(int stage) const
+	{
+		if (stage < 0 or stage >= numberOfStages())
+			throw IndexOutOfBounds(METHOD_NAME, "stage", stage, numberOfStages());
+		return m_stages[stage]->firstNode;
+	}
+	const Context& Pipeline::getContext(int stage) const
+	{
+		if (stage < 0 or stage >= numberOfStages())
+			throw IndexOutOfBounds(METHOD_NAME, "stage", stage, numberOfStages());
+		return *(m_stages[stage]->context);
+	}
+
+	void Pipeline::forward(int batchSize)
+	{
+		launch(Task::FORWARD, batchSize);
+	}
+	void Pipeline::train(int batchSize)
+	{
+		if (not m_graph.isTrainable())
+			throw LogicError(METHOD_NAME, "Graph is not trainable");
+		for (size_t i = 0; i < m_graph.m_output_nodes.size(); i++)
+		{
+			if (m_graph.m_losses.at(i) == nullptr) // such outputs do not receive any gradient
+				m_graph.m_output_nodes[i]->getGradientTensor().zeroall();
+			else
+				m_graph.get_loss_accumulator(i); // created here rather than by the last stage
+		}
+		if (m_micro_batch_loss == nullptr)
+		{
+			m_micro_batch_loss = std::make_unique<Tensor>(Shape( { 1 }), m_graph.dtype(), m_graph.device());
+			m_micro_batch_loss->setMemoryCategory(MemoryCategory::OTHER);
+		}
+		launch(Task::TRAIN, batchSize);
+		m_graph.m_accumulated_steps++; // once per batch, as in Graph::backward()
+	}
+
+	std::vector<int> Pipeline::balance(const Graph &graph, int numberOfStages)
+	{
+		if (numberOfStages <= 0 or numberOfStages > graph.numberOfNodes())
+			throw IllegalArgument(METHOD_NAME, "numberOfStages", "must be in range [1, number of nodes]", numberOfStages);
+
+		std::vector<double> cost(graph.numberOfNodes());
+		double total_cost = 0.0;
+		for (int i = 0; i < graph.numberOfNodes(); i++)
+		{
+			const GraphNode &node = graph.getNode(i);
+			cost[i] = node.isInputNode() ? 0.0 : (node.getLayer().getWeightShape().volume() + node.getOutputShape().volumeWithoutFirstDim());
+			total_cost += cost[i];
+		}
+
+		std::vector<int> result = { 0 };
+		double cumulative_cost = 0.0;
+		for (int i = 0; i < graph.numberOfNodes(); i++)
+		{
+			const int stage = static_cast<int>(result.size());
+			const int nodes_left = graph.numberOfNodes() - i;
+			const int stages_left = numberOfStages - stage;
+			if (stages_left == 0)
+				break;
+			const bool is_over_budget = cumulative_cost >= total_cost * stage / numberOfStages;
+			if (i > result.back() and (is_over_budget or nodes_left == stages_left))
+				result.push_back(i);
+			cumulative_cost += cost[i];
+		}
+		return result;
+	}
+
+	void Pipeline::launch(Task task, int batchSize)
+	{
+		if (batchSize <= 0 or batchSize > m_graph.maxBatchSize())
+			throw IllegalArgument(METHOD_NAME, "batchSize", "must be in range [1, max batch size]", batchSize);
+
+		const int micro_batches = std::min(m_micro_batches, batchSize);
+		m_ranges.clear();
+		for (int i = 0, first = 0; i < micro_batches; i++)
+		{
+			const int size = batchSize / micro_batches + static_cast<int>(i < batchSize % micro_batches);
+			m_ranges.push_back( { first, size });
+			first += size;
+		}
+		for (size_t i = 0; i < m_forward_queues.size(); i++)
+		{
+			m_forward_queues[i]->reset();
+			m_backward_queues[i]->reset();
+		}
+		for (size_t s = 0; s < m_stages.size(); s++)
+			m_stages[s]->error = nullptr;
+
+		std::unique_lock<std::mutex> lock(m_task_mutex);
+		m_task = task;
+		m_batch_size = batchSize;
+		m_finished_stages = 0;
+		m_generation++;
+		m_task_cond.notify_all();
+		m_finished_cond.wait(lock, [this]()
+		{	return m_finished_stages == numberOfStages();});
+		m_task = Task::NONE;
+		lock.unlock();
+
+		for (size_t s = 0; s < m_stages.size(); s++)
+			if (m_stages[s]->error != nullptr)
+				std::rethrow_exception(m_stages[s]->error);
+	}
+	void Pipeline::worker_loop(int stage)
+	{
+		Stage &this_stage = *m_stages[stage];
+		this_stage.context->activate();
+
+		uint64_t generation = 0;
+		while (true)
+		{
+			Task task;
+			{
+				std::unique_lock<std::mutex> lock(m_task_mutex);
+				m_task_cond.wait(lock, [this, generation]()
+				{	return m_generation != generation;});
+				generation = m_generation;
+				task = m_task;
+			}
+			if (task == Task::EXIT)
+				return;
+
+			try
+			{
+				const int micro_batches = static_cast<int>(m_ranges.size());
+				if (task == Task::FORWARD)
+				{
+					for (int i = 0; i < micro_batches; i++)
+						run_forward(stage, i);
+				}
+				if (task == Task::TRAIN)
+				{
+					switch (m_schedule)
+					{
+						case PipelineSchedule::GPIPE:
+							for (int i = 0; i < micro_batches; i++)
+								run_forward(stage, i);
+							for (int i = 0; i < micro_batches; i++)
+								run_backward(stage, i);
+							break;
+						case PipelineSchedule::ONE_F_ONE_B:
+						{
+							const int warmup = std::min(numberOfStages() - stage - 1, micro_batches);
+							for (int i = 0; i < warmup; i++)
+								run_forward(stage, i);
+							for (int i = 0; i < micro_batches; i++)
+							{
+								if (warmup + i < micro_batches)
+									run_forward(stage, warmup + i);
+								run_backward(stage, i);
+							}
+							break;
+						}
+					}
+				}
+				this_stage.context->synchronize();
+			} catch (PipelineAborted &e)
+			{
+			} catch (...)
+			{
+				this_stage.error = std::current_exception();
+				close_queues();
+			}
+
+			{
+				std::lock_guard<std::mutex> lock(m_task_mutex);
+				m_finished_stages++;
+			}
+			m_finished_cond.notify_all();
+		}
+	}
+	void Pipeline::run_forward(int stage, int microBatch)
+	{
+		Stage &this_stage = *m_stages[stage];
+		if (stage > 0)
+			receive(*m_forward_queues[stage - 1], microBatch);
+
+		const std::pair<int, int> range = m_ranges[microBatch];
+		for (int i = this_stage.firstNode; i < this_stage.lastNode; i++)
+			m_graph.getNode(i).forward(range.second, range.first);
+
+		if (stage + 1 < numberOfStages())
+		{
+			this_stage.context->synchronize();
+			if (not m_forward_queues[stage]->push(microBatch))
+				throw PipelineAborted();
+		}
+	}
+	void Pipeline::run_backward(int stage, int microBatch)
+	{
+		Stage &this_stage = *m_stages[stage];
+		if (stage + 1 < numberOfStages())
+			receive(*m_backward_queues[stage], microBatch);
+		else
+			calculate_loss_gradient(stage, microBatch);
+
+		const std::pair<int, int> range = m_ranges[microBatch];
+		for (int i = this_stage.lastNode - 1; i >= this_stage.firstNode; i--)
+			m_graph.getNode(i).backward(range.second, range.first, *this_stage.backupTensor, this_stage.accumulate[i - this_stage.firstNode]);
+
+		if (stage > 0)
+		{
+			this_stage.context->synchronize();
+			if (not m_backward_queues[stage - 1]->push(microBatch))
+				throw PipelineAborted();
+		}
+	}
+	void Pipeline::calculate_loss_gradient(int stage, int microBatch)
+	{
+		const Context &context = *(m_stages[stage]->context);
+		const std::pair<int, int> range = m_ranges[microBatch];
+		for (size_t i = 0; i < m_graph.m_output_nodes.size(); i++)
+		{
+			const LossFunction *loss = m_graph.m_losses.at(i).get();
+			if (loss == nullptr)
+				continue;
+
+			Shape tmp(m_graph.getOutputShape(i));
+			tmp[0] = range.second;
+			const size_t offset = static_cast<size_t>(range.first) * tmp.volumeWithoutFirstDim();
+			Tensor gradient = m_graph.getGradient(i).view(tmp, offset);
+			Tensor output = m_graph.getOutput(i).view(tmp, offset);
+			Shape target_shape(m_graph.getTarget(i).shape());
+			target_shape[0] = range.second;
+			Tensor target = m_graph.getTarget(i).view(target_shape, static_cast<size_t>(range.first) * target_shape.volumeWithoutFirstDim());
+			// loss of the micro-batch is weighted the same way as its gradient, so that the accumulator receives the loss of the whole batch
+			const bool is_averaged = loss->isGradientAveragedOverBatch();
+			Tensor &accumulator = is_averaged ? *m_micro_batch_loss : m_graph.get_loss_accumulator(i);
+			if (is_averaged)
+				accumulator.zeroall();
+			if (loss->isFusedWithLayer())
+			{
+				Tensor input = m_graph.m_output_nodes[i]->getInputNode(0)->getOutputTensor().view(tmp, offset);
+				loss->getFusedLossAndGradient(context, gradient, input, output, target, accumulator);
+			}
+			else
+				loss->getGradientAndAccumulateLoss(context, gradient, output, target, accumulator);
+			if (is_averaged) // rescale from micro-batch average to the whole batch average
+			{
+				const double weight = static_cast<double>(range.second) / m_batch_size;
+				math::addTensors(context, gradient, gradient, weight, 0);
+				math::addTensors(context, m_graph.get_loss_accumulator(i), accumulator, weight, 1);
+			}
+		}
+	}
+	void Pipeline::receive(TokenQueue &queue, int microBatch)
+	{
+		int token = -1;
+		if (not queue.pop(token))
+			throw PipelineAborted();
+		assert(token == microBatch);
+	}
+	void Pipeline::close_queues()
+	{
+		for (size_t i = 0; i < m_forward_queues.size(); i++)
+		{
+			m_forward_queues[i]->close();
+			m_backward_queues[i]->close();
+		}
+	}
+
+} /* namespace avocado */
@@ -0,0 +1,233 @@
+/*
+ * Profiler.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <Avocado/graph/Profiler.hpp>
+#include <Avocado/graph/GraphNode.hpp>
+#include <Avocado/layers/Layer.hpp>
+#include <Avocado/core/Context.hpp>
+#include <Avocado/core/DataType.hpp>
+#include <Avocado/core/error_handling.hpp>
+#include <Avocado/utils/json.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+
+namespace
+{
+	using namespace avocado;
+
+	int get_thread_index() noexcept
+	{
+		static std::atomic<int> counter(0);
+		thread_local int index = counter++;
+		return index;
+	}
+	double volume_for_batch(Shape shape, int batchSize) noexcept
+	{
+		if (shape.length() == 0)
+			return 0.0;
+		shape[0] = batchSize;
+		return shape.volume();
+	}
+	double parameters_volume(const Layer &layer)
+	{
+		return static_cast<double>(layer.getWeightShape().volume()) + layer.getBiasShape().volume();
+	}
+	double elapsed_microseconds(std::chrono::steady_clock::time_point begin, std::chrono::steady_clock::time_point end) noexcept
+	{
+		return std::chrono::duration<double, std::micro>(end - begin).count();
+	}
+}
+
+namespace avocado
+{
+	std::string toString(ProfilerPhase phase)
+	{
+		switch (phase)
+		{
+			case ProfilerPhase::FORWARD:
+				return "forward";
+			case ProfilerPhase::BACKWARD:
+				return "backward";
+			case ProfilerPhase::LEARN:
+				return "learn";
+			default:
+				return "unknown";
+		}
+	}
+
+	Profiler::Profiler() :
+			m_origin(std::chrono::steady_clock::now())
+	{
+	}
+	Profiler::Measurement Profiler::start() const
+	{
+		Measurement result;
+		result.m_allocations = internal::getAllocationStats();
+		result.m_start = std::chrono::steady_clock::now();
+		return result;
+	}
+	void Profiler::recordNode(const Measurement &measurement, const Context &context, const GraphNode &node, int index, ProfilerPhase phase,
+			int batchSize)
+	{
+		const Layer &layer = node.getLayer();
+		double activations = volume_for_batch(node.getOutputShape(), batchSize);
+		for (int i = 0; i < node.numberOfInputs(); i++)
+			activations += volume_for_batch(node.getInputNode(i)->getOutputShape(), batchSize);
+
+		ProfilerEvent event;
+		event.name = layer.name();
+		event.phase = phase;
+		event.index = index;
+		if (phase == ProfilerPhase::FORWARD)
+		{
+			event.flops = layer.estimateFlops(batchSize);
+			event.bytes = (activations + parameters_volume(layer)) * sizeOf(layer.dtype());
+		}
+		else
+		{ // gradients with respect to both inputs and weights are calculated, and all tensors are read and written
+			event.flops = ((layer.getWeightShape().volume() == 0) ? 1.0 : 2.0) * layer.estimateFlops(batchSize);
+			event.bytes = 2.0 * (activations + parameters_volume(layer)) * sizeOf(layer.dtype());
+		}
+		record(measurement, context, std::move(event));
+	}
+	void Profiler::recordLearn(const Measurement &measurement, const Context &context, const Layer &layer, int index)
+	{
+		ProfilerEvent event;
+		event.name = layer.name();
+		event.phase = ProfilerPhase::LEARN;
+		event.index = index;
+		event.flops = 4.0 * parameters_volume(layer); // typical optimizer step
+		event.bytes = 4.0 * parameters_volume(layer) * sizeOf(layer.dtype()); // parameters, updates and optimizer state
+		record(measurement, context, std::move(event));
+	}
+	void Profiler::nextStep() noexcept
+	{
+		m_steps++;
+	}
+
+	void Profiler::clear()
+	{
+		m_events.clear();
+		m_steps = 0;
+		m_origin = std::chrono::steady_clock::now();
+	}
+	int Profiler::numberOfSteps() const noexcept
+	{
+		return m_steps;
+	}
+	const std::vector<ProfilerEvent>& Profiler::getEvents() const noexcept
+	{
+		return m_events;
+	}
+
+	Json Profiler::getChromeTrace() const
+	{
+		Json events(JsonType::Array);
+		for (size_t i = 0; i < m_events.size(); i++)
+		{
+			const ProfilerEvent &e = m_events[i];
+			Json args(JsonType::Object);
+			args["index"] = e.index;
+			args["flops"] = e.flops;
+			args["bytes"] = e.bytes;
+			args["allocations"] = static_cast<size_t>(e.allocations);
+			args["allocated bytes"] = static_cast<size_t>(e.allocatedBytes);
+
+			Json event(JsonType::Object);
+			event["name"] = e.name;
+			event["cat"] = toString(e.phase);
+			event["ph"] = "X";
+			event["ts"] = e.start;
+			event["dur"] = e.duration;
+			event["pid"] = 0;
+			event["tid"] = e.thread;
+			event["args"] = args;
+			events[i] = event;
+		}
+		Json result(JsonType::Object);
+		result["traceEvents"] = events;
+		result["displayTimeUnit"] = "ms";
+		return result;
+	}
+	void Profiler::saveChromeTrace(const std::string &path) const
+	{
+		std::ofstream stream(path);
+		if (not stream.good())
+			throw RuntimeError(METHOD_NAME, "could not open file '" + path + "'");
+		stream << getChromeTrace().dump();
+	}
+	std::string Profiler::summary() const
+	{
+		struct Entry
+		{
+				std::string name;
+				ProfilerPhase phase;
+				int index;
+				int calls = 0;
+				double time = 0.0;
+				double flops = 0.0;
+				double bytes = 0.0;
+				uint64_t allocations = 0;
+		};
+		std::map<std::pair<int, int>, Entry> entries; // sorted by phase, then by index
+		double total_time = 0.0;
+		for (size_t i = 0; i < m_events.size(); i++)
+		{
+			const ProfilerEvent &e = m_events[i];
+			Entry &entry = entries[ { static_cast<int>(e.phase), e.index }];
+			entry.name = e.name;
+			entry.phase = e.phase;
+			entry.index = e.index;
+			entry.calls++;
+			entry.time += e.duration;
+			entry.flops += e.flops;
+			entry.bytes += e.bytes;
+			entry.allocations += e.allocations;
+			total_time += e.duration;
+		}
+
+		std::stringstream ss;
+		ss << std::fixed;
+		ss << std::left << std::setw(10) << "phase" << std::setw(6) << "index" << std::setw(24) << "layer" << std::right << std::setw(8) << "calls"
+				<< std::setw(14) << "time [ms]" << std::setw(10) << "GFLOP/s" << std::setw(10) << "GB/s" << std::setw(9) << "share" << std::setw(8)
+				<< "allocs" << '\n';
+		for (auto iter = entries.begin(); iter != entries.end(); iter++)
+		{
+			const Entry &entry = iter->second;
+			const double seconds = 1.0e-6 * entry.time;
+			const double gflops = (seconds > 0.0) ? 1.0e-9 * entry.flops / seconds : 0.0;
+			const double gbytes = (seconds > 0.0) ? 1.0e-9 * entry.bytes / seconds : 0.0;
+			const double share = (total_time > 0.0) ? 100.0 * entry.time / total_time : 0.0;
+			ss << std::left << std::setw(10) << toString(entry.phase) << std::setw(6) << entry.index << std::setw(24) << entry.name << std::right
+					<< std::setw(8) << entry.calls << std::setw(14) << std::setprecision(3) << 1.0e-3 * entry.time << std::setw(10)
+					<< std::setprecision(2) << gflops << std::setw(10) << gbytes << std::setw(8) << std::setprecision(1) << share << '%'
+					<< std::setw(8) << entry.allocations << '\n';
+		}
+		ss << "total time = " << std::setprecision(3) << 1.0e-3 * total_time << " ms in " << m_steps << " steps\n";
+		return ss.str();
+	}
+
+	void Profiler::record(const Measurement &measurement, const Context &context, ProfilerEvent &&event)
+	{
+		context.synchronize();
+		const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+		const internal::AllocationStats &allocations = internal::getAllocationStats();
+
+		event.thread = get_thread_index();
+		event.start = elapsed_microseconds(m_origin, measurement.m_start);
+		event.duration = elapsed_microseconds(measurement.m_start, end);
+		event.allocations = allocations.allocations - measurement.m_allocations.allocations;
+		event.allocatedBytes = allocations.allocatedBytes - measurement.m_allocations.allocatedBytes;
+		m_events.push_back(std::move(event));
+	}
+
+} /* namespace avocado */
@@ -0,0 +1,253 @@
+/*
+ * ReplicaGroup.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <Avocado/graph/ReplicaGroup.hpp>
+#include <Avocado/graph/Graph.hpp>
+#include <Avocado/layers/Parameter.hpp>
+#include <Avocado/optimizers/Optimizer.hpp>
+#include <Avocado/regularizers/Regularizer.hpp>
+#include <Avocado/core/Context.hpp>
+#include <Avocado/core/Tensor.hpp>
+#include <Avocado/core/Scalar.hpp>
+#include <Avocado/core/error_handling.hpp>
+#include <Avocado/math/tensor_operations.hpp>
+#include <Avocado/math/training.hpp>
+#include <Avocado/utils/json.hpp>
+#include <Avocado/utils/serialization.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+	using namespace avocado;
+
+	std::vector<Parameter*> trainable_parameters(Graph &graph)
+	{
+		std::vector<Parameter*> result;
+		for (int i = 0; i < graph.numberOfLayers(); i++)
+		{
+			Parameter *tmp[2] = { &(graph.getLayer(i).getWeights()), &(graph.getLayer(i).getBias()) };
+			for (int j = 0; j < 2; j++)
+				if (tmp[j]->isTrainable() and tmp[j]->shape().volume() > 0)
+					result.push_back(tmp[j]);
+		}
+		return result;
+	}
+	Tensor flat_slice(Tensor &tensor, int64_t offset, int length)
+	{
+		return tensor.view( { length }, offset);
+	}
+	const Tensor flat_slice(const Tensor &tensor, int64_t offset, int length)
+	{
+		return tensor.view( { length }, offset);
+	}
+	/* copy of the optimizer with the same settings but without any state */
+	std::unique_ptr<Optimizer> fresh_optimizer(const Optimizer &optimizer)
+	{
+		SerializedObject binary_data;
+		Json json = optimizer.serialize(binary_data);
+		json["workspace"] = Json();
+		return loadOptimizer(json, binary_data);
+	}
+}
+
+namespace avocado
+{
+	ReplicaGroup::ReplicaGroup(const std::vector<Graph*> &replicas) :
+			m_replicas(replicas)
+	{
+		if (replicas.empty())
+			throw IllegalArgument(METHOD_NAME, "there must be at least one replica");
+		std::vector<std::vector<Parameter*>> params;
+		for (size_t i = 0; i < replicas.size(); i++)
+		{
+			if (not replicas[i]->isTrainable())
+				throw LogicError(METHOD_NAME, "Graph is not trainable");
+			params.push_back(trainable_parameters(*replicas[i]));
+			if (params[i].size() != params[0].size())
+				throw LogicError(METHOD_NAME, "replicas must have identical architecture");
+			for (size_t j = 0; j < params[i].size(); j++)
+				if (params[i][j]->shape() != params[0][j]->shape() or params[i][j]->dtype() != params[0][j]->dtype())
+					throw LogicError(METHOD_NAME, "replicas must have identical architecture");
+		}
+		for (size_t j = 0; j < params[0].size(); j++)
+		{
+			const std::string name = params[0][j]->getOptimizer().name();
+			if (name == "LARS" or name == "LAMB")
+				throw LogicError(METHOD_NAME, "optimizer '" + name + "' needs whole parameters and cannot be sharded");
+			if (params[0][j]->hasAverage())
+				throw LogicError(METHOD_NAME, "weight averaging cannot be used with sharded optimizer");
+		}
+
+		int64_t total = 0;
+		for (size_t j = 0; j < params[0].size(); j++)
+			total += params[0][j]->shape().volume();
+		const int64_t replica_count = replicas.size();
+
+		int64_t start = 0; // of the current parameter in the flattened space
+		for (size_t j = 0; j < params[0].size(); j++)
+		{
+			const int64_t end = start + params[0][j]->shape().volume();
+			for (int r = 0; r < numberOfReplicas(); r++)
+			{
+				const int64_t first = std::max(start, total * r / replica_count);
+				const int64_t last = std::min(end, total * (r + 1) / replica_count);
+				if (first >= last)
+					continue;
+
+				Parameter &owner = *params[r][j];
+				Shard shard;
+				shard.replica = r;
+				shard.parameter = j;
+				shard.offset = first - start;
+				shard.length = last - first;
+				shard.master = std::make_unique<Parameter>(Shape( { 0 }), owner.dtype(), owner.device());
+				shard.master->setOptimizer(*fresh_optimizer(owner.getOptimizer()));
+				if (owner.hasRegularizer())
+					shard.master->setRegularizer(owner.getRegularizer());
+				m_shards.push_back(std::move(shard));
+			}
+			start = end;
+		}
+		for (int r = 1; r < numberOfReplicas(); r++)
+			for (size_t j = 0; j < params[r].size(); j++)
+				params[r][j]->mutableParam().copyFrom(params[0][j]->getParam());
+	}
+	ReplicaGroup::~ReplicaGroup()
+	{
+	}
+
+	int ReplicaGroup::numberOfReplicas() const noexcept
+	{
+		return m_replicas.size();
+	}
+	Graph& ReplicaGroup::getReplica(int index)
+	{
+		if (index < 0 or index >= numberOfReplicas())
+			throw IndexOutOfBounds(METHOD_NAME, "index", index, numberOfReplicas());
+		return *m_replicas[index];
+	}
+	int64_t ReplicaGroup::shardSize(int replica) const
+	{
+		if (replica < 0 or replica >= numberOfReplicas())
+			throw IndexOutOfBounds(METHOD_NAME, "replica", replica, numberOfReplicas());
+		int64_t result = 0;
+		for (size_t i = 0; i < m_shards.size(); i++)
+			if (m_shards[i].replica == replica)
+				result += m_shards[i].length;
+		return result;
+	}
+
+	ReplicaGroup& ReplicaGroup::setGradientClipping(double maxNorm)
+	{
+		if (maxNorm < 0.0)
+			throw IllegalArgument(METHOD_NAME, "maxNorm must not be negative");
+		m_max_gradient_norm = maxNorm;
+		return *this;
+	}
+	double ReplicaGroup::getLastGradientNorm() const noexcept
+	{
+		return m_last_gradient_norm;
+	}
+
+	void ReplicaGroup::learn()
+	{
+		double multiplier = 1.0; // schedules of all replicas are advanced so that they stay in sync, the first one is used
+		for (int r = numberOfReplicas() - 1; r >= 0; r--)
+			if (m_replicas[r]->hasLearningRateSchedule())
+				multiplier = m_replicas[r]->getLearningRateSchedule().next();
+
+		std::vector<std::vector<Parameter*>> params;
+		for (int r = 0; r < numberOfReplicas(); r++)
+		{
+			m_replicas[r]->context().activate();
+			params.push_back(trainable_parameters(*m_replicas[r]));
+			for (int i = 0; i < m_replicas[r]->numberOfLayers(); i++)
+				m_replicas[r]->getLayer(i).beforeLearn();
+		}
+
+		for (size_t i = 0; i < m_shards.size(); i++)
+		{ // views are made again as the owner may have reallocated its tensors since the last step
+			Shard &shard = m_shards[i];
+			shard.master->viewSliceOf(*params[shard.replica][shard.parameter], shard.offset, shard.length);
+			reduce(shard, params);
+		}
+		double scale = 1.0;
+		if (m_max_gradient_norm > 0.0)
+		{
+			m_last_gradient_norm = global_norm();
+			if (m_last_gradient_norm > m_max_gradient_norm)
+				scale = m_max_gradient_norm / m_last_gradient_norm;
+		}
+		for (size_t i = 0; i < m_shards.size(); i++)
+		{
+			Shard &shard = m_shards[i];
+			shard.master->setGradientScale(scale);
+			shard.master->learn(m_replicas[shard.replica]->context(), multiplier);
+			gather(shard, params);
+		}
+
+		for (int r = 0; r < numberOfReplicas(); r++)
+		{
+			for (int i = 0; i < m_replicas[r]->numberOfLayers(); i++)
+				m_replicas[r]->getLayer(i).afterLearn();
+			for (size_t j = 0; j < params[r].size(); j++)
+			{
+				params[r][j]->getUpdate().zeroall();
+				params[r][j]->setGradientScale(1.0);
+			}
+		}
+	}
+
+	void ReplicaGroup::reduce(Shard &shard, const std::vector<std::vector<Parameter*>> &params)
+	{
+		const Context &context = m_replicas[shard.replica]->context();
+		Tensor &update = shard.master->getUpdate(); // view of the update of the owner
+		math::scaleTensor(context, update, 1.0 / numberOfReplicas());
+		for (int r = 0; r < numberOfReplicas(); r++)
+		{
+			if (r == shard.replica)
+				continue;
+			Tensor src = flat_slice(params[r][shard.parameter]->getUpdate(), shard.offset, shard.length);
+			if (src.device() == update.device())
+				math::addTensors(context, update, src, 1.0 / numberOfReplicas(), 1);
+			else
+			{
+				if (shard.staging == nullptr)
+					shard.staging = std::make_unique<Tensor>(update.shape(), update.dtype(), update.device());
+				shard.staging->copyFrom(src);
+				math::addTensors(context, update, *shard.staging, 1.0 / numberOfReplicas(), 1);
+			}
+		}
+	}
+	double ReplicaGroup::global_norm()
+	{
+		double result = 0.0;
+		for (int r = 0; r < numberOfReplicas(); r++)
+		{ // shards owned by one replica are on the same device, so their norm is reduced in a single call
+			std::vector<Tensor*> updates;
+			for (size_t i = 0; i < m_shards.size(); i++)
+				if (m_shards[i].replica == r)
+					updates.push_back(&(m_shards[i].master->getUpdate()));
+			const double norm = math::globalNorm2(m_replicas[r]->context(), updates);
+			result += norm * norm;
+		}
+		return std::sqrt(result);
+	}
+	void ReplicaGroup::gather(Shard &shard, const std::vector<std::vector<Parameter*>> &params)
+	{
+		for (int r = 0; r < numberOfReplicas(); r++)
+		{
+			if (r == shard.replica)
+				continue; // the owner was updated in place
+			Parameter &param = *params[r][shard.parameter];
+			flat_slice(param.mutableParam(), shard.offset, shard.length).copyFrom(shard.master->getParam());
+		}
+	}
+
+} /* namespace avocado */
@@ -0,0 +1,320 @@
+/*
+ * Trainer.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <Avocado/graph/Trainer.hpp>
+#include <Avocado/graph/Graph.hpp>
+#include <Avocado/data/DataLoader.hpp>
+#include <Avocado/core/Tensor.hpp>
+#include <Avocado/core/Scalar.hpp>
+#include <Avocado/core/error_handling.hpp>
+#include <Avocado/utils/file_helpers.hpp>
+#include <Avocado/utils/json.hpp>
+#include <Avocado/utils/serialization.hpp>
+
+#include <algorithm>
+#include <filesystem>
+
+namespace
+{
+	using namespace avocado;
+
+	Tensor first_rows(Tensor &batch, int rows)
+	{
+		Shape shape(batch.shape());
+		shape[0] = rows;
+		return batch.view(shape);
+	}
+	double to_seconds(std::chrono::steady_clock::duration d)
+	{
+		return std::chrono::duration<double>(d).count();
+	}
+}
+
+namespace avocado
+{
+	std::string TrainingLog::toString() const
+	{
+		std::string result = "epoch " + std::to_string(epoch) + ", step " + std::to_string(step) + " :";
+		for (size_t i = 0; i < loss.size(); i++)
+			result += " loss = " + std::to_string(loss[i]) + ",";
+		for (size_t i = 0; i < metrics.size(); i++)
+			result += " " + metrics[i].first + " = " + std::to_string(metrics[i].second) + ",";
+		if (learningRate > 0.0)
+			result += " lr = " + std::to_string(learningRate) + ",";
+		if (samplesPerSecond > 0.0)
+			result += " " + std::to_string(samplesPerSecond) + " samples/s,";
+		result.pop_back();
+		return result;
+	}
+
+	void TrainerCallback::onTrainingBegin(Trainer &trainer)
+	{
+	}
+	void TrainerCallback::onEpochBegin(Trainer &trainer, int epoch)
+	{
+	}
+	void TrainerCallback::onStepEnd(Trainer &trainer, int64_t step)
+	{
+	}
+	void TrainerCallback::onLog(Trainer &trainer, const TrainingLog &log)
+	{
+	}
+	void TrainerCallback::onEvaluation(Trainer &trainer, const TrainingLog &log)
+	{
+	}
+	void TrainerCallback::onEpochEnd(Trainer &trainer, int epoch)
+	{
+	}
+	void TrainerCallback::onTrainingEnd(Trainer &trainer)
+	{
+	}
+
+	Trainer::Trainer(Graph &graph, DataLoader &trainData) :
+			m_graph(graph),
+			m_train_data(trainData)
+	{
+		if (not graph.isTrainable())
+			throw LogicError(METHOD_NAME, "Graph is not trainable");
+	}
+
+	Trainer& Trainer::setValidationData(DataLoader &data)
+	{
+		m_validation_data = &data;
+		return *this;
+	}
+	Trainer& Trainer::addMetric(const Metric &metric)
+	{
+		m_metrics.push_back(std::unique_ptr<Metric>(metric.clone()));
+		m_validation_metrics.push_back(std::unique_ptr<Metric>(metric.clone()));
+		return *this;
+	}
+	Trainer& Trainer::addCallback(TrainerCallback &callback)
+	{
+		m_callbacks.push_back(&callback);
+		return *this;
+	}
+	Trainer& Trainer::setLearningRateSchedule(const LearningRateSchedule &schedule)
+	{
+		m_graph.setLearningRateSchedule(schedule);
+		return *this;
+	}
+	Trainer& Trainer::setGradientClipping(double maxNorm)
+	{
+		if (maxNorm < 0.0)
+			throw IllegalArgument(METHOD_NAME, "maxNorm must not be negative");
+		m_max_gradient_norm = maxNorm;
+		return *this;
+	}
+	Trainer& Trainer::setLogInterval(int steps)
+	{
+		if (steps < 1)
+			throw IllegalArgument(METHOD_NAME, "steps", "must be positive", steps);
+		m_log_interval = steps;
+		return *this;
+	}
+	Trainer& Trainer::setEvaluationInterval(int epochs)
+	{
+		if (epochs < 1)
+			throw IllegalArgument(METHOD_NAME, "epochs", "must be positive", epochs);
+		m_evaluation_interval = epochs;
+		return *this;
+	}
+	Trainer& Trainer::setCheckpoint(const std::string &path, int epochs)
+	{
+		if (epochs < 1)
+			throw IllegalArgument(METHOD_NAME, "epochs", "must be positive", epochs);
+		m_checkpoint_path = path;
+		m_checkpoint_interval = epochs;
+		return *this;
+	}
+
+	void Trainer::fit(int epochs)
+	{
+		m_stop_requested = false;
+		m_graph.resetAccumulatedLoss();
+		for (size_t i = 0; i < m_metrics.size(); i++)
+			m_metrics[i]->reset();
+		m_steps_since_log = 0;
+		m_samples_since_log = 0;
+		m_last_log = std::chrono::steady_clock::now();
+
+		for (size_t i = 0; i < m_callbacks.size(); i++)
+			m_callbacks[i]->onTrainingBegin(*this);
+		const int last_epoch = m_epoch + epochs;
+		while (m_epoch < last_epoch and not m_stop_requested)
+		{
+			for (size_t i = 0; i < m_callbacks.size(); i++)
+				m_callbacks[i]->onEpochBegin(*this, m_epoch);
+
+			int b = 0;
+			for (; b < m_train_data.numberOfBatches() and not m_stop_requested; b++)
+			{
+				train_step();
+				if (m_steps_since_log == m_log_interval or b == m_train_data.numberOfBatches() - 1)
+				{
+					const TrainingLog log = collect_log();
+					for (size_t i = 0; i < m_callbacks.size(); i++)
+						m_callbacks[i]->onLog(*this, log);
+				}
+			}
+			if (b < m_train_data.numberOfBatches())
+			{ // stopped in the middle of the epoch, so it is neither evaluated nor counted as finished
+				if (m_steps_since_log > 0)
+				{
+					const TrainingLog log = collect_log();
+					for (size_t i = 0; i < m_callbacks.size(); i++)
+						m_callbacks[i]->onLog(*this, log);
+				}
+				break;
+			}
+
+			if (m_validation_data != nullptr and (m_epoch + 1) % m_evaluation_interval == 0)
+			{
+				const TrainingLog log = evaluate();
+				for (size_t i = 0; i < m_callbacks.size(); i++)
+					m_callbacks[i]->onEvaluation(*this, log);
+			}
+			for (size_t i = 0; i < m_callbacks.size(); i++)
+				m_callbacks[i]->onEpochEnd(*this, m_epoch);
+			m_epoch++;
+			if (m_checkpoint_interval > 0 and m_epoch % m_checkpoint_interval == 0)
+				saveCheckpoint(m_checkpoint_path);
+		}
+		for (size_t i = 0; i < m_callbacks.size(); i++)
+			m_callbacks[i]->onTrainingEnd(*this);
+	}
+	TrainingLog Trainer::evaluate()
+	{
+		if (m_validation_data == nullptr)
+			throw UninitializedObject(METHOD_NAME, "validation data has not been set");
+
+		const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < m_validation_metrics.size(); i++)
+			m_validation_metrics[i]->reset();
+		TrainingLog result;
+		result.epoch = m_epoch;
+		result.step = m_step;
+		result.loss.assign(m_graph.numberOfOutputs(), 0.0);
+
+		int64_t samples = 0;
+		for (int b = 0; b < m_validation_data->numberOfBatches(); b++)
+		{
+			const int batch_size = m_validation_data->next();
+			m_graph.forward(batch_size);
+			for (size_t i = 0; i < m_validation_metrics.size(); i++)
+				m_validation_metrics[i]->update(m_graph.context(), first_rows(m_graph.getOutput(), batch_size),
+						first_rows(m_graph.getTarget(), batch_size));
+			const std::vector<Scalar> loss = m_graph.getLoss(batch_size); // there is no backward pass to accumulate it on the device
+			for (size_t i = 0; i < loss.size(); i++)
+				result.loss[i] += loss[i].get<double>();
+			samples += batch_size;
+			result.steps++;
+		}
+		for (size_t i = 0; i < result.loss.size(); i++)
+			result.loss[i] /= std::max(1, result.steps);
+		for (size_t i = 0; i < m_validation_metrics.size(); i++)
+			result.metrics.push_back( { m_validation_metrics[i]->name(), m_validation_metrics[i]->getValue().get<double>() });
+		result.samplesPerSecond = samples / std::max(1.0e-9, to_seconds(std::chrono::steady_clock::now() - start));
+		return result;
+	}
+	void Trainer::saveCheckpoint(const std::string &path) const
+	{
+		SerializedObject binary_data;
+		Json json;
+		json["graph"] = m_graph.save(binary_data);
+		json["epoch"] = m_epoch;
+		json["step"] = m_step;
+
+		const std::string tmp_path = path + ".tmp"; // previous checkpoint is replaced only after the new one was fully written
+		FileSaver saver(tmp_path);
+		saver.save(json, binary_data);
+		saver.close();
+		std::filesystem::rename(tmp_path, path);
+	}
+	void Trainer::loadCheckpoint(const std::string &path)
+	{
+		FileLoader loader(path);
+		const Json &json = loader.getJson();
+		if (not json.hasKey("graph") or not json.hasKey("epoch") or not json.hasKey("step"))
+			throw LogicError(METHOD_NAME, "'" + path + "' is not a training checkpoint");
+
+		const Device device = m_graph.device();
+		const ThreadGroup group = m_graph.context().threadGroup();
+		const FastMathMode mode = m_graph.context().fastMathMode();
+		m_graph.load(json["graph"], loader.getBinaryData());
+		m_graph.moveTo(device); // loading recreates the graph on the default context
+		m_graph.setThreadGroup(group);
+		m_graph.setFastMathMode(mode);
+		m_epoch = static_cast<int>(json["epoch"]);
+		m_step = static_cast<int64_t>(json["step"]);
+	}
+	void Trainer::stop() noexcept
+	{
+		m_stop_requested = true;
+	}
+
+	int Trainer::currentEpoch() const noexcept
+	{
+		return m_epoch;
+	}
+	int64_t Trainer::currentStep() const noexcept
+	{
+		return m_step;
+	}
+	const Graph& Trainer::graph() const noexcept
+	{
+		return m_graph;
+	}
+	Graph& Trainer::graph() noexcept
+	{
+		return m_graph;
+	}
+
+	void Trainer::train_step()
+	{
+		const int batch_size = m_train_data.next();
+		m_graph.forward(batch_size);
+		m_graph.backward(batch_size);
+		for (size_t i = 0; i < m_metrics.size(); i++)
+			m_metrics[i]->update(m_graph.context(), first_rows(m_graph.getOutput(), batch_size), first_rows(m_graph.getTarget(), batch_size));
+		if (m_max_gradient_norm > 0.0)
+			m_graph.clipGradients(m_max_gradient_norm);
+		m_graph.learn();
+
+		m_step++;
+		m_steps_since_log++;
+		m_samples_since_log += batch_size;
+		for (size_t i = 0; i < m_callbacks.size(); i++)
+			m_callbacks[i]->onStepEnd(*this, m_step);
+	}
+	TrainingLog Trainer::collect_log()
+	{
+		TrainingLog result;
+		result.epoch = m_epoch;
+		result.step = m_step;
+		result.steps = m_steps_since_log;
+		result.learningRate = m_graph.getLearningRate();
+
+		const std::vector<Scalar> loss = m_graph.getAccumulatedLoss(); // synchronizes the context
+		for (size_t i = 0; i < loss.size(); i++)
+			result.loss.push_back(loss[i].get<double>());
+		m_graph.resetAccumulatedLoss();
+		for (size_t i = 0; i < m_metrics.size(); i++)
+		{
+			result.metrics.push_back( { m_metrics[i]->name(), m_metrics[i]->getValue().get<double>() });
+			m_metrics[i]->reset();
+		}
+
+		const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		result.samplesPerSecond = m_samples_since_log / std::max(1.0e-9, to_seconds(now - m_last_log));
+		m_last_log = now;
+		m_steps_since_log = 0;
+		m_samples_since_log = 0;
+		return result;
+	}
+
+} /* namespace avocado */
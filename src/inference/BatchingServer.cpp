@@ -0,0 +1,209 @@
+/*
+ * BatchingServer.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <Avocado/inference/BatchingServer.hpp>
+#include <Avocado/graph/Graph.hpp>
+#include <Avocado/core/error_handling.hpp>
+
+#include <algorithm>
+
+namespace
+{
+	using namespace avocado;
+
+	Shape row_shape(const Tensor &batch)
+	{
+		Shape result(batch.shape());
+		result[0] = 1;
+		return result;
+	}
+	Tensor get_row(Tensor &batch, int index)
+	{
+		const Shape shape = row_shape(batch);
+		return batch.view(shape, shape.volume() * index);
+	}
+	double to_seconds(std::chrono::steady_clock::duration d)
+	{
+		return std::chrono::duration<double>(d).count();
+	}
+}
+
+namespace avocado
+{
+	namespace inference
+	{
+		double ServingStatistics::averageQueueingDelay() const noexcept
+		{
+			return (processedRequests == 0) ? 0.0 : totalQueueingDelay / processedRequests;
+		}
+		double ServingStatistics::averageBatchFill() const noexcept
+		{
+			return (processedBatches == 0) ? 0.0 : totalBatchFill / processedBatches;
+		}
+		double ServingStatistics::throughput() const noexcept
+		{
+			return (elapsedTime == 0.0) ? 0.0 : processedRequests / elapsedTime;
+		}
+		std::string ServingStatistics::toString() const
+		{
+			return "requests=" + std::to_string(processedRequests) + ", batches=" + std::to_string(processedBatches) + ", avg delay="
+					+ std::to_string(1.0e3 * averageQueueingDelay()) + "ms, max delay=" + std::to_string(1.0e3 * maxQueueingDelay)
+					+ "ms, avg batch fill=" + std::to_string(100.0 * averageBatchFill()) + "%, throughput=" + std::to_string(throughput())
+					+ " req/s";
+		}
+
+		BatchingServer::BatchingServer(const Graph &model, std::chrono::microseconds maxDelay, int maxBatchSize, const ThreadGroup &group) :
+				m_session(model, group),
+				m_max_batch_size((maxBatchSize == 0) ? model.maxBatchSize() : maxBatchSize),
+				m_max_delay(maxDelay)
+		{
+			if (m_max_batch_size <= 0 || m_max_batch_size > model.maxBatchSize())
+				throw IllegalArgument(METHOD_NAME, "maxBatchSize", "must be in range [0, " + std::to_string(model.maxBatchSize()) + "]",
+						maxBatchSize);
+			m_worker = std::thread(&BatchingServer::worker_loop, this);
+		}
+		BatchingServer::~BatchingServer()
+		{
+			{
+				std::lock_guard lock(m_queue_mutex);
+				m_is_running = false;
+			}
+			m_queue_cond.notify_all();
+			m_worker.join();
+		}
+
+		int BatchingServer::maxBatchSize() const noexcept
+		{
+			return m_max_batch_size;
+		}
+		std::chrono::microseconds BatchingServer::maxDelay() const noexcept
+		{
+			return m_max_delay;
+		}
+
+		std::future<std::vector<Tensor>> BatchingServer::submit(const std::vector<Tensor> &inputs)
+		{
+			if (static_cast<int>(inputs.size()) != m_session.numberOfInputs())
+				throw IllegalArgument(METHOD_NAME, "inputs", "must contain one tensor per graph input", inputs.size());
+
+			Request request;
+			for (size_t i = 0; i < inputs.size(); i++)
+			{
+				const Shape shape = row_shape(m_session.getInput(i));
+				if (inputs[i].volume() != shape.volume())
+					throw ShapeMismatch(METHOD_NAME, shape, inputs[i].shape());
+				if (inputs[i].dtype() != m_session.dtype())
+					throw DataTypeMismatch(METHOD_NAME, m_session.dtype(), inputs[i].dtype());
+
+				request.inputs.push_back(Tensor(inputs[i].shape(), inputs[i].dtype(), Device::cpu())); // sample is copied so the caller can reuse it
+				request.inputs.back().copyFrom(inputs[i]);
+				request.inputs.back().reshape(shape);
+			}
+			std::future<std::vector<Tensor>> result = request.result.get_future();
+
+			{
+				std::lock_guard lock(m_queue_mutex);
+				if (not m_is_running)
+					throw LogicError(METHOD_NAME, "server is stopped");
+				request.arrival = std::chrono::steady_clock::now();
+				m_queue.push_back(std::move(request));
+			}
+			m_queue_cond.notify_one();
+			return result;
+		}
+		std::future<std::vector<Tensor>> BatchingServer::submit(const Tensor &input)
+		{
+			return submit(std::vector<Tensor>( { input }));
+		}
+
+		ServingStatistics BatchingServer::getStatistics() const
+		{
+			std::lock_guard lock(m_statistics_mutex);
+			return m_statistics;
+		}
+		void BatchingServer::resetStatistics()
+		{
+			std::lock_guard lock(m_statistics_mutex);
+			m_statistics = ServingStatistics();
+			m_first_request = std::chrono::steady_clock::time_point::max();
+		}
+
+		void BatchingServer::worker_loop()
+		{
+			std::vector<Request> batch;
+			while (true)
+			{
+				{
+					std::unique_lock lock(m_queue_mutex);
+					m_queue_cond.wait(lock, [this]()
+					{	return not m_queue.empty() or not m_is_running;});
+					if (m_queue.empty()) // the server is stopping and there is nothing left to process
+						return;
+
+					const std::chrono::steady_clock::time_point deadline = m_queue.front().arrival + m_max_delay;
+					m_queue_cond.wait_until(lock, deadline, [this]()
+					{	return static_cast<int>(m_queue.size()) >= m_max_batch_size or not m_is_running;});
+
+					const int batch_size = std::min(static_cast<int>(m_queue.size()), m_max_batch_size);
+					for (int i = 0; i < batch_size; i++)
+					{
+						batch.push_back(std::move(m_queue.front()));
+						m_queue.pop_front();
+					}
+				}
+				process_batch(batch);
+				batch.clear();
+			}
+		}
+		void BatchingServer::process_batch(std::vector<Request> &batch)
+		{
+			const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			const int batch_size = static_cast<int>(batch.size());
+			int completed = 0;
+			try
+			{
+				for (int i = 0; i < m_session.numberOfInputs(); i++)
+					for (int j = 0; j < batch_size; j++)
+						get_row(m_session.getInput(i), j).copyFrom(batch[j].inputs[i]);
+
+				m_session.forward(batch_size);
+
+				for (int j = 0; j < batch_size; j++)
+				{
+					std::vector<Tensor> outputs;
+					for (int i = 0; i < m_session.numberOfOutputs(); i++)
+					{
+						Tensor row = get_row(m_session.getOutput(i), j);
+						outputs.push_back(Tensor(row.shape(), row.dtype(), Device::cpu()));
+						outputs.back().copyFrom(row);
+					}
+					batch[j].result.set_value(std::move(outputs));
+					completed++;
+				}
+			} catch (...)
+			{
+				for (int j = completed; j < batch_size; j++)
+					batch[j].result.set_exception(std::current_exception());
+			}
+			const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+			std::lock_guard lock(m_statistics_mutex);
+			for (int j = 0; j < batch_size; j++)
+			{
+				const double delay = to_seconds(start - batch[j].arrival);
+				m_statistics.totalQueueingDelay += delay;
+				m_statistics.maxQueueingDelay = std::max(m_statistics.maxQueueingDelay, delay);
+				m_first_request = std::min(m_first_request, batch[j].arrival);
+			}
+			m_statistics.processedRequests += batch_size;
+			m_statistics.processedBatches++;
+			m_statistics.totalBatchFill += static_cast<double>(batch_size) / m_max_batch_size;
+			m_statistics.elapsedTime = to_seconds(end - m_first_request);
+		}
+
+	} /* namespace inference */
+} /* namespace avocado */
@@ -0,0 +1,212 @@
+/*
+ * InferenceSession.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <Avocado/inference/InferenceSession.hpp>
+#include <Avocado/graph/Graph.hpp>
+#include <Avocado/graph/GraphNode.hpp>
+#include <Avocado/layers/Layer.hpp>
+#include <Avocado/core/Scalar.hpp>
+#include <Avocado/core/error_handling.hpp>
+#include <Avocado/utils/json.hpp>
+
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+	using namespace avocado;
+
+	struct MemoryBlock
+	{
+			size_t offset;
+			size_t size;
+			int last_use; // index of the last node that reads this block
+	};
+
+	size_t round_up(size_t value, size_t alignment) noexcept
+	{
+		return ((value + alignment - 1) / alignment) * alignment;
+	}
+
+	Tensor change_batch(int batch_size, Tensor &other)
+	{
+		Shape tmp(other.shape());
+		tmp[0] = batch_size;
+		return other.view(tmp);
+	}
+}
+
+namespace avocado
+{
+	namespace inference
+	{
+		InferenceSession::InferenceSession(const Graph &model, const ThreadGroup &group) :
+				m_model(model),
+				m_context(model.device(), group)
+		{
+			m_context.setFastMathMode(model.context().fastMathMode());
+			for (int i = 0; i < model.numberOfLayers(); i++)
+			{
+				const Layer &layer = model.getLayer(i);
+				m_layers.push_back(std::unique_ptr<Layer>(layer.clone(layer.getConfig())));
+				m_layers.back()->changeContext(m_context);
+
+				std::vector<Shape> shapes;
+				for (int j = 0; j < layer.numberOfInputs(); j++)
+					shapes.push_back(layer.getInputShape(j));
+				m_layers.back()->setInputShape(shapes);
+				m_layers.back()->shareParametersWith(layer);
+			}
+
+			for (int i = 0; i < model.numberOfNodes(); i++)
+			{
+				const GraphNode &node = model.getNode(i);
+				for (int j = 0; j < model.numberOfLayers(); j++)
+					if (&(node.getLayer()) == &(model.getLayer(j)))
+						m_layer_of_node.push_back(j);
+
+				m_inputs_of_node.push_back(std::vector<int>());
+				for (int j = 0; j < node.numberOfInputs(); j++)
+					m_inputs_of_node.back().push_back(model.getNodeID(node.getInputNode(j)));
+			}
+			for (int i = 0; i < model.numberOfInputs(); i++)
+				m_input_nodes.push_back(model.getInputNodeID(i));
+			for (int i = 0; i < model.numberOfOutputs(); i++)
+				m_output_nodes.push_back(model.getOutputNodeID(i));
+
+			plan_activations();
+		}
+
+		const Graph& InferenceSession::model() const noexcept
+		{
+			return m_model;
+		}
+		const Context& InferenceSession::context() const noexcept
+		{
+			return m_context;
+		}
+		Device InferenceSession::device() const noexcept
+		{
+			return m_context.device();
+		}
+		DataType InferenceSession::dtype() const noexcept
+		{
+			return m_model.dtype();
+		}
+
+		int InferenceSession::numberOfInputs() const noexcept
+		{
+			return static_cast<int>(m_input_nodes.size());
+		}
+		int InferenceSession::numberOfOutputs() const noexcept
+		{
+			return static_cast<int>(m_output_nodes.size());
+		}
+		int InferenceSession::maxBatchSize() const
+		{
+			return m_model.maxBatchSize();
+		}
+		size_t InferenceSession::sizeInBytes() const noexcept
+		{
+			return m_arena.sizeInBytes();
+		}
+
+		const Tensor& InferenceSession::getInput(int index) const
+		{
+			return m_activations.at(m_input_nodes.at(index));
+		}
+		const Tensor& InferenceSession::getOutput(int index) const
+		{
+			return m_activations.at(m_output_nodes.at(index));
+		}
+		Tensor& InferenceSession::getInput(int index)
+		{
+			return m_activations.at(m_input_nodes.at(index));
+		}
+		Tensor& InferenceSession::getOutput(int index)
+		{
+			return m_activations.at(m_output_nodes.at(index));
+		}
+		const Tensor& InferenceSession::getActivation(int node) const
+		{
+			if (node < 0 || node >= static_cast<int>(m_activations.size()))
+				throw IndexOutOfBounds(METHOD_NAME, "node", node, static_cast<int>(m_activations.size()));
+			return m_activations[node];
+		}
+
+		void InferenceSession::forward(int batchSize)
+		{
+			if (batchSize <= 0 || batchSize > maxBatchSize())
+				throw IllegalArgument(METHOD_NAME, "batchSize", "must be in range [1, " + std::to_string(maxBatchSize()) + "]", batchSize);
+
+			m_context.activate();
+			for (size_t i = 0; i < m_activations.size(); i++)
+			{
+				if (m_inputs_of_node[i].empty()) // input nodes are not processed, the same as in Graph
+					continue;
+
+				std::vector<Tensor> input(m_inputs_of_node[i].size());
+				for (size_t j = 0; j < input.size(); j++)
+					input[j] = change_batch(batchSize, m_activations[m_inputs_of_node[i][j]]);
+				Tensor output = change_batch(batchSize, m_activations[i]);
+
+				m_layers[m_layer_of_node[i]]->forward(input, output, 1, 0);
+			}
+		}
+
+		/*
+		 * Activations of nodes are placed in a single arena. Memory of a node is reused once all of its consumers have been executed.
+		 * Inputs and outputs of the graph are never reused.
+		 */
+		void InferenceSession::plan_activations()
+		{
+			const int nb_nodes = static_cast<int>(m_inputs_of_node.size());
+			std::vector<int> last_use(nb_nodes, -1);
+			for (int i = 0; i < nb_nodes; i++)
+			{
+				last_use[i] = std::max(last_use[i], i);
+				for (size_t j = 0; j < m_inputs_of_node[i].size(); j++)
+					last_use[m_inputs_of_node[i][j]] = std::max(last_use[m_inputs_of_node[i][j]], i);
+			}
+			for (size_t i = 0; i < m_input_nodes.size(); i++)
+				last_use[m_input_nodes[i]] = std::numeric_limits<int>::max();
+			for (size_t i = 0; i < m_output_nodes.size(); i++)
+				last_use[m_output_nodes[i]] = std::numeric_limits<int>::max();
+
+			const size_t alignment = std::max(static_cast<size_t>(1), 64 / sizeOf(dtype())); // in elements
+			std::vector<MemoryBlock> live_blocks;
+			std::vector<size_t> offsets(nb_nodes);
+			size_t arena_size = 0;
+			for (int i = 0; i < nb_nodes; i++)
+			{
+				live_blocks.erase(std::remove_if(live_blocks.begin(), live_blocks.end(), [i](const MemoryBlock &b)
+				{	return b.last_use < i;}), live_blocks.end());
+				std::sort(live_blocks.begin(), live_blocks.end(), [](const MemoryBlock &lhs, const MemoryBlock &rhs)
+				{	return lhs.offset < rhs.offset;});
+
+				const size_t size = round_up(m_model.getNode(i).getOutputShape().volume(), alignment);
+				size_t offset = 0; // first fit between blocks that are still in use
+				for (size_t j = 0; j < live_blocks.size(); j++)
+				{
+					if (offset + size <= live_blocks[j].offset)
+						break;
+					offset = std::max(offset, live_blocks[j].offset + live_blocks[j].size);
+				}
+				live_blocks.push_back( { offset, size, last_use[i] });
+				offsets[i] = offset;
+				arena_size = std::max(arena_size, offset + size);
+			}
+
+			m_arena = Tensor(Shape( { static_cast<int>(arena_size) }), dtype(), device());
+			m_arena.setMemoryCategory(MemoryCategory::ACTIVATIONS);
+			m_activations.clear();
+			for (int i = 0; i < nb_nodes; i++)
+				m_activations.push_back(m_arena.view(m_model.getNode(i).getOutputShape(), offsets[i]));
+		}
+
+	} /* namespace inference */
+} /* namespace avocado */
@@ -57,8 +57,8 @@ namespace avocado
 					const Tensor &batchnorm_weights = old_layer->getWeights().getParam();
 					const Tensor &batchnorm_bias = old_layer->getBias().getParam();
 
-					Tensor &affine_weights = graph.getLayer(i).getWeights().getParam();
-					Tensor &affine_bias = graph.getLayer(i).getBias().getParam();
+					Tensor &affine_weights = graph.getLayer(i).getWeights().mutableParam();
+					Tensor &affine_bias = graph.getLayer(i).getBias().mutableParam();
 
 					for (int j = 0; j < batchnorm_weights.lastDim(); j++)
 					{
@@ -130,7 +130,7 @@ namespace avocado
 						{
 							const int first_dim = prev->getLayer().getWeightShape().firstDim();
 							const int last_dim = prev->getLayer().getWeightShape().volumeWithoutFirstDim();
-							Tensor weight = prev->getLayer().getWeights().getParam().view( { first_dim, last_dim });
+							Tensor weight = prev->getLayer().getWeights().mutableParam().view( { first_dim, last_dim });
 
 							for (int j = 0; j < first_dim; j++)
 							{
@@ -138,7 +138,7 @@ namespace avocado
 								float shift = next->getLayer().getBias().getParam().get<float>( { j });
 								for (int k = 0; k < last_dim; k++)
 									weight.set(weight.get<float>( { j, k }) * scale, { j, k });
-								prev->getLayer().getBias().getParam().set(prev->getLayer().getBias().getParam().get<float>( { j }) * scale + shift, {
+								prev->getLayer().getBias().mutableParam().set(prev->getLayer().getBias().getParam().get<float>( { j }) * scale + shift, {
 										j });
 							}
 							prev->getLayer().setNonlinearity(next->getLayer().getNonlinearity());
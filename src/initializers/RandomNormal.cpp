@@ -40,7 +40,7 @@ namespace avocado
 		std::unique_ptr<float[]> tmp = std::make_unique<float[]>(volume);
 		for (size_t i = 0; i < volume; i++)
 			tmp[i] = scale * math::randGaussian() + m_mean;
-		param.getParam().copyFromHost(tmp.get(), param.shape().volume());
+		param.mutableParam().copyFromHost(tmp.get(), param.shape().volume());
 	}
 
 	std::string RandomNormal::name() const
@@ -34,7 +34,7 @@ namespace avocado
 		std::unique_ptr<float[]> tmp = std::make_unique<float[]>(volume);
 		for (size_t i = 0; i < volume; i++)
 			tmp[i] = m_min + (m_max - m_min) * math::randFloat();
-		param.getParam().copyFromHost(tmp.get(), param.shape().volume());
+		param.mutableParam().copyFromHost(tmp.get(), param.shape().volume());
 	}
 
 	std::string RandomUniform::name() const
@@ -110,13 +110,11 @@ namespace avocado
 			math::reduceTensor(context(), TensorReduceOp::ADD, 1, 1, gradientOut, getBias().getUpdate());
 	}
 
-	void Affine::learn()
+	void Affine::afterLearn()
 	{
-		Layer::learn();
-
 		if (not m_use_weights)
-			math::setTensor(context(), getWeights().getParam(), 1);
+			math::setTensor(context(), getWeights().mutableParam(), 1);
 		if (not m_use_bias)
-			math::setTensor(context(), getBias().getParam(), 0);
+			math::setTensor(context(), getBias().mutableParam(), 0);
 	}
 } /* namespace avocado */
@@ -103,8 +103,8 @@ namespace avocado
 
 	void BatchNormalization::init()
 	{
-		getWeights().getParam().setall(1);
-		getBias().getParam().setall(0);
+		getWeights().mutableParam().setall(1);
+		getBias().mutableParam().setall(0);
 		m_running_mean.zeroall();
 		m_running_variance.zeroall();
 		m_total_steps = 0;
@@ -115,13 +115,13 @@ namespace avocado
 		assert(input.size() == 1);
 
 		const int last_dim = getInputShape().lastDim();
-		Tensor bias = getBias().getParam().view( { last_dim }, last_dim);
-		Tensor scale = getWeights().getParam().view( { last_dim }, last_dim);
+		const Tensor bias = getBias().getParam().view( { last_dim }, last_dim);
+		const Tensor scale = getWeights().getParam().view( { last_dim }, last_dim);
 
 		if (input[0].shape().volumeWithoutLastDim() == 1)
 		{
-			Tensor estimatedMean = getBias().getParam().view( { last_dim });
-			Tensor estimatedVariance = getWeights().getParam().view( { last_dim });
+			const Tensor estimatedMean = getBias().getParam().view( { last_dim });
+			const Tensor estimatedVariance = getWeights().getParam().view( { last_dim });
 			math::batchNormInference(context(), 1, 0, input[0], output, scale, bias, estimatedMean, estimatedVariance, m_epsilon, m_nonlinearity);
 		}
 		else
@@ -143,7 +143,7 @@ namespace avocado
 		const int last_dim = getInputShape().lastDim();
 		Tensor savedMean = m_running_mean.view( { last_dim }, m_running_id * last_dim);
 		Tensor savedVariance = m_running_variance.view( { last_dim }, m_running_id * last_dim);
-		Tensor scale = getWeights().getParam().view( { last_dim }, last_dim);
+		const Tensor scale = getWeights().getParam().view( { last_dim }, last_dim);
 
 		Tensor biasUpdate = getBias().getUpdate().view( { last_dim }, last_dim);
 		Tensor scaleUpdate = getWeights().getUpdate().view( { last_dim }, last_dim);
@@ -151,26 +151,30 @@ namespace avocado
 		math::batchNormBackward(context(), 1, input[0], output, beta, gradientIn[0], gradientOut, scale, savedMean, savedVariance, 1, 1, scaleUpdate,
 				biasUpdate, m_epsilon, m_nonlinearity);
 	}
-	void BatchNormalization::learn()
+	void BatchNormalization::beforeLearn()
 	{
 		const int last_dim = getInputShape().lastDim();
-		Tensor bias = getBias().getParam().view( { last_dim }, last_dim);
-		Tensor scale = getWeights().getParam().view( { last_dim }, last_dim);
+		Tensor bias = getBias().mutableParam().view( { last_dim }, last_dim);
+		Tensor scale = getWeights().mutableParam().view( { last_dim }, last_dim);
 
 		if (!m_use_gamma)
 			math::zeroTensor(context(), scale);
 		if (!m_use_beta)
 			math::zeroTensor(context(), bias);
-
-		Layer::learn();
+	}
+	void BatchNormalization::afterLearn()
+	{
+		const int last_dim = getInputShape().lastDim();
+		Tensor bias = getBias().mutableParam().view( { last_dim }, last_dim);
+		Tensor scale = getWeights().mutableParam().view( { last_dim }, last_dim);
 
 		if (!m_use_gamma)
 			math::setTensor(context(), scale, 1);
 		if (!m_use_beta)
 			math::setTensor(context(), bias, 0);
 
-		Tensor mean = getBias().getParam().view( { last_dim });
-		Tensor variance = getWeights().getParam().view( { last_dim });
+		Tensor mean = getBias().mutableParam().view( { last_dim });
+		Tensor variance = getWeights().mutableParam().view( { last_dim });
 
 		const int tmp = std::min(m_history_size, m_total_steps);
 		math::reduceTensor(context(), TensorReduceOp::AVG, 1, 0, m_running_mean.view( { tmp, last_dim }), mean);
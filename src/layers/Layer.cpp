@@ -108,6 +108,16 @@ namespace avocado
 	{
 		return Shape();
 	}
+	double Layer::estimateFlops(int batchSize) const
+	{
+		Shape output_shape = getOutputShape();
+		output_shape[0] = batchSize;
+		const int weights = getWeightShape().volume();
+		if (weights == 0) // element-wise layer
+			return output_shape.volume();
+		else // every output element is a dot product with a slice of weights
+			return 2.0 * output_shape.volume() * weights / output_shape.lastDim();
+	}
 
 	Device Layer::device() const
 	{
@@ -168,6 +178,31 @@ namespace avocado
 			getBias().moveTo(device());
 	}
 
+	void Layer::shareParametersWith(const Layer &other)
+	{
+		if (name() != other.name())
+			throw LogicError(METHOD_NAME, "cannot share parameters between '" + name() + "' and '" + other.name() + "'");
+		if (device() != other.device())
+			throw DeviceMismatch(METHOD_NAME, device(), other.device());
+
+		if (other.m_weights == nullptr)
+			m_weights = nullptr;
+		else
+		{
+			if (m_weights == nullptr)
+				m_weights = std::make_unique<Parameter>(Shape(), dtype(), device(), other.m_weights->isTrainable());
+			m_weights->shareStorageWith(*other.m_weights);
+		}
+		if (other.m_bias == nullptr)
+			m_bias = nullptr;
+		else
+		{
+			if (m_bias == nullptr)
+				m_bias = std::make_unique<Parameter>(Shape(), dtype(), device(), other.m_bias->isTrainable());
+			m_bias->shareStorageWith(*other.m_bias);
+		}
+	}
+
 	void Layer::init()
 	{
 		getWeights().init(context());
@@ -192,10 +227,18 @@ namespace avocado
 		return *this;
 	}
 
-	void Layer::learn()
+	void Layer::learn(double learningRateMultiplier)
+	{
+		beforeLearn();
+		getWeights().learn(context(), learningRateMultiplier);
+		getBias().learn(context(), learningRateMultiplier);
+		afterLearn();
+	}
+	void Layer::beforeLearn()
+	{
+	}
+	void Layer::afterLearn()
 	{
-		getWeights().learn(context());
-		getBias().learn(context());
 	}
 
 	bool sameId(const Layer &lhs, const Layer &rhs) noexcept
@@ -6,6 +6,9 @@
  */
 
 #include <Avocado/layers/Parameter.hpp>
+#include <Avocado/core/MemoryTracker.hpp>
+#include <Avocado/core/Scalar.hpp>
+#include <Avocado/math/tensor_operations.hpp>
 #include <Avocado/utils/json.hpp>
 #include <Avocado/utils/serialization.hpp>
 
@@ -19,8 +22,12 @@ namespace avocado
 			m_update((other.m_update == nullptr) ? nullptr : std::make_unique<Tensor>(*other.m_update)),
 			m_optimizer((other.m_optimizer == nullptr) ? nullptr : other.m_optimizer->clone()),
 			m_regularizer((other.m_regularizer == nullptr) ? nullptr : other.m_regularizer->clone()),
-			m_initializer(other.m_initializer->clone()),
+			m_initializer((other.m_initializer == nullptr) ? nullptr : other.m_initializer->clone()),
+			m_average((other.m_average == nullptr) ? nullptr : std::make_shared<Tensor>(*other.m_average)),
+			m_average_decay(other.m_average_decay),
+			m_is_average_swapped(other.m_is_average_swapped),
 			m_accumulated_updates(other.m_accumulated_updates),
+			m_gradient_scale(other.m_gradient_scale),
 			m_is_trainable(other.m_is_trainable)
 	{
 	}
@@ -32,31 +39,60 @@ namespace avocado
 			m_update = (other.m_update == nullptr) ? nullptr : std::make_unique<Tensor>(*other.m_update);
 			m_optimizer = (other.m_optimizer == nullptr) ? nullptr : std::unique_ptr<Optimizer>(other.m_optimizer->clone());
 			m_regularizer = (other.m_regularizer == nullptr) ? nullptr : std::unique_ptr<Regularizer>(other.m_regularizer->clone());
-			m_initializer = std::unique_ptr<Initializer>(other.m_initializer->clone());
+			m_initializer = (other.m_initializer == nullptr) ? nullptr : std::unique_ptr<Initializer>(other.m_initializer->clone());
+			m_average = (other.m_average == nullptr) ? nullptr : std::make_shared<Tensor>(*other.m_average);
+			this->m_average_decay = other.m_average_decay;
+			this->m_is_average_swapped = other.m_is_average_swapped;
 			this->m_accumulated_updates = other.m_accumulated_updates;
+			this->m_gradient_scale = other.m_gradient_scale;
 			this->m_is_trainable = other.m_is_trainable;
 		}
 		return *this;
 	}
 
 	Parameter::Parameter(const Json &json, const SerializedObject &binary_data) :
-			m_param(json["param"], binary_data),
+			m_param(std::make_shared<Tensor>(json["param"], binary_data)),
 			m_accumulated_updates(json["accumulated updates"]),
 			m_is_trainable(json["is trainable"])
 	{
+		m_param->setMemoryCategory(MemoryCategory::PARAMETERS);
 		if (!json["update"].isNull())
+		{
 			m_update = std::make_unique<Tensor>(json["update"], binary_data);
+			m_update->setMemoryCategory(MemoryCategory::UPDATES);
+		}
 		if (!json["optimizer"].isNull())
+		{
+			MemoryCategoryScope scope(MemoryCategory::OPTIMIZER_WORKSPACE);
 			m_optimizer = loadOptimizer(json["optimizer"], binary_data);
+		}
 		if (!json["regularizer"].isNull())
 			m_regularizer = loadRegularizer(json["regularizer"], binary_data);
 		m_initializer = loadInitializer(json["initializer"], binary_data);
+		load_average(json, binary_data);
 	}
 	Parameter::Parameter(const Shape &shape, DataType dtype, Device device, bool trainable) :
-			m_param(shape, dtype, device),
+			m_param(std::make_shared<Tensor>(shape, dtype, device)),
 			m_initializer(RandomNormal().clone()),
 			m_is_trainable(trainable)
 	{
+		m_param->setMemoryCategory(MemoryCategory::PARAMETERS);
+	}
+
+	void Parameter::shareStorageWith(const Parameter &other)
+	{
+		m_param = other.m_param;
+		if (m_update != nullptr and m_update->shape() != shape())
+			m_update = nullptr;
+	}
+	bool Parameter::isShared() const noexcept
+	{
+		return m_param.use_count() > 1;
+	}
+	void Parameter::viewSliceOf(Parameter &other, int64_t offset, int length)
+	{
+		m_param = std::make_shared<Tensor>(other.mutableParam().view( { length }, offset));
+		m_update = std::make_unique<Tensor>(other.getUpdate().view( { length }, offset));
 	}
 
 	void Parameter::setTrainable(bool t)
@@ -96,6 +132,67 @@ namespace avocado
 			throw UninitializedObject(METHOD_NAME, "regularizer has not been set");
 		return *m_regularizer;
 	}
+	bool Parameter::hasRegularizer() const noexcept
+	{
+		return m_regularizer != nullptr;
+	}
+	double Parameter::getWeightDecay() const noexcept
+	{
+		return (m_regularizer == nullptr) ? 0.0 : m_regularizer->getWeightDecay();
+	}
+	void Parameter::setAveraging(double decay)
+	{
+		if (decay < 0.0 or decay >= 1.0)
+			throw IllegalArgument(METHOD_NAME, "decay must be in range [0, 1)");
+		if (decay == 0.0)
+		{
+			if (m_is_average_swapped)
+				swapAverage();
+			m_average = nullptr;
+		}
+		else
+		{
+			if (m_average == nullptr)
+			{
+				m_average = std::make_shared<Tensor>(*m_param);
+				m_average->setMemoryCategory(MemoryCategory::PARAMETERS);
+			}
+		}
+		m_average_decay = decay;
+	}
+	double Parameter::getAveragingDecay() const noexcept
+	{
+		return m_average_decay;
+	}
+	bool Parameter::hasAverage() const noexcept
+	{
+		return m_average != nullptr;
+	}
+	Tensor& Parameter::getAverage()
+	{
+		if (m_average == nullptr)
+			throw UninitializedObject(METHOD_NAME, "averaging has not been enabled");
+		return *m_average;
+	}
+	void Parameter::swapAverage()
+	{
+		if (m_average == nullptr)
+			throw UninitializedObject(METHOD_NAME, "averaging has not been enabled");
+		std::swap(m_param, m_average);
+		m_is_average_swapped = not m_is_average_swapped;
+	}
+	bool Parameter::isAverageSwapped() const noexcept
+	{
+		return m_is_average_swapped;
+	}
+	void Parameter::setGradientScale(double scale) noexcept
+	{
+		m_gradient_scale = scale;
+	}
+	double Parameter::getGradientScale() const noexcept
+	{
+		return m_gradient_scale;
+	}
 
 	void Parameter::setInitializer(const Initializer &initializer) noexcept
 	{
@@ -132,11 +229,12 @@ namespace avocado
 
 	const Tensor& Parameter::getParam() const
 	{
-		return m_param;
+		return *m_param;
 	}
-	Tensor& Parameter::getParam()
+	Tensor& Parameter::mutableParam()
 	{
-		return m_param;
+		detach();
+		return *m_param;
 	}
 	Tensor& Parameter::getUpdate()
 	{
@@ -144,34 +242,64 @@ namespace avocado
 			throw LogicError(METHOD_NAME, "parameter is set as non-trainable");
 
 		if (m_update == nullptr)
+		{
 			m_update = std::make_unique<Tensor>(shape(), dtype(), device());
+			m_update->setMemoryCategory(MemoryCategory::UPDATES);
+		}
 		return *m_update;
 	}
 
 	void Parameter::moveTo(Device newDevice)
 	{
-		m_param.moveTo(newDevice);
+		if (device() != newDevice)
+		{
+			detach();
+			m_param->moveTo(newDevice);
+		}
 		if (m_update != nullptr)
 			m_update->moveTo(newDevice);
 		if (m_optimizer != nullptr)
 			m_optimizer->moveTo(newDevice);
+		if (m_average != nullptr)
+			m_average->moveTo(newDevice);
 	}
 	void Parameter::convertTo(const Context &context, DataType newType)
 	{
-		m_param.convertTo(newType);
+		if (dtype() != newType)
+		{
+			detach();
+			m_param->convertTo(newType);
+			if (m_average != nullptr)
+				m_average->convertTo(newType);
+		}
 	}
 	void Parameter::init(const Context &context)
 	{
 		if (isTrainable())
+		{
+			detach();
 			getInitializer().init(*this);
+		}
 	}
-	void Parameter::learn(const Context &context)
+	void Parameter::learn(const Context &context, double learningRateMultiplier)
 	{
+		if (m_is_average_swapped)
+			throw LogicError(METHOD_NAME, "cannot learn while the average is swapped in");
 		if (isTrainable())
 		{
-			if (m_regularizer != nullptr)
+			detach();
+			if (m_regularizer != nullptr and getWeightDecay() == 0.0)
+			{
+				if (m_gradient_scale != 1.0)
+				{ // penalty added by the regularizer must not be scaled
+					math::scaleTensor(context, getUpdate(), m_gradient_scale);
+					m_gradient_scale = 1.0;
+				}
 				getRegularizer().apply(context, *this);
-			getOptimizer().learn(context, *this);
+			}
+			MemoryCategoryScope scope(MemoryCategory::OPTIMIZER_WORKSPACE);
+			getOptimizer().learn(context, *this, learningRateMultiplier);
+			m_gradient_scale = 1.0;
 		}
 	}
 
@@ -180,27 +308,59 @@ namespace avocado
 		Json result;
 		result["is trainable"] = m_is_trainable;
 		result["accumulated updates"] = m_accumulated_updates;
-		result["param"] = m_param.serialize(binary_data);
+		result["param"] = m_param->serialize(binary_data);
 		result["update"] = (m_update == nullptr) ? Json() : m_update->serialize(binary_data);
 		result["optimizer"] = (m_optimizer == nullptr) ? Json() : m_optimizer->serialize(binary_data);
 		result["regularizer"] = (m_regularizer == nullptr) ? Json() : m_regularizer->serialize(binary_data);
 		result["initializer"] = (m_initializer == nullptr) ? Json() : m_initializer->serialize(binary_data);
+		result["average"] = (m_average == nullptr) ? Json() : m_average->serialize(binary_data);
+		result["average decay"] = m_average_decay;
+		result["is average swapped"] = m_is_average_swapped;
 
 		return result;
 	}
 	void Parameter::unserialize(const Json &json, const SerializedObject &binary_data)
 	{
-		m_param.unserialize(json["param"], binary_data);
+		if (isShared()) // the values are overwritten anyway, so the shared tensor does not have to be copied
+			m_param = std::make_shared<Tensor>(shape(), dtype(), device());
+		m_param->unserialize(json["param"], binary_data);
+		m_param->setMemoryCategory(MemoryCategory::PARAMETERS);
 		m_accumulated_updates = json["accumulated updates"];
 		m_is_trainable = json["is trainable"];
 		if (!json["update"].isNull())
+		{
 			m_update = std::make_unique<Tensor>(json["update"], binary_data);
+			m_update->setMemoryCategory(MemoryCategory::UPDATES);
+		}
 		if (!json["optimizer"].isNull())
+		{
+			MemoryCategoryScope scope(MemoryCategory::OPTIMIZER_WORKSPACE);
 			m_optimizer = loadOptimizer(json["optimizer"], binary_data);
+		}
 		if (!json["regularizer"].isNull())
 			m_regularizer = loadRegularizer(json["regularizer"], binary_data);
 		if (!json["initializer"].isNull())
 			m_initializer = loadInitializer(json["initializer"], binary_data);
+		load_average(json, binary_data);
+	}
+
+	void Parameter::detach()
+	{
+		if (isShared())
+			m_param = std::make_shared<Tensor>(*m_param);
+	}
+	void Parameter::load_average(const Json &json, const SerializedObject &binary_data)
+	{
+		m_average = nullptr;
+		m_average_decay = 0.0;
+		m_is_average_swapped = false;
+		if (json.hasKey("average") and not json["average"].isNull())
+		{
+			m_average = std::make_shared<Tensor>(json["average"], binary_data);
+			m_average->setMemoryCategory(MemoryCategory::PARAMETERS);
+			m_average_decay = json["average decay"].getDouble();
+			m_is_average_swapped = json["is average swapped"].getBool();
+		}
 	}
 
 } /* namespace avocado */
@@ -9,6 +9,7 @@
 #include <Avocado/core/Scalar.hpp>
 #include <Avocado/layers/Layer.hpp>
 #include <Avocado/math/training.hpp>
+#include <Avocado/utils/json.hpp>
 #include <Avocado/utils/static_block.hpp>
 
 namespace avocado
@@ -18,10 +19,19 @@ namespace avocado
 		registerLossFunction(CrossEntropyLoss());
 	}
 
+	CrossEntropyLoss::CrossEntropyLoss(TargetFormat targetFormat)
+	{
+		m_target_format = targetFormat;
+	}
+
 	bool CrossEntropyLoss::tryCombineWith(const Layer &layer) noexcept
 	{
 		if (layer.name() == "Softmax")
+		{
 			m_is_combined_with_layer = true;
+			m_is_combined_with_softmax = true;
+			m_softmax_mode = softmaxModeFromString(layer.getConfig()["mode"]);
+		}
 		if (layer.name() == "Activation" and layer.getNonlinearity() == NonlinearityType::SIGMOID)
 			m_is_combined_with_layer = true;
 		return m_is_combined_with_layer;
@@ -33,11 +43,43 @@ namespace avocado
 		const double result = scale * math::calcLossFunction(context, LossType::CROSS_ENTROPY_LOSS, output, target).get<double>();
 		return Scalar(result);
 	}
+	void CrossEntropyLoss::getFusedLossAndGradient(const Context &context, Tensor &gradient, const Tensor &input, Tensor &output,
+			const Tensor &target, Tensor &accumulator) const
+	{
+		if (not m_is_combined_with_softmax)
+			return LossFunction::getFusedLossAndGradient(context, gradient, input, output, target, accumulator);
+		const double scale = 1.0 / output.firstDim();
+		math::softmaxCrossEntropy(context, m_softmax_mode, scale, 0, input, output, gradient, target, scale, accumulator);
+	}
 	void CrossEntropyLoss::getGradient(const Context &context, Tensor &gradient, const Tensor &output, const Tensor &target) const
 	{
 		const double scale = 1.0 / output.firstDim();
 		math::calcLossGradient(context, LossType::CROSS_ENTROPY_LOSS, scale, 1, gradient, output, target, m_is_combined_with_layer);
 	}
+	void CrossEntropyLoss::getGradientAndAccumulateLoss(const Context &context, Tensor &gradient, const Tensor &output, const Tensor &target,
+			Tensor &accumulator) const
+	{
+		const double scale = 1.0 / output.firstDim();
+		math::calcLossGradientAndAccumulate(context, LossType::CROSS_ENTROPY_LOSS, scale, 1, gradient, output, target,
+				m_is_combined_with_layer, scale, accumulator);
+	}
+	bool CrossEntropyLoss::isGradientAveragedOverBatch() const noexcept
+	{
+		return true;
+	}
+	bool CrossEntropyLoss::isFusedWithLayer() const noexcept
+	{
+		return m_is_combined_with_softmax;
+	}
+	Scalar CrossEntropyLoss::getFusedLossAndGradient(const Context &context, Tensor &gradient, const Tensor &input, Tensor &output,
+			const Tensor &target) const
+	{
+		if (not m_is_combined_with_softmax)
+			return LossFunction::getFusedLossAndGradient(context, gradient, input, output, target);
+		const double scale = 1.0 / output.firstDim();
+		const double result = scale * math::softmaxCrossEntropy(context, m_softmax_mode, scale, 0, input, output, gradient, target).get<double>();
+		return Scalar(result);
+	}
 
 	std::string CrossEntropyLoss::name() const
 	{
@@ -45,7 +87,7 @@ namespace avocado
 	}
 	CrossEntropyLoss* CrossEntropyLoss::clone() const
 	{
-		return new CrossEntropyLoss();
+		return new CrossEntropyLoss(m_target_format);
 	}
 
 } /* namespace avocado */
@@ -18,6 +18,11 @@ namespace avocado
 		registerLossFunction(KLDivergenceLoss());
 	}
 
+	KLDivergenceLoss::KLDivergenceLoss(TargetFormat targetFormat)
+	{
+		m_target_format = targetFormat;
+	}
+
 	bool KLDivergenceLoss::tryCombineWith(const Layer &layer) noexcept
 	{
 		if (layer.name() == "Softmax")
@@ -37,6 +42,13 @@ namespace avocado
 	{
 		math::calcLossGradient(context, LossType::KL_DIVERGECE_LOSS, 1, 1, gradient, output, target, m_is_combined_with_layer);
 	}
+	void KLDivergenceLoss::getGradientAndAccumulateLoss(const Context &context, Tensor &gradient, const Tensor &output, const Tensor &target,
+			Tensor &accumulator) const
+	{
+		const double scale = 1.0 / output.firstDim();
+		math::calcLossGradientAndAccumulate(context, LossType::KL_DIVERGECE_LOSS, 1, 1, gradient, output, target,
+				m_is_combined_with_layer, scale, accumulator);
+	}
 
 	std::string KLDivergenceLoss::name() const
 	{
@@ -44,7 +56,7 @@ namespace avocado
 	}
 	KLDivergenceLoss* KLDivergenceLoss::clone() const
 	{
-		return new KLDivergenceLoss();
+		return new KLDivergenceLoss(m_target_format);
 	}
 
 } /* namespace avocado */
@@ -7,6 +7,9 @@
 
 #include <Avocado/losses/LossFunction.hpp>
 #include <Avocado/layers/Layer.hpp>
+#include <Avocado/core/Scalar.hpp>
+#include <Avocado/core/Tensor.hpp>
+#include <Avocado/math/tensor_operations.hpp>
 #include <Avocado/utils/json.hpp>
 #include <Avocado/core/error_handling.hpp>
 
@@ -23,17 +26,91 @@ namespace
 
 namespace avocado
 {
+	std::string toString(TargetFormat format)
+	{
+		switch (format)
+		{
+			default:
+			case TargetFormat::DENSE:
+				return "dense";
+			case TargetFormat::CLASS_INDEX:
+				return "class index";
+		}
+	}
+	TargetFormat targetFormatFromString(const std::string &str)
+	{
+		if (str == "dense")
+			return TargetFormat::DENSE;
+		if (str == "class index")
+			return TargetFormat::CLASS_INDEX;
+		throw LogicError(METHOD_NAME, "unknown target format '" + str + "'");
+	}
+
 	bool LossFunction::tryCombineWith(const Layer &layer) noexcept
 	{
 		return false;
 	}
 
+	TargetFormat LossFunction::targetFormat() const noexcept
+	{
+		return m_target_format;
+	}
+	Shape LossFunction::getTargetShape(const Shape &outputShape) const
+	{
+		if (m_target_format == TargetFormat::DENSE)
+			return outputShape;
+		if (outputShape.rank() < 2)
+			throw ShapeMismatch(METHOD_NAME, "class index target requires output with at least two dimensions");
+		std::vector<int> dims(outputShape.rank() - 1);
+		for (size_t i = 0; i < dims.size(); i++)
+			dims[i] = outputShape[i];
+		return Shape(dims);
+	}
+	DataType LossFunction::getTargetType(DataType outputType) const noexcept
+	{
+		return (m_target_format == TargetFormat::DENSE) ? outputType : DataType::INT32;
+	}
+	void LossFunction::getGradientAndAccumulateLoss(const Context &context, Tensor &gradient, const Tensor &output, const Tensor &target,
+			Tensor &accumulator) const
+	{
+		getGradient(context, gradient, output, target);
+		Tensor loss( { 1 }, accumulator.dtype(), accumulator.device());
+		math::setTensor(context, loss, getLoss(context, output, target));
+		math::addTensors(context, accumulator, loss, 1, 1);
+	}
+	bool LossFunction::isGradientAveragedOverBatch() const noexcept
+	{
+		return false;
+	}
+	bool LossFunction::isFusedWithLayer() const noexcept
+	{
+		return false;
+	}
+	Scalar LossFunction::getFusedLossAndGradient(const Context &context, Tensor &gradient, const Tensor &input, Tensor &output,
+			const Tensor &target) const
+	{
+		throw LogicError(METHOD_NAME, "loss function '" + name() + "' is not fused with any layer");
+	}
+	void LossFunction::getFusedLossAndGradient(const Context &context, Tensor &gradient, const Tensor &input, Tensor &output,
+			const Tensor &target, Tensor &accumulator) const
+	{
+		const Scalar loss = getFusedLossAndGradient(context, gradient, input, output, target);
+		Tensor tmp( { 1 }, accumulator.dtype(), accumulator.device());
+		math::setTensor(context, tmp, loss);
+		math::addTensors(context, accumulator, tmp, 1, 1);
+	}
+
 	Json LossFunction::serialize(SerializedObject &binary_data) const
 	{
-		return Json( { { "name", this->name() } });
+		Json result( { { "name", this->name() } });
+		if (m_target_format != TargetFormat::DENSE)
+			result["target format"] = toString(m_target_format);
+		return result;
 	}
 	void LossFunction::unserialize(const Json &json, const SerializedObject &binary_data)
 	{
+		if (json.hasKey("target format"))
+			m_target_format = targetFormatFromString(json["target format"]);
 	}
 
 	void registerLossFunction(const LossFunction &loss)
@@ -29,6 +29,12 @@ namespace avocado
 	{
 		math::calcLossGradient(context, LossType::MEAN_SQUARE_LOSS, 1, 1, gradient, output, target, false);
 	}
+	void MeanSquareLoss::getGradientAndAccumulateLoss(const Context &context, Tensor &gradient, const Tensor &output, const Tensor &target,
+			Tensor &accumulator) const
+	{
+		const double scale = 1.0 / output.firstDim();
+		math::calcLossGradientAndAccumulate(context, LossType::MEAN_SQUARE_LOSS, 1, 1, gradient, output, target, false, scale, accumulator);
+	}
 
 	std::string MeanSquareLoss::name() const
 	{
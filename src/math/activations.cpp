@@ -9,6 +9,8 @@
 #include <Avocado/core/Context.hpp>
 #include <Avocado/core/Tensor.hpp>
 #include <Avocado/core/Scalar.hpp>
+#include <Avocado/math/fast_math.hpp>
+#include <Avocado/math/instrumentation.hpp>
 #include <Avocado/backend/backend_libraries.hpp>
 
 namespace avocado
@@ -118,8 +120,11 @@ namespace avocado
 	{
 		void activationForwardInPlace(const Context &context, NonlinearityType activation, Tensor &output)
 		{
+			internal::OperationScope scope(__func__, context, output);
 			if (not same_device(context, output))
 				throw DeviceMismatch(METHOD_NAME, "");
+			if (internal::fast_activation_forward(context, activation, Scalar(1.0f), output, Scalar(0.0f), output))
+				return;
 
 			backend::avActivationType_t act = static_cast<backend::avActivationType_t>(activation);
 			backend::avTensorDescriptor_t yDesc = output.getDescriptor();
@@ -148,6 +153,7 @@ namespace avocado
 		}
 		void activationBackwardInPlace(const Context &context, NonlinearityType activation, const Tensor &output, Tensor &gradientOut)
 		{
+			internal::OperationScope scope(__func__, context, output, gradientOut);
 			if (not same_device(context, output, gradientOut))
 				throw DeviceMismatch(METHOD_NAME, "");
 
@@ -187,11 +193,14 @@ namespace avocado
 
 		void activationForward(const Context &context, NonlinearityType activation, Scalar alpha, const Tensor &input, Scalar beta, Tensor &output)
 		{
+			internal::OperationScope scope(__func__, context, input, output);
 			if (not same_device(context, input, output))
 				throw DeviceMismatch(METHOD_NAME, "");
 
 			alpha.toScalingTypeFor(output.dtype());
 			beta.toScalingTypeFor(output.dtype());
+			if (internal::fast_activation_forward(context, activation, alpha, input, beta, output))
+				return;
 			backend::avActivationType_t act = static_cast<backend::avActivationType_t>(activation);
 
 			backend::avTensorDescriptor_t xDesc = input.getDescriptor();
@@ -224,6 +233,7 @@ namespace avocado
 		void activationBackward(const Context &context, NonlinearityType activation, Scalar alpha, const Tensor &output, const Tensor &gradientOut,
 				Scalar beta, Tensor &gradientIn)
 		{
+			internal::OperationScope scope(__func__, context, output, gradientOut, gradientIn);
 			if (not same_device(context, output, gradientOut, gradientIn))
 				throw DeviceMismatch(METHOD_NAME, "");
 
@@ -267,11 +277,14 @@ namespace avocado
 
 		void softmaxForward(const Context &context, SoftmaxMode mode, Scalar alpha, const Tensor &input, Scalar beta, Tensor &output)
 		{
+			internal::OperationScope scope(__func__, context, input, output);
 			if (not same_device(context, input, output))
 				throw DeviceMismatch(METHOD_NAME, "");
 
 			alpha.toScalingTypeFor(output.dtype());
 			beta.toScalingTypeFor(output.dtype());
+			if (internal::fast_softmax_forward(context, mode, alpha, input, beta, output))
+				return;
 			backend::avSoftmaxMode_t _mode = static_cast<backend::avSoftmaxMode_t>(mode);
 
 			backend::avTensorDescriptor_t xDesc = input.getDescriptor();
@@ -304,6 +317,7 @@ namespace avocado
 		void softmaxBackward(const Context &context, SoftmaxMode mode, Scalar alpha, const Tensor &output, const Tensor &gradientOut, Scalar beta,
 				Tensor &gradientIn)
 		{
+			internal::OperationScope scope(__func__, context, output, gradientOut, gradientIn);
 			if (not same_device(context, output, gradientOut, gradientIn))
 				throw DeviceMismatch(METHOD_NAME, "");
 
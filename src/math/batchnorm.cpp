@@ -9,6 +9,7 @@
 #include <Avocado/core/Context.hpp>
 #include <Avocado/core/Tensor.hpp>
 #include <Avocado/core/Scalar.hpp>
+#include <Avocado/math/instrumentation.hpp>
 #include <Avocado/backend/backend_libraries.hpp>
 
 namespace avocado
@@ -18,6 +19,7 @@ namespace avocado
 		void affineForward(const Context &context, Scalar alpha, Scalar beta, const Tensor &input, Tensor &output, const Tensor &weight,
 				const Tensor &bias, NonlinearityType activation)
 		{
+			internal::OperationScope scope(__func__, context, input, output, weight, bias);
 			if (not same_device(context, input, output, weight, bias))
 				throw DeviceMismatch(METHOD_NAME, "");
 
@@ -63,6 +65,7 @@ namespace avocado
 		void batchNormInference(const Context &context, Scalar alpha, Scalar beta, const Tensor &input, Tensor &output, const Tensor &scale,
 				const Tensor &bias, const Tensor &estimatedMean, const Tensor &estimatedVariance, double epsilon, NonlinearityType activation)
 		{
+			internal::OperationScope scope(__func__, context, input, output, scale, bias, estimatedMean, estimatedVariance);
 			if (not same_device(context, input, output, scale, bias, estimatedMean, estimatedVariance))
 				throw DeviceMismatch(METHOD_NAME, "");
 			if (not same_shape(scale, bias, estimatedMean, estimatedVariance))
@@ -111,6 +114,7 @@ namespace avocado
 		void batchNormForward(const Context &context, Scalar alpha, Scalar beta, const Tensor &input, Tensor &output, const Tensor &scale,
 				const Tensor &bias, Tensor &savedMean, Tensor &savedVariance, double epsilon, NonlinearityType activation)
 		{
+			internal::OperationScope scope(__func__, context, input, output, scale, bias, savedMean, savedVariance);
 			if (not same_device(context, input, output, scale, bias, savedMean, savedVariance))
 				throw DeviceMismatch(METHOD_NAME, "");
 			if (not same_shape(scale, bias, savedMean, savedVariance))
@@ -160,6 +164,7 @@ namespace avocado
 				Tensor &gradientOut, const Tensor &scale, const Tensor &mean, const Tensor &variance, Scalar alpha2, Scalar beta2,
 				Tensor &scaleUpdate, Tensor &biasUpdate, double epsilon, NonlinearityType activation)
 		{
+			internal::OperationScope scope(__func__, context, input, output, gradientIn, gradientOut, scale, mean, variance, scaleUpdate, biasUpdate);
 			if (not same_device(context, input, output, scale, mean, variance, scaleUpdate, biasUpdate))
 				throw DeviceMismatch(METHOD_NAME, "");
 			if (not same_shape(scale, mean, variance, scaleUpdate, biasUpdate))
@@ -9,6 +9,7 @@
 #include <Avocado/core/Context.hpp>
 #include <Avocado/core/Tensor.hpp>
 #include <Avocado/core/error_handling.hpp>
+#include <Avocado/math/instrumentation.hpp>
 #include <Avocado/backend/backend_libraries.hpp>
 
 namespace avocado
@@ -24,6 +25,7 @@ namespace avocado
 
 		void changeType(const Context &context, Tensor &dst, const Tensor &src)
 		{
+			internal::OperationScope scope(__func__, context, dst, src);
 			if (not same_device(context, dst, src))
 				throw DeviceMismatch(METHOD_NAME, "");
 
@@ -58,6 +60,7 @@ namespace avocado
 		}
 		void changeType(const Context &context, const Tensor &tensor, DataType dstType)
 		{
+			internal::OperationScope scope(__func__, context, tensor);
 			if (not same_device(context, tensor))
 				throw DeviceMismatch(METHOD_NAME, "");
 			backend::avMemoryDescriptor_t srcMem = tensor.getMemory();
@@ -35,6 +35,11 @@ namespace
 				throw LogicError(METHOD_NAME, "invalid descriptor");
 		}
 	}
+	internal::AllocationStats& allocation_stats() noexcept
+	{
+		thread_local internal::AllocationStats stats;
+		return stats;
+	}
 }
 
 namespace avocado
@@ -43,6 +48,11 @@ namespace avocado
 	{
 		using namespace avocado::backend;
 
+		const AllocationStats& getAllocationStats() noexcept
+		{
+			return allocation_stats();
+		}
+
 		/*
 		 * Memory descriptor wrapper.
 		 */
@@ -69,6 +79,11 @@ namespace avocado
 					break;
 				}
 			}
+			allocation_stats().allocations++;
+			allocation_stats().allocatedBytes += sizeInBytes;
+			m_allocated_bytes = sizeInBytes;
+			m_category = MemoryTracker::currentCategory();
+			MemoryTracker::allocated(device, m_category, m_allocated_bytes);
 		}
 		MemoryDescWrapper::MemoryDescWrapper(const MemoryDescWrapper &desc, size_t sizeInBytes, size_t offsetInBytes)
 		{
@@ -95,19 +110,26 @@ namespace avocado
 			}
 		}
 		MemoryDescWrapper::MemoryDescWrapper(MemoryDescWrapper &&other) :
-				m_descriptor(other.m_descriptor)
+				m_descriptor(other.m_descriptor),
+				m_allocated_bytes(other.m_allocated_bytes),
+				m_category(other.m_category)
 		{
 			other.m_descriptor = AVOCADO_NULL_DESCRIPTOR;
+			other.m_allocated_bytes = 0;
 		}
 		MemoryDescWrapper& MemoryDescWrapper::operator=(MemoryDescWrapper &&other)
 		{
 			std::swap(this->m_descriptor, other.m_descriptor);
+			std::swap(this->m_allocated_bytes, other.m_allocated_bytes);
+			std::swap(this->m_category, other.m_category);
 			return *this;
 		}
 		MemoryDescWrapper::~MemoryDescWrapper()
 		{
 			if (m_descriptor == AVOCADO_NULL_DESCRIPTOR)
 				return;
+			if (m_allocated_bytes > 0)
+				MemoryTracker::freed(device(), m_category, m_allocated_bytes);
 			avStatus_t status = AVOCADO_STATUS_SUCCESS;
 			switch (device().type())
 			{
@@ -131,6 +153,16 @@ namespace avocado
 		{
 			return get_device(m_descriptor);
 		}
+		MemoryCategory MemoryDescWrapper::category() const noexcept
+		{
+			return m_category;
+		}
+		void MemoryDescWrapper::setCategory(MemoryCategory category) noexcept
+		{
+			if (m_allocated_bytes > 0)
+				MemoryTracker::changeCategory(device(), m_category, category, m_allocated_bytes);
+			m_category = category;
+		}
 
 		/*
 		 * Tensor descriptor wrapper.
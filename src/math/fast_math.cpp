@@ -0,0 +1,428 @@
+/*
+ * fast_math.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <Avocado/math/fast_math.hpp>
+#include <Avocado/math/activations.hpp>
+#include <Avocado/core/Device.hpp>
+#include <Avocado/core/Tensor.hpp>
+#include <Avocado/core/Scalar.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace
+{
+	using namespace avocado;
+
+	/*
+	 * Kernels are written once with generic vectors and inlined into functions compiled for each instruction set.
+	 * Default instantiation uses 4 lanes (SSE2 on x86-64), while AVX2 and AVX-512 versions use 8 and 16 lanes.
+	 * Vectors are modified in place so that no function takes or returns them by value, which would depend on the target ABI.
+	 */
+	typedef float f32x4 __attribute__((vector_size(16)));
+	typedef int32_t i32x4 __attribute__((vector_size(16)));
+	typedef float f32x8 __attribute__((vector_size(32)));
+	typedef int32_t i32x8 __attribute__((vector_size(32)));
+	typedef float f32x16 __attribute__((vector_size(64)));
+	typedef int32_t i32x16 __attribute__((vector_size(64)));
+
+	enum class Function
+	{
+		EXP, LOG, TANH, SIGMOID
+	};
+
+	const size_t block_size = 1024; // number of elements processed by a thread at once
+	const float infinity = std::numeric_limits<float>::infinity();
+
+	/*
+	 * Range reduction exp(x) = 2^n * exp(r) with |r| <= ln(2)/2.
+	 * FAST uses minimax polynomial of degree 7 from Cephes (about 1 ulp), FASTEST uses Taylor series of degree 4 (below 6e-5 relative error).
+	 */
+	template<typename F, typename I, bool Fastest>
+	__attribute__((always_inline)) inline void vector_exp(F &x) noexcept
+	{
+		const float max_input = 88.72283f;
+		const float min_input = -87.33654f; // smaller inputs would give denormal result
+		const F zero = F { };
+		const F input = x;
+		x = (x > max_input) ? zero + max_input : x;
+		x = (x < min_input) ? zero + min_input : x;
+
+		const F t = x * 1.44269504088896341f;
+		const I n = __builtin_convertvector(t + ((t < 0.0f) ? zero - 0.5f : zero + 0.5f), I);
+		const F fn = __builtin_convertvector(n, F);
+		F r = x - fn * 0.693359375f;
+		r = r - fn * -2.12194440e-4f;
+
+		F p;
+		if (Fastest)
+		{
+			p = zero + 4.16666667e-2f;
+			p = p * r + 1.66666667e-1f;
+			p = p * r + 0.5f;
+		}
+		else
+		{
+			p = zero + 1.9875691500e-4f;
+			p = p * r + 1.3981999507e-3f;
+			p = p * r + 8.3334519073e-3f;
+			p = p * r + 4.1665795894e-2f;
+			p = p * r + 1.6666665459e-1f;
+			p = p * r + 5.0000001201e-1f;
+		}
+		p = p * r * r + r + 1.0f;
+
+		// 2^n is applied in two steps so that n = 128 does not overflow the exponent field
+		const I n1 = n >> 1;
+		const I n2 = n - n1;
+		x = p * reinterpret_cast<F>((n1 + 127) << 23) * reinterpret_cast<F>((n2 + 127) << 23);
+		x = (input > max_input) ? zero + infinity : x;
+		x = (input < min_input) ? zero : x;
+	}
+	/*
+	 * log(x) = e * ln(2) + log(m) with sqrt(0.5) <= m < sqrt(2).
+	 * FAST uses polynomial from Cephes (about 1 ulp), FASTEST uses series 2 * atanh(s) with three terms (below 4e-6 relative error).
+	 */
+	template<typename F, typename I, bool Fastest>
+	__attribute__((always_inline)) inline void vector_log(F &x) noexcept
+	{
+		const F zero = F { };
+		const I is_denormal = (x < std::numeric_limits<float>::min());
+		const I bits = reinterpret_cast<I>(is_denormal ? x * 8388608.0f : x); // denormals are scaled by 2^23
+
+		I e = ((bits >> 23) & 0xff) - 126;
+		e = is_denormal ? e - 23 : e;
+		F m = reinterpret_cast<F>((bits & 0x807fffff) | 0x3f000000); // in [0.5, 1)
+		const I is_small = (m < 0.707106781186547524f);
+		m = is_small ? m + m : m;
+		e = is_small ? e - 1 : e;
+		m = m - 1.0f;
+		const F fe = __builtin_convertvector(e, F);
+
+		F result;
+		if (Fastest)
+		{
+			const F s = m / (m + 2.0f);
+			const F s2 = s * s;
+			result = (s + s) * ((s2 * 0.2f + 0.333333333f) * s2 + 1.0f);
+			result = result + fe * 0.693147181f;
+		}
+		else
+		{
+			const F z = m * m;
+			F y = zero + 7.0376836292e-2f;
+			y = y * m - 1.1514610310e-1f;
+			y = y * m + 1.1676998740e-1f;
+			y = y * m - 1.2420140846e-1f;
+			y = y * m + 1.4249322787e-1f;
+			y = y * m - 1.6668057665e-1f;
+			y = y * m + 2.0000714765e-1f;
+			y = y * m - 2.4999993993e-1f;
+			y = y * m + 3.3333331174e-1f;
+			y = y * m * z;
+			y = y + fe * -2.12194440e-4f;
+			y = y - z * 0.5f;
+			result = m + y;
+			result = result + fe * 0.693359375f;
+		}
+		result = (x == infinity) ? x : result;
+		result = (x == 0.0f) ? zero - infinity : result;
+		x = ((x < 0.0f) | (x != x)) ? zero + std::numeric_limits<float>::quiet_NaN() : result;
+	}
+	/*
+	 * Small arguments use odd polynomial from Cephes to avoid cancellation, larger ones use tanh(x) = 1 - 2 / (exp(2x) + 1).
+	 */
+	template<typename F, typename I, bool Fastest>
+	__attribute__((always_inline)) inline void vector_tanh(F &x) noexcept
+	{
+		const I sign = reinterpret_cast<I>(x) & static_cast<int32_t>(0x80000000u);
+		const F abs_x = reinterpret_cast<F>(reinterpret_cast<I>(x) & 0x7fffffff);
+
+		const F z = x * x;
+		F small = F { } - 5.70498872745e-3f;
+		small = small * z + 2.06390887954e-2f;
+		small = small * z - 5.37397155531e-2f;
+		small = small * z + 1.33314422036e-1f;
+		small = small * z - 3.33332819422e-1f;
+		small = small * z * x + x;
+
+		F large = abs_x + abs_x;
+		vector_exp<F, I, Fastest>(large);
+		large = reinterpret_cast<F>(reinterpret_cast<I>(1.0f - 2.0f / (large + 1.0f)) | sign);
+		x = (abs_x < 0.625f) ? small : large;
+	}
+	template<typename F, typename I, bool Fastest>
+	__attribute__((always_inline)) inline void vector_sigmoid(F &x) noexcept
+	{
+		x = -x;
+		vector_exp<F, I, Fastest>(x);
+		x = 1.0f / (1.0f + x);
+	}
+
+	template<typename F, typename I, Function Func, bool Fastest>
+	__attribute__((always_inline)) inline void apply_function(F &x) noexcept
+	{
+		switch (Func)
+		{
+			case Function::EXP:
+				vector_exp<F, I, Fastest>(x);
+				break;
+			case Function::LOG:
+				vector_log<F, I, Fastest>(x);
+				break;
+			case Function::TANH:
+				vector_tanh<F, I, Fastest>(x);
+				break;
+			case Function::SIGMOID:
+				vector_sigmoid<F, I, Fastest>(x);
+				break;
+		}
+	}
+	template<typename F, typename I, Function Func, bool Fastest>
+	__attribute__((always_inline)) inline void apply_to_array(const float *src, float *dst, size_t elements) noexcept
+	{
+		const size_t length = sizeof(F) / sizeof(float);
+		size_t i = 0;
+		for (; i + length <= elements; i += length)
+		{
+			F x;
+			std::memcpy(&x, src + i, sizeof(F));
+			apply_function<F, I, Func, Fastest>(x);
+			std::memcpy(dst + i, &x, sizeof(F));
+		}
+		if (i < elements)
+		{ // remaining elements are processed in a zero-padded vector
+			F x = F { };
+			std::memcpy(&x, src + i, (elements - i) * sizeof(float));
+			apply_function<F, I, Func, Fastest>(x);
+			std::memcpy(dst + i, &x, (elements - i) * sizeof(float));
+		}
+	}
+	template<typename F, typename I>
+	__attribute__((always_inline)) inline void dispatch(Function function, bool fastest, const float *src, float *dst, size_t elements) noexcept
+	{
+		switch (function)
+		{
+			case Function::EXP:
+				fastest ? apply_to_array<F, I, Function::EXP, true>(src, dst, elements) : apply_to_array<F, I, Function::EXP, false>(src, dst, elements);
+				break;
+			case Function::LOG:
+				fastest ? apply_to_array<F, I, Function::LOG, true>(src, dst, elements) : apply_to_array<F, I, Function::LOG, false>(src, dst, elements);
+				break;
+			case Function::TANH:
+				fastest ?
+						apply_to_array<F, I, Function::TANH, true>(src, dst, elements) : apply_to_array<F, I, Function::TANH, false>(src, dst, elements);
+				break;
+			case Function::SIGMOID:
+				fastest ?
+						apply_to_array<F, I, Function::SIGMOID, true>(src, dst, elements) :
+						apply_to_array<F, I, Function::SIGMOID, false>(src, dst, elements);
+				break;
+		}
+	}
+
+	typedef void (*Kernel)(Function, bool, const float*, float*, size_t);
+
+	void kernel_default(Function function, bool fastest, const float *src, float *dst, size_t elements) noexcept
+	{
+		dispatch<f32x4, i32x4>(function, fastest, src, dst, elements);
+	}
+#if defined(__x86_64__) or defined(__i386__)
+	__attribute__((target("avx2,fma"))) void kernel_avx2(Function function, bool fastest, const float *src, float *dst, size_t elements) noexcept
+	{
+		dispatch<f32x8, i32x8>(function, fastest, src, dst, elements);
+	}
+	__attribute__((target("avx512f"))) void kernel_avx512(Function function, bool fastest, const float *src, float *dst, size_t elements) noexcept
+	{
+		dispatch<f32x16, i32x16>(function, fastest, src, dst, elements);
+	}
+#endif
+	Kernel select_kernel()
+	{
+#if defined(__x86_64__) or defined(__i386__)
+		const CpuSimd simd = Device::cpu().simd();
+		if (simd >= CpuSimd::AVX512F)
+			return kernel_avx512;
+		if (simd >= CpuSimd::AVX2)
+			return kernel_avx2;
+#endif
+		return kernel_default;
+	}
+
+	float exact_function(Function function, float x) noexcept
+	{
+		switch (function)
+		{
+			default:
+			case Function::EXP:
+				return std::exp(x);
+			case Function::LOG:
+				return std::log(x);
+			case Function::TANH:
+				return std::tanh(x);
+			case Function::SIGMOID:
+				return 1.0f / (1.0f + std::exp(-x));
+		}
+	}
+	void apply(FastMathMode mode, Function function, const float *src, float *dst, size_t elements)
+	{
+		if (mode == FastMathMode::EXACT)
+		{
+			for (size_t i = 0; i < elements; i++)
+				dst[i] = exact_function(function, src[i]);
+		}
+		else
+		{
+			static const Kernel kernel = select_kernel();
+			kernel(function, mode == FastMathMode::FASTEST, src, dst, elements);
+		}
+	}
+
+	bool is_applicable(const Context &context, const Tensor &tensor) noexcept
+	{
+		return context.fastMathMode() != FastMathMode::EXACT and context.device().isCPU() and tensor.device().isCPU()
+				and tensor.dtype() == DataType::FLOAT32;
+	}
+}
+
+namespace avocado
+{
+	namespace math
+	{
+		void fastExp(FastMathMode mode, const float *src, float *dst, size_t elements)
+		{
+			apply(mode, Function::EXP, src, dst, elements);
+		}
+		void fastLog(FastMathMode mode, const float *src, float *dst, size_t elements)
+		{
+			apply(mode, Function::LOG, src, dst, elements);
+		}
+		void fastTanh(FastMathMode mode, const float *src, float *dst, size_t elements)
+		{
+			apply(mode, Function::TANH, src, dst, elements);
+		}
+		void fastSigmoid(FastMathMode mode, const float *src, float *dst, size_t elements)
+		{
+			apply(mode, Function::SIGMOID, src, dst, elements);
+		}
+	} /* namespace math */
+
+	namespace internal
+	{
+		bool fast_activation_forward(const Context &context, NonlinearityType activation, const Scalar &alpha, const Tensor &input,
+				const Scalar &beta, Tensor &output)
+		{
+			if (not is_applicable(context, input) or not is_applicable(context, output) or input.volume() != output.volume())
+				return false;
+			Function function;
+			switch (activation)
+			{
+				case NonlinearityType::SIGMOID:
+					function = Function::SIGMOID;
+					break;
+				case NonlinearityType::TANH:
+					function = Function::TANH;
+					break;
+				case NonlinearityType::EXPONENTIAL:
+					function = Function::EXP;
+					break;
+				default:
+					return false;
+			}
+
+			const FastMathMode mode = context.fastMathMode();
+			const float a = alpha.get<float>();
+			const float b = beta.get<float>();
+			const float *src = reinterpret_cast<const float*>(input.data());
+			float *dst = reinterpret_cast<float*>(output.data());
+			const int64_t elements = input.volume();
+#pragma omp parallel for
+			for (int64_t i = 0; i < elements; i += block_size)
+			{
+				const size_t length = std::min(static_cast<int64_t>(block_size), elements - i);
+				float tmp[block_size];
+				apply(mode, function, src + i, tmp, length);
+				for (size_t j = 0; j < length; j++)
+					dst[i + j] = (b == 0.0f) ? a * tmp[j] : a * tmp[j] + b * dst[i + j];
+			}
+			return true;
+		}
+		bool fast_softmax_forward(const Context &context, SoftmaxMode mode, const Scalar &alpha, const Tensor &input, const Scalar &beta,
+				Tensor &output)
+		{
+			if (not is_applicable(context, input) or not is_applicable(context, output) or input.volume() != output.volume())
+				return false;
+
+			const int rows = (mode == SoftmaxMode::PER_CHANNEL) ? input.volume() / input.lastDim() : input.firstDim();
+			const int columns = input.volume() / rows;
+			const FastMathMode math_mode = context.fastMathMode();
+			const float a = alpha.get<float>();
+			const float b = beta.get<float>();
+			const float *src = reinterpret_cast<const float*>(input.data());
+			float *dst = reinterpret_cast<float*>(output.data());
+#pragma omp parallel
+			{
+				std::vector<float> tmp(columns);
+#pragma omp for
+				for (int i = 0; i < rows; i++)
+				{
+					const float *src_row = src + static_cast<int64_t>(i) * columns;
+					float *dst_row = dst + static_cast<int64_t>(i) * columns;
+
+					float max_value = src_row[0];
+					for (int j = 1; j < columns; j++)
+						max_value = std::max(max_value, src_row[j]);
+					for (int j = 0; j < columns; j++)
+						tmp[j] = src_row[j] - max_value;
+					apply(math_mode, Function::EXP, tmp.data(), tmp.data(), columns);
+					float sum = 0.0f;
+					for (int j = 0; j < columns; j++)
+						sum += tmp[j];
+					const float scale = a / sum;
+					for (int j = 0; j < columns; j++)
+						dst_row[j] = (b == 0.0f) ? scale * tmp[j] : scale * tmp[j] + b * dst_row[j];
+				}
+			}
+			return true;
+		}
+		bool fast_cross_entropy_loss(const Context &context, const Tensor &output, const Tensor &target, Scalar &result)
+		{
+			if (not is_applicable(context, output) or not is_applicable(context, target) or output.volume() != target.volume())
+				return false;
+
+			const float epsilon = 1.0e-7f; // outputs are clipped to avoid infinite loss
+			const FastMathMode mode = context.fastMathMode();
+			const float *y = reinterpret_cast<const float*>(output.data());
+			const float *t = reinterpret_cast<const float*>(target.data());
+			const int64_t elements = output.volume();
+			double sum = 0.0;
+#pragma omp parallel for reduction(+:sum)
+			for (int64_t i = 0; i < elements; i += block_size)
+			{
+				const size_t length = std::min(static_cast<int64_t>(block_size), elements - i);
+				float log_y[block_size];
+				float log_1my[block_size];
+				for (size_t j = 0; j < length; j++)
+				{
+					log_y[j] = std::max(epsilon, std::min(1.0f - epsilon, y[i + j]));
+					log_1my[j] = 1.0f - log_y[j];
+				}
+				apply(mode, Function::LOG, log_y, log_y, length);
+				apply(mode, Function::LOG, log_1my, log_1my, length);
+				float partial = 0.0f;
+				for (size_t j = 0; j < length; j++)
+					partial -= t[i + j] * log_y[j] + (1.0f - t[i + j]) * log_1my[j];
+				sum += partial;
+			}
+			result = Scalar(static_cast<float>(sum));
+			return true;
+		}
+	} /* namespace internal */
+} /* namespace avocado */
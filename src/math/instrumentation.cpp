@@ -0,0 +1,182 @@
+/*
+ * instrumentation.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <Avocado/math/instrumentation.hpp>
+#include <Avocado/core/Tensor.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+namespace
+{
+	int bucket_index(double seconds) noexcept
+	{
+		const double microseconds = 1.0e6 * seconds;
+		if (microseconds < 1.0)
+			return 0;
+		return 1 + static_cast<int>(std::log2(microseconds));
+	}
+	bool is_faster(const std::pair<double, avocado::math::OperationInfo> &lhs, const std::pair<double, avocado::math::OperationInfo> &rhs) noexcept
+	{
+		return lhs.first > rhs.first;
+	}
+}
+
+namespace avocado
+{
+	namespace math
+	{
+		OperationInfo::OperationInfo(const char *name, Device device) :
+				name(name),
+				device(device)
+		{
+		}
+		std::string OperationInfo::toString() const
+		{
+			std::string result = std::string(name) + " (";
+			for (size_t i = 0; i < shapes.size(); i++)
+			{
+				if (i != 0)
+					result += ", ";
+				result += shapes[i].toString() + ' ' + avocado::toString(dtypes[i]);
+			}
+			return result + ") on " + device.toString();
+		}
+
+		void setInstrumentationHook(InstrumentationHook *hook) noexcept
+		{
+			internal::instrumentation_hook.store(hook);
+		}
+		InstrumentationHook* getInstrumentationHook() noexcept
+		{
+			return internal::instrumentation_hook.load();
+		}
+
+		void LatencyHistogram::onOperation(const OperationInfo &info, double elapsedTime)
+		{
+			const std::string key = info.toString();
+			const int bucket = bucket_index(elapsedTime);
+
+			std::lock_guard<std::mutex> lock(m_mutex);
+			Entry &entry = m_entries[key];
+			if (entry.count == 0)
+			{
+				entry.minTime = elapsedTime;
+				entry.maxTime = elapsedTime;
+			}
+			entry.count++;
+			entry.totalTime += elapsedTime;
+			entry.minTime = std::min(entry.minTime, elapsedTime);
+			entry.maxTime = std::max(entry.maxTime, elapsedTime);
+			if (static_cast<int>(entry.buckets.size()) <= bucket)
+				entry.buckets.resize(bucket + 1, 0);
+			entry.buckets[bucket]++;
+		}
+		void LatencyHistogram::clear()
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_entries.clear();
+		}
+		std::string LatencyHistogram::toString() const
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			std::stringstream ss;
+			ss << std::fixed << std::setprecision(2);
+			for (auto iter = m_entries.begin(); iter != m_entries.end(); iter++)
+			{
+				const Entry &entry = iter->second;
+				ss << iter->first << " : calls = " << entry.count << ", avg = " << 1.0e6 * entry.totalTime / entry.count << "us, min = "
+						<< 1.0e6 * entry.minTime << "us, max = " << 1.0e6 * entry.maxTime << "us\n";
+				for (size_t i = 0; i < entry.buckets.size(); i++)
+					if (entry.buckets[i] > 0)
+					{
+						const double lower = (i == 0) ? 0.0 : std::pow(2.0, i - 1);
+						ss << "  [" << std::setw(10) << lower << ", " << std::setw(10) << std::pow(2.0, i) << ") us : " << entry.buckets[i] << '\n';
+					}
+			}
+			return ss.str();
+		}
+
+		SlowestCalls::SlowestCalls(size_t numberOfCalls) :
+				m_capacity(numberOfCalls)
+		{
+		}
+		void SlowestCalls::onOperation(const OperationInfo &info, double elapsedTime)
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (m_calls.size() < m_capacity)
+			{
+				m_calls.push_back( { elapsedTime, info });
+				std::push_heap(m_calls.begin(), m_calls.end(), is_faster);
+			}
+			else
+			{
+				if (m_capacity == 0 or elapsedTime <= m_calls.front().first)
+					return;
+				std::pop_heap(m_calls.begin(), m_calls.end(), is_faster);
+				m_calls.back() = { elapsedTime, info };
+				std::push_heap(m_calls.begin(), m_calls.end(), is_faster);
+			}
+		}
+		void SlowestCalls::clear()
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_calls.clear();
+		}
+		std::vector<std::pair<double, OperationInfo>> SlowestCalls::getCalls() const
+		{
+			std::vector<std::pair<double, OperationInfo>> result;
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				result = m_calls;
+			}
+			std::sort(result.begin(), result.end(), is_faster);
+			return result;
+		}
+		std::string SlowestCalls::toString() const
+		{
+			const std::vector<std::pair<double, OperationInfo>> calls = getCalls();
+			std::stringstream ss;
+			ss << std::fixed << std::setprecision(2);
+			for (size_t i = 0; i < calls.size(); i++)
+				ss << std::setw(3) << i << " : " << std::setw(12) << 1.0e6 * calls[i].first << "us : " << calls[i].second.toString() << '\n';
+			return ss.str();
+		}
+
+	} /* namespace math */
+
+	namespace internal
+	{
+		std::atomic<math::InstrumentationHook*> instrumentation_hook(nullptr);
+
+		void OperationScope::add_argument(const Tensor &tensor)
+		{
+			m_info->shapes.push_back(tensor.shape());
+			m_info->dtypes.push_back(tensor.dtype());
+		}
+		void OperationScope::add_argument(const std::vector<Tensor> &list)
+		{
+			for (size_t i = 0; i < list.size(); i++)
+				add_argument(list[i]);
+		}
+		void OperationScope::finish() noexcept
+		{
+			try
+			{
+				m_context.synchronize();
+				const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+				math::InstrumentationHook *hook = instrumentation_hook.load();
+				if (hook != nullptr)
+					hook->onOperation(*m_info, elapsed);
+			} catch (...)
+			{ // hook must not break the instrumented operation
+			}
+		}
+	} /* namespace internal */
+} /* namespace avocado */
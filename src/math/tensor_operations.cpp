@@ -10,6 +10,7 @@
 #include <Avocado/core/Tensor.hpp>
 #include <Avocado/core/Scalar.hpp>
 
+#include <Avocado/math/instrumentation.hpp>
 #include <Avocado/backend/backend_libraries.hpp>
 
 namespace avocado
@@ -18,10 +19,12 @@ namespace avocado
 	{
 		void zeroTensor(const Context &context, Tensor &tensor)
 		{
+			internal::OperationScope scope(__func__, context, tensor);
 			internal::set_memory(context, tensor.getMemory(), 0, tensor.sizeInBytes(), nullptr, 0);
 		}
 		void setTensor(const Context &context, Tensor &tensor, const Scalar &value)
 		{
+			internal::OperationScope scope(__func__, context, tensor);
 			internal::set_memory(context, tensor.getMemory(), 0, tensor.sizeInBytes(), value.data(), value.sizeInBytes());
 		}
 		void copyTensor(const Context &context, Tensor &dst, const Tensor &src)
@@ -30,11 +33,13 @@ namespace avocado
 		}
 		void copyTensor(const Context &context, Tensor &dst, const Tensor &src, size_t elements)
 		{
+			internal::OperationScope scope(__func__, context, dst, src);
 			internal::copy_memory(context, dst.getMemory(), 0, src.getMemory(), 0, elements * sizeOf(src.dtype()));
 		}
 
 		void concatTensors(const Context &context, Tensor &dst, const std::vector<Tensor> &src)
 		{
+			internal::OperationScope scope(__func__, context, dst, src);
 			if (not same_device(context, dst))
 				throw DeviceMismatch(METHOD_NAME, "");
 			for (size_t i = 0; i < src.size(); i++)
@@ -76,6 +81,7 @@ namespace avocado
 		}
 		void splitTensors(const Context &context, std::vector<Tensor> &dst, const Tensor &src)
 		{
+			internal::OperationScope scope(__func__, context, dst, src);
 			if (not same_device(context, src))
 				throw DeviceMismatch(METHOD_NAME, "");
 			for (size_t i = 0; i < dst.size(); i++)
@@ -117,6 +123,7 @@ namespace avocado
 		}
 		void transposeTensor(const Context &context, Tensor &dst, const Tensor &src, std::initializer_list<int> order)
 		{
+			internal::OperationScope scope(__func__, context, dst, src);
 			if (not same_device(context, dst, src))
 				throw DeviceMismatch(METHOD_NAME, "");
 
@@ -151,6 +158,7 @@ namespace avocado
 
 		void scaleTensor(const Context &context, Tensor &dst, const Tensor &src, Scalar scale)
 		{
+			internal::OperationScope scope(__func__, context, dst, src);
 			if (not same_device(context, dst))
 				throw DeviceMismatch(METHOD_NAME, "");
 
@@ -183,6 +191,7 @@ namespace avocado
 		}
 		void addScalarToTensor(const Context &context, Tensor &dst, const Tensor &src, Scalar scalar)
 		{
+			internal::OperationScope scope(__func__, context, dst, src);
 			if (not same_device(context, dst))
 				throw DeviceMismatch(METHOD_NAME, "");
 
@@ -216,6 +225,7 @@ namespace avocado
 
 		void addTensors(const Context &context, Tensor &dst, const Tensor &src, Scalar alpha, Scalar beta)
 		{
+			internal::OperationScope scope(__func__, context, dst, src);
 			if (not same_device(context, src, dst))
 				throw DeviceMismatch(METHOD_NAME, "");
 
@@ -255,6 +265,7 @@ namespace avocado
 		void tensorBinaryOp(const Context &context, TensorBinaryOp operation, Scalar alpha1, const Tensor &src1, Scalar alpha2, const Tensor &src2,
 				Scalar beta, Tensor &dst)
 		{
+			internal::OperationScope scope(__func__, context, src1, src2, dst);
 			if (not same_device(context, src1, src2, dst))
 				throw DeviceMismatch(METHOD_NAME, "");
 
@@ -298,6 +309,7 @@ namespace avocado
 		}
 		void tensorUnaryOp(const Context &context, TensorUnaryOp operation, Scalar alpha, const Tensor &src, Scalar beta, Tensor &dst)
 		{
+			internal::OperationScope scope(__func__, context, src, dst);
 			if (not same_device(context, src, dst))
 				throw DeviceMismatch(METHOD_NAME, "");
 
@@ -336,6 +348,7 @@ namespace avocado
 
 		void reduceTensor(const Context &context, TensorReduceOp operation, Scalar alpha, Scalar beta, const Tensor &src, Tensor &dst)
 		{
+			internal::OperationScope scope(__func__, context, src, dst);
 			if (not same_device(context, src, dst))
 				throw DeviceMismatch(METHOD_NAME, "");
 
@@ -374,6 +387,7 @@ namespace avocado
 		void addBias(const Context &context, Scalar alpha1, Scalar alpha2, const Tensor &input, const Tensor &bias, Scalar beta1, Scalar beta2,
 				Scalar beta3, Tensor &output, const Tensor &ext, NonlinearityType activation)
 		{
+			internal::OperationScope scope(__func__, context, input, bias, output, ext);
 			if (not same_device(context, input, bias))
 				throw DeviceMismatch(METHOD_NAME, "");
 
@@ -421,6 +435,7 @@ namespace avocado
 
 		void gemm(const Context &context, GemmOp opA, GemmOp opB, Tensor &C, const Tensor &A, const Tensor &B, Scalar alpha, Scalar beta)
 		{
+			internal::OperationScope scope(__func__, context, C, A, B);
 			if (not same_device(context, A, B, C))
 				throw DeviceMismatch(METHOD_NAME, "");
 
@@ -464,6 +479,7 @@ namespace avocado
 		}
 		void gemmBatched(const Context &context, GemmOp opA, GemmOp opB, Tensor &C, const Tensor &A, const Tensor &B, Scalar alpha, Scalar beta)
 		{
+			internal::OperationScope scope(__func__, context, C, A, B);
 			if (not same_device(context, A, B, C))
 				throw DeviceMismatch(METHOD_NAME, "");
 
@@ -11,8 +11,606 @@
 #include <Avocado/core/Device.hpp>
 #include <Avocado/core/Context.hpp>
 
+#include <Avocado/math/fast_math.hpp>
+#include <Avocado/math/tensor_operations.hpp>
+#include <Avocado/math/instrumentation.hpp>
 #include <Avocado/backend/backend_libraries.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+	using namespace avocado;
+
+	const int64_t block_size = 1024; // number of elements processed by a thread at once
+
+	void exp_in_place(FastMathMode mode, float *x, int length)
+	{
+		math::fastExp(mode, x, x, length);
+	}
+	void exp_in_place(FastMathMode mode, double *x, int length)
+	{
+		for (int i = 0; i < length; i++)
+			x[i] = std::exp(x[i]);
+	}
+	void log_in_place(FastMathMode mode, float *x, int length)
+	{
+		math::fastLog(mode, x, x, length);
+	}
+	void log_in_place(FastMathMode mode, double *x, int length)
+	{
+		for (int i = 0; i < length; i++)
+			x[i] = std::log(x[i]);
+	}
+
+	template<typename T>
+	T entropy_term(T t) noexcept
+	{
+		return (t == static_cast<T>(0)) ? static_cast<T>(0) : t * std::log(t);
+	}
+	template<typename T>
+	double cpu_loss_and_gradient(FastMathMode mode, LossType lossType, int64_t elements, T alpha, T beta, const T *output, const T *target,
+			T *gradient, bool isFused)
+	{
+		const T one = static_cast<T>(1);
+		const T epsilon = static_cast<T>(1.0e-7); // outputs are clipped to avoid infinite loss
+		double loss = 0.0;
+#pragma omp parallel for reduction(+:loss)
+		for (int64_t i = 0; i < elements; i += block_size)
+		{
+			const int length = static_cast<int>(std::min(block_size, elements - i));
+			const T *y = output + i;
+			const T *t = target + i;
+			T *dy = gradient + i;
+			T tmp[block_size];
+			double block_loss = 0.0;
+			if (lossType == LossType::MEAN_SQUARE_LOSS)
+			{
+				for (int j = 0; j < length; j++)
+				{
+					const T diff = y[j] - t[j];
+					block_loss += static_cast<T>(0.5) * diff * diff;
+					tmp[j] = alpha * diff;
+				}
+			}
+			else
+			{
+				T log_y[block_size];
+				T log_1my[block_size];
+				for (int j = 0; j < length; j++)
+				{
+					log_y[j] = std::max(epsilon, std::min(one - epsilon, y[j]));
+					log_1my[j] = one - log_y[j];
+					tmp[j] = isFused ? alpha * (y[j] - t[j]) : alpha * (y[j] - t[j]) / (log_y[j] * log_1my[j]);
+				}
+				log_in_place(mode, log_y, length);
+				log_in_place(mode, log_1my, length);
+				for (int j = 0; j < length; j++)
+					block_loss -= t[j] * log_y[j] + (one - t[j]) * log_1my[j];
+				if (lossType == LossType::KL_DIVERGECE_LOSS) // subtract entropy of the target
+					for (int j = 0; j < length; j++)
+						block_loss += entropy_term(t[j]) + entropy_term(one - t[j]);
+			}
+			for (int j = 0; j < length; j++)
+				dy[j] = (beta == static_cast<T>(0)) ? tmp[j] : tmp[j] + beta * dy[j];
+			loss += block_loss;
+		}
+		return loss;
+	}
+
+	/*
+	 * Target is either dense (with the same shape as the output) or holds index of the correct class for each row.
+	 */
+	template<typename T>
+	T target_value(const T *target, int64_t row, int columns, int column) noexcept
+	{
+		return target[row * columns + column];
+	}
+	template<typename T>
+	T target_value(const int32_t *target, int64_t row, int columns, int column) noexcept
+	{
+		return (target[row] == column) ? static_cast<T>(1) : static_cast<T>(0);
+	}
+
+	template<typename T>
+	double cpu_class_index_loss_and_gradient(FastMathMode mode, LossType lossType, int rows, int columns, T alpha, T beta, const T *output,
+			const int32_t *target, T *gradient, bool isFused, bool calcLoss)
+	{
+		const T one = static_cast<T>(1);
+		const T epsilon = static_cast<T>(1.0e-7); // the same clipping as for dense targets
+		double loss = 0.0;
+#pragma omp parallel reduction(+:loss)
+		{
+			std::vector<T> tmp(columns);
+#pragma omp for
+			for (int i = 0; i < rows; i++)
+			{
+				const int64_t offset = static_cast<int64_t>(i) * columns;
+				const T *y = output + offset;
+				if (gradient != nullptr)
+				{
+					T *dy = gradient + offset;
+					for (int j = 0; j < columns; j++)
+					{
+						const T t = target_value<T>(target, i, columns, j);
+						T g = alpha * (y[j] - t);
+						if (lossType != LossType::MEAN_SQUARE_LOSS and not isFused)
+						{
+							const T clipped = std::max(epsilon, std::min(one - epsilon, y[j]));
+							g /= clipped * (one - clipped);
+						}
+						dy[j] = (beta == static_cast<T>(0)) ? g : g + beta * dy[j];
+					}
+				}
+				if (calcLoss)
+				{
+					double row_loss = 0.0;
+					if (lossType == LossType::MEAN_SQUARE_LOSS)
+					{
+						for (int j = 0; j < columns; j++)
+						{
+							const T diff = y[j] - target_value<T>(target, i, columns, j);
+							row_loss += static_cast<T>(0.5) * diff * diff;
+						}
+					}
+					else
+					{ // entropy of one-hot target is zero so KL divergence is equal to cross-entropy
+						for (int j = 0; j < columns; j++)
+						{
+							const T clipped = std::max(epsilon, std::min(one - epsilon, y[j]));
+							tmp[j] = (target[i] == j) ? clipped : one - clipped;
+						}
+						log_in_place(mode, tmp.data(), columns);
+						for (int j = 0; j < columns; j++)
+							row_loss -= tmp[j];
+					}
+					loss += row_loss;
+				}
+			}
+		}
+		return loss;
+	}
+
+	template<typename T, typename U>
+	double cpu_softmax_cross_entropy(FastMathMode mode, int rows, int columns, T alpha, T beta, const T *input, T *output, T *gradient,
+			const U *target)
+	{
+		const T epsilon = static_cast<T>(1.0e-7); // same clipping of 1 - output as in the separate loss kernel
+		double loss = 0.0;
+#pragma omp parallel reduction(+:loss)
+		{
+			std::vector<T> log_1my(columns);
+#pragma omp for
+			for (int i = 0; i < rows; i++)
+			{
+				const int64_t offset = static_cast<int64_t>(i) * columns;
+				const T *x = input + offset;
+				T *y = output + offset;
+				T *dx = gradient + offset;
+
+				T max_value = x[0];
+				for (int j = 1; j < columns; j++)
+					max_value = std::max(max_value, x[j]);
+				for (int j = 0; j < columns; j++)
+					y[j] = x[j] - max_value;
+				exp_in_place(mode, y, columns);
+				T sum = static_cast<T>(0);
+				for (int j = 0; j < columns; j++)
+					sum += y[j];
+				const T log_sum = std::log(sum);
+				const T inv_sum = static_cast<T>(1) / sum;
+
+				for (int j = 0; j < columns; j++)
+				{
+					y[j] *= inv_sum;
+					log_1my[j] = std::max(epsilon, static_cast<T>(1) - y[j]);
+					const T tmp = alpha * (y[j] - target_value<T>(target, i, columns, j));
+					dx[j] = (beta == static_cast<T>(0)) ? tmp : tmp + beta * dx[j];
+				}
+				log_in_place(mode, log_1my.data(), columns);
+
+				double row_loss = 0.0;
+				for (int j = 0; j < columns; j++)
+				{
+					const T t = target_value<T>(target, i, columns, j);
+					if (t != static_cast<T>(0)) // avoid 0 * -inf
+						row_loss -= t * (x[j] - max_value - log_sum);
+					if (t != static_cast<T>(1))
+						row_loss -= (static_cast<T>(1) - t) * log_1my[j];
+				}
+				loss += row_loss;
+			}
+		}
+		return loss;
+	}
+
+	bool is_class_index_target(const Tensor &output, const Tensor &target)
+	{
+		if (target.dtype() != DataType::INT32)
+			return false;
+		bool shapes_match = (target.shape().rank() + 1 == output.shape().rank());
+		for (int i = 0; shapes_match and i < target.shape().rank(); i++)
+			shapes_match = (target.shape()[i] == output.shape()[i]);
+		if (not shapes_match)
+			throw ShapeMismatch(METHOD_NAME, "class index target must have the shape of the output without the last dimension");
+		return true;
+	}
+	template<typename T>
+	void fill_one_hot(Tensor &dst, const std::vector<int32_t> &indices)
+	{
+		const int columns = dst.lastDim();
+		std::vector<T> tmp(dst.volume(), static_cast<T>(0));
+		for (size_t i = 0; i < indices.size(); i++)
+			if (0 <= indices[i] and indices[i] < columns)
+				tmp[i * columns + indices[i]] = static_cast<T>(1);
+		dst.copyFromHost(tmp.data(), tmp.size());
+	}
+	Tensor to_dense_target(const Tensor &output, const Tensor &target)
+	{
+		std::vector<int32_t> indices(target.volume());
+		target.copyToHost(indices.data(), indices.size());
+		Tensor result(output.shape(), output.dtype(), output.device());
+		switch (output.dtype())
+		{
+			case DataType::FLOAT32:
+				fill_one_hot<float>(result, indices);
+				break;
+			case DataType::FLOAT64:
+				fill_one_hot<double>(result, indices);
+				break;
+			default:
+				throw DataTypeNotSupported(METHOD_NAME, output.dtype());
+		}
+		return result;
+	}
+	/*
+	 * Loss and/or gradient (if not null) for targets holding class indices.
+	 */
+	Scalar class_index_loss_and_gradient(const Context &context, LossType lossType, Scalar alpha, Scalar beta, Tensor *gradient,
+			const Tensor &output, const Tensor &target, bool isFused, bool calcLoss)
+	{
+		if (not same_device(context, output, target))
+			throw DeviceMismatch(METHOD_NAME, "");
+		if (gradient != nullptr and not same_shape(*gradient, output))
+			throw ShapeMismatch(METHOD_NAME, "");
+		if (gradient != nullptr and not same_type(*gradient, output))
+			throw DataTypeMismatch(METHOD_NAME, "");
+
+		const int columns = output.lastDim();
+		const int rows = output.volume() / columns;
+		const int32_t *indices = context.device().isCPU() ? reinterpret_cast<const int32_t*>(target.data()) : nullptr;
+		switch (context.device().isCPU() ? output.dtype() : DataType::UNKNOWN)
+		{
+			case DataType::FLOAT32:
+			{
+				float *dy = (gradient == nullptr) ? nullptr : reinterpret_cast<float*>(gradient->data());
+				const double loss = cpu_class_index_loss_and_gradient(context.fastMathMode(), lossType, rows, columns, alpha.get<float>(),
+						beta.get<float>(), reinterpret_cast<const float*>(output.data()), indices, dy, isFused, calcLoss);
+				return Scalar(static_cast<float>(loss));
+			}
+			case DataType::FLOAT64:
+			{
+				double *dy = (gradient == nullptr) ? nullptr : reinterpret_cast<double*>(gradient->data());
+				const double loss = cpu_class_index_loss_and_gradient(context.fastMathMode(), lossType, rows, columns, alpha.get<double>(),
+						beta.get<double>(), reinterpret_cast<const double*>(output.data()), indices, dy, isFused, calcLoss);
+				return Scalar(loss);
+			}
+			default:
+			{ // other devices and data types - target is expanded to dense one-hot tensor through the host
+				const Tensor dense = to_dense_target(output, target);
+				if (gradient != nullptr)
+					math::calcLossGradient(context, lossType, alpha, beta, *gradient, output, dense, isFused);
+				return calcLoss ? math::calcLossFunction(context, lossType, output, dense) : Scalar(output.dtype());
+			}
+		}
+	}
+
+	bool is_host_float(const Context &context, const Tensor &tensor) noexcept
+	{
+		return context.device().isCPU() and (tensor.dtype() == DataType::FLOAT32 or tensor.dtype() == DataType::FLOAT64);
+	}
+	/* adds value to the single element CPU tensor of float32 or float64 type */
+	void add_to_host_accumulator(Tensor &accumulator, double value)
+	{
+		if (accumulator.dtype() == DataType::FLOAT32)
+			reinterpret_cast<float*>(accumulator.data())[0] += static_cast<float>(value);
+		else
+			reinterpret_cast<double*>(accumulator.data())[0] += value;
+	}
+	/*
+	 * Checks arguments of the fused softmax and cross-entropy, returns true if the target holds class indices.
+	 */
+	bool check_softmax_cross_entropy(const Context &context, SoftmaxMode mode, const Tensor &input, const Tensor &output, const Tensor &gradient,
+			const Tensor &target)
+	{
+		const bool class_index_target = is_class_index_target(output, target);
+		if (not same_device(context, input, output, gradient, target))
+			throw DeviceMismatch(METHOD_NAME, "");
+		if (not same_shape(input, output, gradient) or not (class_index_target or same_shape(output, target)))
+			throw ShapeMismatch(METHOD_NAME, "");
+		if (not same_type(input, output, gradient) or not (class_index_target or same_type(output, target)))
+			throw DataTypeMismatch(METHOD_NAME, "");
+		if (class_index_target and mode == SoftmaxMode::PER_INSTANCE and input.volume() != input.firstDim() * input.lastDim())
+			throw IllegalArgument(METHOD_NAME, "class index targets require softmax over the last dimension");
+		return class_index_target;
+	}
+	/*
+	 * Single pass of the fused softmax and cross-entropy on CPU for float32 and float64, returns the loss summed over all elements.
+	 */
+	double host_softmax_cross_entropy(const Context &context, SoftmaxMode mode, Scalar alpha, Scalar beta, const Tensor &input, Tensor &output,
+			Tensor &gradient, const Tensor &target, bool classIndexTarget)
+	{
+		const int rows = (mode == SoftmaxMode::PER_CHANNEL) ? input.volume() / input.lastDim() : input.firstDim();
+		const int columns = input.volume() / rows;
+		const FastMathMode math_mode = context.fastMathMode();
+		const int32_t *indices = reinterpret_cast<const int32_t*>(target.data());
+		if (input.dtype() == DataType::FLOAT32)
+		{
+			const float a = alpha.get<float>();
+			const float b = beta.get<float>();
+			const float *x = reinterpret_cast<const float*>(input.data());
+			float *y = reinterpret_cast<float*>(output.data());
+			float *dx = reinterpret_cast<float*>(gradient.data());
+			return classIndexTarget ?
+					cpu_softmax_cross_entropy(math_mode, rows, columns, a, b, x, y, dx, indices) :
+					cpu_softmax_cross_entropy(math_mode, rows, columns, a, b, x, y, dx, reinterpret_cast<const float*>(target.data()));
+		}
+		else
+		{
+			const double a = alpha.get<double>();
+			const double b = beta.get<double>();
+			const double *x = reinterpret_cast<const double*>(input.data());
+			double *y = reinterpret_cast<double*>(output.data());
+			double *dx = reinterpret_cast<double*>(gradient.data());
+			return classIndexTarget ?
+					cpu_softmax_cross_entropy(math_mode, rows, columns, a, b, x, y, dx, indices) :
+					cpu_softmax_cross_entropy(math_mode, rows, columns, a, b, x, y, dx, reinterpret_cast<const double*>(target.data()));
+		}
+	}
+
+	struct RowClasses
+	{
+			std::vector<int32_t> target;
+			std::vector<int32_t> predicted;
+			std::vector<int32_t> rank; // number of outputs greater than the output for the target class
+	};
+	template<typename T>
+	const T* host_pointer(const Tensor &tensor, std::vector<T> &storage)
+	{
+		if (tensor.device().isCPU())
+			return reinterpret_cast<const T*>(tensor.data());
+		storage.resize(tensor.volume());
+		tensor.copyToHost(storage.data(), storage.size());
+		return storage.data();
+	}
+	template<typename T>
+	void classify_rows(const Tensor &output, const Tensor &target, bool classIndex, RowClasses &result)
+	{
+		const int columns = output.lastDim();
+		const int rows = output.volume() / columns;
+		std::vector<T> output_storage, target_storage;
+		std::vector<int32_t> index_storage;
+		const T *y = host_pointer(output, output_storage);
+		const T *t = classIndex ? nullptr : host_pointer(target, target_storage);
+		const int32_t *indices = classIndex ? host_pointer(target, index_storage) : nullptr;
+
+		result.target.resize(rows);
+		result.predicted.resize(rows);
+		result.rank.resize(rows);
+#pragma omp parallel for
+		for (int i = 0; i < rows; i++)
+		{
+			const T *y_row = y + static_cast<int64_t>(i) * columns;
+			int target_class = 0;
+			if (classIndex)
+				target_class = indices[i];
+			else
+			{
+				const T *t_row = t + static_cast<int64_t>(i) * columns;
+				target_class = std::max_element(t_row, t_row + columns) - t_row;
+			}
+			result.target[i] = target_class;
+			result.predicted[i] = std::max_element(y_row, y_row + columns) - y_row;
+			int rank = columns;
+			if (0 <= target_class and target_class < columns)
+			{
+				rank = 0;
+				for (int j = 0; j < columns; j++)
+					rank += static_cast<int>(y_row[j] > y_row[target_class]);
+			}
+			result.rank[i] = rank;
+		}
+	}
+	RowClasses classify_rows(const Tensor &output, const Tensor &target)
+	{
+		const bool class_index = is_class_index_target(output, target);
+		if (not class_index and not (same_shape(output, target) and same_type(output, target)))
+			throw ShapeMismatch(METHOD_NAME, "target must be either dense or hold class indices");
+
+		RowClasses result;
+		switch (output.dtype())
+		{
+			case DataType::FLOAT32:
+				classify_rows<float>(output, target, class_index, result);
+				break;
+			case DataType::FLOAT64:
+				classify_rows<double>(output, target, class_index, result);
+				break;
+			default:
+				throw DataTypeNotSupported(METHOD_NAME, output.dtype());
+		}
+		return result;
+	}
+
+	/*
+	 * Optimizers with per-parameter trust ratio are not supported by the backend. They are described to it as their base optimizer
+	 * so that the descriptor is always valid, but the update itself is computed here.
+	 */
+	OptimizerType backend_optimizer_type(OptimizerType type) noexcept
+	{
+		switch (type)
+		{
+			case OptimizerType::LARS:
+				return OptimizerType::SGD;
+			case OptimizerType::LAMB:
+				return OptimizerType::ADAM;
+			default:
+				return type;
+		}
+	}
+	template<typename T>
+	T* host_pointer(Tensor &tensor, std::vector<T> &storage)
+	{
+		if (tensor.device().isCPU())
+			return reinterpret_cast<T*>(tensor.data());
+		storage.resize(tensor.volume());
+		tensor.copyToHost(storage.data(), storage.size());
+		return storage.data();
+	}
+	double trust_ratio(double weightNorm, double updateNorm) noexcept
+	{
+		return (weightNorm > 0.0 and updateNorm > 0.0) ? weightNorm / updateNorm : 1.0;
+	}
+	/*
+	 * LARS, see https://arxiv.org/abs/1708.03888
+	 * Coefficients are {momentum, trust coefficient, weight decay, epsilon}, flag 0 enables nesterov momentum.
+	 * Momentum is accumulated from the unscaled gradient and the step is scaled by learning rate and trust ratio, as in SGD.
+	 */
+	template<typename T>
+	void cpu_lars_learn(const OptimizerConfig &config, T alpha, T beta, T *weight, const T *update, T *momentum, int64_t elements,
+			T gradientScale, T *average, T averageDecay)
+	{
+		const T mu = config.getCoefficients()[0];
+		const double eta = config.getCoefficients()[1];
+		const T decay = config.getCoefficients()[2];
+		const double epsilon = config.getCoefficients()[3];
+		const bool use_nesterov = config.getFlags()[0];
+
+		double weight_norm = 0.0, gradient_norm = 0.0;
+#pragma omp parallel for reduction(+:weight_norm, gradient_norm)
+		for (int64_t i = 0; i < elements; i++)
+		{
+			weight_norm += static_cast<double>(weight[i]) * weight[i];
+			gradient_norm += static_cast<double>(update[i]) * update[i];
+		}
+		weight_norm = std::sqrt(weight_norm);
+		gradient_norm = std::sqrt(gradient_norm) * gradientScale;
+		// parameters with zero weights (like freshly initialized biases) or zero gradient are updated with plain learning rate
+		const double trust = (weight_norm > 0.0 and gradient_norm > 0.0) ?
+				eta * weight_norm / (gradient_norm + decay * weight_norm + epsilon) : 1.0;
+		const T scale = alpha * static_cast<T>(config.getLearningRate() * trust);
+
+#pragma omp parallel for
+		for (int64_t i = 0; i < elements; i++)
+		{
+			T step = gradientScale * update[i] + decay * weight[i];
+			if (momentum != nullptr)
+			{
+				momentum[i] = mu * momentum[i] + step;
+				step = use_nesterov ? (step + mu * momentum[i]) : momentum[i];
+			}
+			weight[i] = beta * weight[i] - scale * step;
+			if (average != nullptr)
+				average[i] = averageDecay * average[i] + (1 - averageDecay) * weight[i];
+		}
+	}
+	/*
+	 * LAMB, see https://arxiv.org/abs/1904.00962
+	 * Coefficients are {beta1, beta2, weight decay, epsilon}, workspace holds first and second moment.
+	 * The adam step of each element is computed twice (for the norm and for the update) instead of being stored in a temporary tensor.
+	 */
+	template<typename T>
+	void cpu_lamb_learn(const OptimizerConfig &config, int64_t step, T alpha, T beta, T *weight, const T *update, T *workspace, int64_t elements,
+			T gradientScale, T *average, T averageDecay)
+	{
+		const T beta1 = config.getCoefficients()[0];
+		const T beta2 = config.getCoefficients()[1];
+		const T decay = config.getCoefficients()[2];
+		const T epsilon = config.getCoefficients()[3];
+		const T correction1 = 1.0 - std::pow(config.getCoefficients()[0], step + 1);
+		const T correction2 = 1.0 - std::pow(config.getCoefficients()[1], step + 1);
+		T *m = workspace;
+		T *v = workspace + elements;
+
+		double weight_norm = 0.0, step_norm = 0.0;
+#pragma omp parallel for reduction(+:weight_norm, step_norm)
+		for (int64_t i = 0; i < elements; i++)
+		{
+			const T g = gradientScale * update[i];
+			m[i] = beta1 * m[i] + (1 - beta1) * g;
+			v[i] = beta2 * v[i] + (1 - beta2) * g * g;
+			const T step = (m[i] / correction1) / (std::sqrt(v[i] / correction2) + epsilon) + decay * weight[i];
+			weight_norm += static_cast<double>(weight[i]) * weight[i];
+			step_norm += static_cast<double>(step) * step;
+		}
+		const T scale = alpha * static_cast<T>(config.getLearningRate() * trust_ratio(std::sqrt(weight_norm), std::sqrt(step_norm)));
+
+#pragma omp parallel for
+		for (int64_t i = 0; i < elements; i++)
+		{
+			const T step = (m[i] / correction1) / (std::sqrt(v[i] / correction2) + epsilon) + decay * weight[i];
+			weight[i] = beta * weight[i] - scale * step;
+			if (average != nullptr)
+				average[i] = averageDecay * average[i] + (1 - averageDecay) * weight[i];
+		}
+	}
+	template<typename T>
+	double cpu_global_norm2(const std::vector<Tensor*> &tensors)
+	{
+		struct Block
+		{
+				const T *data;
+				int64_t length;
+		};
+		std::vector<Block> blocks; // all tensors are split into blocks so that a single parallel loop covers them
+		for (size_t i = 0; i < tensors.size(); i++)
+		{
+			const T *data = reinterpret_cast<const T*>(tensors[i]->data());
+			for (int64_t j = 0; j < tensors[i]->volume(); j += block_size)
+				blocks.push_back( { data + j, std::min(block_size, tensors[i]->volume() - j) });
+		}
+
+		double result = 0.0;
+#pragma omp parallel for reduction(+:result)
+		for (size_t i = 0; i < blocks.size(); i++)
+			for (int64_t j = 0; j < blocks[i].length; j++)
+				result += static_cast<double>(blocks[i].data[j]) * blocks[i].data[j];
+		return std::sqrt(result);
+	}
+	template<typename T>
+	void layerwise_adaptive_learn(const OptimizerConfig &config, int64_t step, Scalar alpha, Scalar beta, Tensor &weight, const Tensor &update,
+			Tensor &workspace, double gradientScale, Tensor *average, double averageDecay)
+	{
+		std::vector<T> weight_storage, update_storage, workspace_storage, average_storage;
+		T *w = host_pointer(weight, weight_storage);
+		const T *dw = host_pointer(update, update_storage);
+		T *ws = (workspace.volume() == 0) ? nullptr : host_pointer(workspace, workspace_storage);
+		T *avg = (average == nullptr) ? nullptr : host_pointer(*average, average_storage);
+
+		if (config.getType() == OptimizerType::LARS)
+			cpu_lars_learn(config, alpha.get<T>(), beta.get<T>(), w, dw, ws, weight.volume(), static_cast<T>(gradientScale), avg,
+					static_cast<T>(averageDecay));
+		else
+		{
+			if (workspace.volume() < 2 * weight.volume())
+				throw IllegalArgument(METHOD_NAME, "workspace must have at least twice as many elements as the weight");
+			cpu_lamb_learn(config, step, alpha.get<T>(), beta.get<T>(), w, dw, ws, weight.volume(), static_cast<T>(gradientScale), avg,
+					static_cast<T>(averageDecay));
+		}
+
+		if (not weight.device().isCPU())
+		{ // there are no device kernels for these optimizers so the update is computed through the host
+			weight.copyFromHost(weight_storage.data(), weight_storage.size());
+			if (ws != nullptr)
+				workspace.copyFromHost(workspace_storage.data(), workspace_storage.size());
+			if (avg != nullptr)
+				average->copyFromHost(average_storage.data(), average_storage.size());
+		}
+	}
+}
+
 namespace avocado
 {
 	OptimizerConfig::OptimizerConfig(Device device) :
@@ -27,7 +625,7 @@ namespace avocado
 			m_coeficients(other.m_coeficients),
 			m_flags(other.m_flags)
 	{
-		m_descriptor.set(m_type, m_steps, m_learning_rate, m_coeficients, m_flags);
+		m_descriptor.set(backend_optimizer_type(m_type), m_steps, m_learning_rate, m_coeficients, m_flags);
 	}
 	OptimizerConfig& OptimizerConfig::operator=(const OptimizerConfig &other)
 	{
@@ -36,7 +634,7 @@ namespace avocado
 		this->m_learning_rate = other.m_learning_rate;
 		this->m_coeficients = other.m_coeficients;
 		this->m_flags = other.m_flags;
-		m_descriptor.set(m_type, m_steps, m_learning_rate, m_coeficients, m_flags);
+		m_descriptor.set(backend_optimizer_type(m_type), m_steps, m_learning_rate, m_coeficients, m_flags);
 		return *this;
 	}
 	Device OptimizerConfig::device() const noexcept
@@ -48,32 +646,32 @@ namespace avocado
 		if (newDevice == device())
 			return;
 		m_descriptor = avocado::internal::OptimizerDescWrapper(newDevice);
-		m_descriptor.set(m_type, m_steps, m_learning_rate, m_coeficients, m_flags);
+		m_descriptor.set(backend_optimizer_type(m_type), m_steps, m_learning_rate, m_coeficients, m_flags);
 	}
 	void OptimizerConfig::setType(OptimizerType type)
 	{
 		m_type = type;
-		m_descriptor.set(m_type, m_steps, m_learning_rate, m_coeficients, m_flags);
+		m_descriptor.set(backend_optimizer_type(m_type), m_steps, m_learning_rate, m_coeficients, m_flags);
 	}
 	void OptimizerConfig::setSteps(int64_t steps)
 	{
 		m_steps = steps;
-		m_descriptor.set(m_type, m_steps, m_learning_rate, m_coeficients, m_flags);
+		m_descriptor.set(backend_optimizer_type(m_type), m_steps, m_learning_rate, m_coeficients, m_flags);
 	}
 	void OptimizerConfig::setLearningRate(double learningRate)
 	{
 		m_learning_rate = learningRate;
-		m_descriptor.set(m_type, m_steps, m_learning_rate, m_coeficients, m_flags);
+		m_descriptor.set(backend_optimizer_type(m_type), m_steps, m_learning_rate, m_coeficients, m_flags);
 	}
 	void OptimizerConfig::setCoefficients(const std::array<double, 4> &coefficients)
 	{
 		m_coeficients = coefficients;
-		m_descriptor.set(m_type, m_steps, m_learning_rate, m_coeficients, m_flags);
+		m_descriptor.set(backend_optimizer_type(m_type), m_steps, m_learning_rate, m_coeficients, m_flags);
 	}
 	void OptimizerConfig::setFlags(const std::array<bool, 4> &flags)
 	{
 		m_flags = flags;
-		m_descriptor.set(m_type, m_steps, m_learning_rate, m_coeficients, m_flags);
+		m_descriptor.set(backend_optimizer_type(m_type), m_steps, m_learning_rate, m_coeficients, m_flags);
 	}
 	OptimizerType OptimizerConfig::getType() const noexcept
 	{
@@ -101,6 +699,7 @@ namespace avocado
 
 		Scalar calcMetricFunction(const Context &context, MetricType metricType, const Tensor &output, const Tensor &target)
 		{
+			internal::OperationScope scope(__func__, context, output, target);
 			if (not same_device(context, output, target))
 				throw DeviceMismatch(METHOD_NAME, "");
 			if (not same_shape(output, target))
@@ -143,9 +742,59 @@ namespace avocado
 			}
 			return result;
 		}
+		void accumulateTopKAccuracy(const Context &context, int k, const Tensor &output, const Tensor &target, Tensor &counter)
+		{
+			internal::OperationScope scope(__func__, context, output, target, counter);
+			if (not same_device(context, output, target, counter))
+				throw DeviceMismatch(METHOD_NAME, "");
+			if (counter.dtype() != DataType::INT64 or counter.volume() != 1)
+				throw IllegalArgument(METHOD_NAME, "counter must be single element INT64 tensor");
+
+			const RowClasses classes = classify_rows(output, target);
+			int64_t correct = 0;
+			for (size_t i = 0; i < classes.rank.size(); i++)
+				correct += static_cast<int64_t>(classes.rank[i] < k);
+
+			if (context.device().isCPU())
+				reinterpret_cast<int64_t*>(counter.data())[0] += correct;
+			else
+			{ // there are no device kernels for this operation so the counter is updated through the host
+				correct += counter.get<int64_t>( { 0 });
+				counter.set<int64_t>(correct, { 0 });
+			}
+		}
+		void accumulateConfusionMatrix(const Context &context, const Tensor &output, const Tensor &target, Tensor &matrix)
+		{
+			internal::OperationScope scope(__func__, context, output, target, matrix);
+			if (not same_device(context, output, target, matrix))
+				throw DeviceMismatch(METHOD_NAME, "");
+			const int classes = output.lastDim();
+			if (matrix.dtype() != DataType::INT64 or matrix.shape() != Shape( { classes, classes }))
+				throw IllegalArgument(METHOD_NAME, "matrix must be INT64 tensor of shape [classes, classes]");
+
+			const RowClasses row_classes = classify_rows(output, target);
+			std::vector<int64_t> storage;
+			int64_t *counts = nullptr;
+			if (context.device().isCPU())
+				counts = reinterpret_cast<int64_t*>(matrix.data());
+			else
+			{ // there are no device kernels for this operation so the matrix is updated through the host
+				storage.resize(matrix.volume());
+				matrix.copyToHost(storage.data(), storage.size());
+				counts = storage.data();
+			}
+			for (size_t i = 0; i < row_classes.target.size(); i++)
+				if (0 <= row_classes.target[i] and row_classes.target[i] < classes)
+					counts[static_cast<int64_t>(row_classes.target[i]) * classes + row_classes.predicted[i]]++;
+			if (not storage.empty())
+				matrix.copyFromHost(storage.data(), storage.size());
+		}
 
 		Scalar calcLossFunction(const Context &context, LossType lossType, const Tensor &output, const Tensor &target)
 		{
+			internal::OperationScope scope(__func__, context, output, target);
+			if (is_class_index_target(output, target))
+				return class_index_loss_and_gradient(context, lossType, 0, 0, nullptr, output, target, false, true);
 			if (not same_device(context, output, target))
 				throw DeviceMismatch(METHOD_NAME, "");
 			if (not same_shape(output, target))
@@ -162,6 +811,8 @@ namespace avocado
 			backend::avMemoryDescriptor_t targetMem = target.getMemory();
 
 			Scalar result(output.dtype());
+			if (lossType == LossType::CROSS_ENTROPY_LOSS and internal::fast_cross_entropy_loss(context, output, target, result))
+				return result;
 
 			switch (context.device().type())
 			{
@@ -190,6 +841,12 @@ namespace avocado
 		void calcLossGradient(const Context &context, LossType lossType, Scalar alpha, Scalar beta, Tensor &gradient, const Tensor &output,
 				const Tensor &target, bool isFused)
 		{
+			internal::OperationScope scope(__func__, context, gradient, output, target);
+			if (is_class_index_target(output, target))
+			{
+				class_index_loss_and_gradient(context, lossType, alpha, beta, &gradient, output, target, isFused, false);
+				return;
+			}
 			if (not same_device(context, output, target))
 				throw DeviceMismatch(METHOD_NAME, "");
 			if (not same_shape(output, target))
@@ -237,19 +894,125 @@ namespace avocado
 			}
 		}
 
-		void optimizerLearn(const Context &context, OptimizerConfig &config, Scalar alpha, Scalar beta, Tensor &weight, const Tensor &update,
-				Tensor &workspace)
+		void calcLossGradientAndAccumulate(const Context &context, LossType lossType, Scalar alpha, Scalar beta, Tensor &gradient,
+				const Tensor &output, const Tensor &target, bool isFused, double lossScale, Tensor &accumulator)
 		{
+			internal::OperationScope scope(__func__, context, gradient, output, target, accumulator);
+			if (not same_device(context, gradient, output, target, accumulator))
+				throw DeviceMismatch(METHOD_NAME, "");
+			if (not same_type(gradient, output, accumulator))
+				throw DataTypeMismatch(METHOD_NAME, "");
+			if (accumulator.volume() != 1)
+				throw IllegalArgument(METHOD_NAME, "accumulator", "must have exactly one element", accumulator.volume());
+			if (is_class_index_target(output, target))
+			{
+				if (is_host_float(context, output))
+				{
+					const Scalar loss = class_index_loss_and_gradient(context, lossType, alpha, beta, &gradient, output, target, isFused, true);
+					add_to_host_accumulator(accumulator, lossScale * loss.get<double>());
+				}
+				else // target is expanded to dense one-hot tensor through the host
+					calcLossGradientAndAccumulate(context, lossType, alpha, beta, gradient, output, to_dense_target(output, target), isFused, lossScale,
+							accumulator);
+				return;
+			}
+			if (not same_shape(gradient, output, target))
+				throw ShapeMismatch(METHOD_NAME, "");
+			if (not same_type(output, target))
+				throw DataTypeMismatch(METHOD_NAME, "");
+
+			if (is_host_float(context, output))
+			{
+				const FastMathMode mode = context.fastMathMode();
+				if (output.dtype() == DataType::FLOAT32)
+				{
+					const double loss = cpu_loss_and_gradient(mode, lossType, output.volume(), alpha.get<float>(), beta.get<float>(),
+							reinterpret_cast<const float*>(output.data()), reinterpret_cast<const float*>(target.data()),
+							reinterpret_cast<float*>(gradient.data()), isFused);
+					add_to_host_accumulator(accumulator, lossScale * loss);
+				}
+				else
+				{
+					const double loss = cpu_loss_and_gradient(mode, lossType, output.volume(), alpha.get<double>(), beta.get<double>(),
+							reinterpret_cast<const double*>(output.data()), reinterpret_cast<const double*>(target.data()),
+							reinterpret_cast<double*>(gradient.data()), isFused);
+					add_to_host_accumulator(accumulator, lossScale * loss);
+				}
+				return;
+			}
+
+			// other devices and data types use separate kernels
+			calcLossGradient(context, lossType, alpha, beta, gradient, output, target, isFused);
+			Tensor tmp( { 1 }, accumulator.dtype(), accumulator.device());
+			setTensor(context, tmp, calcLossFunction(context, lossType, output, target));
+			addTensors(context, accumulator, tmp, lossScale, 1);
+		}
+
+		Scalar softmaxCrossEntropy(const Context &context, SoftmaxMode mode, Scalar alpha, Scalar beta, const Tensor &input, Tensor &output,
+				Tensor &gradient, const Tensor &target)
+		{
+			internal::OperationScope scope(__func__, context, input, output, gradient, target);
+			const bool class_index_target = check_softmax_cross_entropy(context, mode, input, output, gradient, target);
+			if (is_host_float(context, input))
+			{
+				const double loss = host_softmax_cross_entropy(context, mode, alpha, beta, input, output, gradient, target, class_index_target);
+				return (input.dtype() == DataType::FLOAT32) ? Scalar(static_cast<float>(loss)) : Scalar(loss);
+			}
+
+			// other devices and data types use separate kernels
+			softmaxForward(context, mode, 1, input, 0, output);
+			calcLossGradient(context, LossType::CROSS_ENTROPY_LOSS, alpha, beta, gradient, output, target, true);
+			return calcLossFunction(context, LossType::CROSS_ENTROPY_LOSS, output, target);
+		}
+		void softmaxCrossEntropy(const Context &context, SoftmaxMode mode, Scalar alpha, Scalar beta, const Tensor &input, Tensor &output,
+				Tensor &gradient, const Tensor &target, double lossScale, Tensor &accumulator)
+		{
+			internal::OperationScope scope(__func__, context, input, output, gradient, target, accumulator);
+			const bool class_index_target = check_softmax_cross_entropy(context, mode, input, output, gradient, target);
+			if (not same_device(context, accumulator))
+				throw DeviceMismatch(METHOD_NAME, "");
+			if (not same_type(input, accumulator))
+				throw DataTypeMismatch(METHOD_NAME, "");
+			if (accumulator.volume() != 1)
+				throw IllegalArgument(METHOD_NAME, "accumulator", "must have exactly one element", accumulator.volume());
+			if (is_host_float(context, input))
+			{
+				const double loss = host_softmax_cross_entropy(context, mode, alpha, beta, input, output, gradient, target, class_index_target);
+				add_to_host_accumulator(accumulator, lossScale * loss);
+				return;
+			}
+
+			// other devices and data types use separate kernels
+			softmaxForward(context, mode, 1, input, 0, output);
+			calcLossGradientAndAccumulate(context, LossType::CROSS_ENTROPY_LOSS, alpha, beta, gradient, output, target, true, lossScale, accumulator);
+		}
+
+		void optimizerLearn(const Context &context, OptimizerConfig &config, Scalar alpha, Scalar beta, Tensor &weight, Tensor &update,
+				Tensor &workspace, double gradientScale, Tensor *average, double averageDecay)
+		{
+			internal::OperationScope scope(__func__, context, weight, update, workspace);
 			if (not same_device(context, weight, update))
 				throw DeviceMismatch(METHOD_NAME, "");
 			if (not same_shape(weight, update))
 				throw ShapeMismatch(METHOD_NAME, "");
 			if (not same_type(weight, update))
 				throw DataTypeMismatch(METHOD_NAME, "");
+			if (average != nullptr and not (same_device(weight, *average) and same_shape(weight, *average) and same_type(weight, *average)))
+				throw IllegalArgument(METHOD_NAME, "average must have the same device, shape and type as the weight");
+			if (config.getType() == OptimizerType::LARS or config.getType() == OptimizerType::LAMB)
+				throw LogicError(METHOD_NAME, "layer-wise adaptive optimizers are computed by layerwiseAdaptiveLearn()");
 
+			if (gradientScale != 1.0 and config.getType() == OptimizerType::SGD and config.getCoefficients()[0] == 0.0)
+			{ // without momentum scaling the gradient is the same as scaling the step
+				alpha = Scalar(alpha.get<double>() * gradientScale);
+				gradientScale = 1.0;
+			}
 			alpha.toScalingTypeFor(weight.dtype());
 			beta.toScalingTypeFor(weight.dtype());
 
+			if (gradientScale != 1.0)
+				math::scaleTensor(context, update, gradientScale);
+
 			backend::avTensorDescriptor_t wDesc = weight.getDescriptor();
 			backend::avMemoryDescriptor_t wMem = weight.getMemory();
 
@@ -281,11 +1044,85 @@ namespace avocado
 					break;
 				}
 			}
+			if (average != nullptr)
+				math::addTensors(context, *average, weight, 1.0 - averageDecay, averageDecay);
+		}
+
+		void layerwiseAdaptiveLearn(const Context &context, const OptimizerConfig &config, int64_t step, Scalar alpha, Scalar beta, Tensor &weight,
+				const Tensor &update, Tensor &workspace, double gradientScale, Tensor *average, double averageDecay)
+		{
+			internal::OperationScope scope(__func__, context, weight, update, workspace);
+			if (not same_device(context, weight, update))
+				throw DeviceMismatch(METHOD_NAME, "");
+			if (not same_shape(weight, update))
+				throw ShapeMismatch(METHOD_NAME, "");
+			if (not same_type(weight, update))
+				throw DataTypeMismatch(METHOD_NAME, "");
+			if (average != nullptr and not (same_device(weight, *average) and same_shape(weight, *average) and same_type(weight, *average)))
+				throw IllegalArgument(METHOD_NAME, "average must have the same device, shape and type as the weight");
+			if (config.getType() != OptimizerType::LARS and config.getType() != OptimizerType::LAMB)
+				throw LogicError(METHOD_NAME, "only LARS and LAMB are computed by the library");
+
+			alpha.toScalingTypeFor(weight.dtype());
+			beta.toScalingTypeFor(weight.dtype());
+			switch (weight.dtype())
+			{
+				case DataType::FLOAT32:
+					layerwise_adaptive_learn<float>(config, step, alpha, beta, weight, update, workspace, gradientScale, average, averageDecay);
+					break;
+				case DataType::FLOAT64:
+					layerwise_adaptive_learn<double>(config, step, alpha, beta, weight, update, workspace, gradientScale, average, averageDecay);
+					break;
+				default:
+					throw DataTypeNotSupported(METHOD_NAME, weight.dtype());
+			}
+		}
+		double globalNorm2(const Context &context, const std::vector<Tensor*> &tensors)
+		{
+			if (tensors.empty())
+				return 0.0;
+			for (size_t i = 0; i < tensors.size(); i++)
+			{
+				if (not same_device(context, *tensors[i]))
+					throw DeviceMismatch(METHOD_NAME, context.device(), tensors[i]->device());
+				if (not same_type(*tensors[0], *tensors[i]))
+					throw DataTypeMismatch(METHOD_NAME, tensors[0]->dtype(), tensors[i]->dtype());
+			}
+
+			if (context.device().isCPU())
+			{
+				switch (tensors[0]->dtype())
+				{
+					case DataType::FLOAT32:
+						return cpu_global_norm2<float>(tensors);
+					case DataType::FLOAT64:
+						return cpu_global_norm2<double>(tensors);
+					default:
+						throw DataTypeNotSupported(METHOD_NAME, tensors[0]->dtype());
+				}
+			}
+			else
+			{
+				Tensor norms( { static_cast<int>(tensors.size()) }, tensors[0]->dtype(), context.device());
+				for (size_t i = 0; i < tensors.size(); i++)
+				{
+					Tensor dst = norms.view( { 1 }, i);
+					math::reduceTensor(context, TensorReduceOp::NORM2, 1, 0, tensors[i]->view( { tensors[i]->volume() }), dst);
+				}
+				std::vector<double> host(tensors.size());
+				norms.convertTo(DataType::FLOAT64);
+				norms.copyToHost(host.data(), host.size());
+				double result = 0.0;
+				for (size_t i = 0; i < host.size(); i++)
+					result += host[i] * host[i];
+				return std::sqrt(result);
+			}
 		}
 
 		Scalar applyRegularizerL2(const Context &context, Tensor &gradient, const Tensor &weight, Tensor &update, Scalar scale, Scalar offset,
 				bool calcLoss)
 		{
+			internal::OperationScope scope(__func__, context, gradient, weight, update);
 			if (not same_device(context, weight))
 				throw DeviceMismatch(METHOD_NAME, context.device(), weight.device());
 
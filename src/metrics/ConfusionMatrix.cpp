@@ -0,0 +1,78 @@
+/*
+ * ConfusionMatrix.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <Avocado/metrics/ConfusionMatrix.hpp>
+#include <Avocado/core/Context.hpp>
+#include <Avocado/core/Scalar.hpp>
+#include <Avocado/core/Tensor.hpp>
+#include <Avocado/core/error_handling.hpp>
+#include <Avocado/math/training.hpp>
+#include <Avocado/utils/static_block.hpp>
+
+namespace avocado
+{
+	static_block
+	{
+		registerMetric(ConfusionMatrix());
+	}
+
+	ConfusionMatrix::~ConfusionMatrix() = default;
+
+	void ConfusionMatrix::update(const Context &context, const Tensor &output, const Tensor &target)
+	{
+		const int classes = output.lastDim();
+		if (m_matrix == nullptr)
+		{
+			m_matrix = std::make_unique<Tensor>(Shape( { classes, classes }), DataType::INT64, context.device());
+			m_matrix->zeroall();
+		}
+		if (m_matrix->firstDim() != classes)
+			throw ShapeMismatch(METHOD_NAME, "number of classes has changed since the last reset");
+		m_matrix->moveTo(context.device());
+		math::accumulateConfusionMatrix(context, output, target, *m_matrix);
+	}
+	void ConfusionMatrix::reset()
+	{
+		m_matrix.reset();
+	}
+	Scalar ConfusionMatrix::getValue() const
+	{
+		const std::vector<int64_t> matrix = getMatrix();
+		const int classes = numberOfClasses();
+		int64_t correct = 0, total = 0;
+		for (int i = 0; i < classes; i++)
+			for (int j = 0; j < classes; j++)
+			{
+				total += matrix[i * classes + j];
+				if (i == j)
+					correct += matrix[i * classes + j];
+			}
+		return Scalar((total == 0) ? 0.0 : static_cast<double>(correct) / total);
+	}
+	std::vector<int64_t> ConfusionMatrix::getMatrix() const
+	{
+		if (m_matrix == nullptr)
+			return std::vector<int64_t>();
+		std::vector<int64_t> result(m_matrix->volume());
+		m_matrix->copyToHost(result.data(), result.size());
+		return result;
+	}
+	int ConfusionMatrix::numberOfClasses() const noexcept
+	{
+		return (m_matrix == nullptr) ? 0 : m_matrix->firstDim();
+	}
+
+	std::string ConfusionMatrix::name() const
+	{
+		return "ConfusionMatrix";
+	}
+	ConfusionMatrix* ConfusionMatrix::clone() const
+	{
+		return new ConfusionMatrix();
+	}
+
+} /* namespace avocado */
@@ -0,0 +1,79 @@
+/*
+ * MeanLoss.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <Avocado/metrics/MeanLoss.hpp>
+#include <Avocado/core/Context.hpp>
+#include <Avocado/core/Scalar.hpp>
+#include <Avocado/core/Tensor.hpp>
+#include <Avocado/core/error_handling.hpp>
+#include <Avocado/math/tensor_operations.hpp>
+#include <Avocado/utils/json.hpp>
+#include <Avocado/utils/static_block.hpp>
+
+namespace avocado
+{
+	static_block
+	{
+		registerMetric(MeanLoss());
+	}
+
+	MeanLoss::MeanLoss(const LossFunction &loss) :
+			m_loss(loss.clone())
+	{
+	}
+	MeanLoss::~MeanLoss() = default;
+
+	void MeanLoss::update(const Context &context, const Tensor &output, const Tensor &target)
+	{
+		if (m_loss == nullptr)
+			throw UninitializedObject(METHOD_NAME, "loss function has not been set");
+		if (m_sum == nullptr)
+		{
+			m_sum = std::make_unique<Tensor>(Shape( { 1 }), DataType::FLOAT64, context.device());
+			m_sum->zeroall();
+		}
+		m_sum->moveTo(context.device());
+		Tensor loss( { 1 }, DataType::FLOAT64, context.device());
+		math::setTensor(context, loss, m_loss->getLoss(context, output, target).asType(DataType::FLOAT64));
+		math::addTensors(context, *m_sum, loss, 1, 1);
+		m_batches++;
+	}
+	void MeanLoss::reset()
+	{
+		if (m_sum != nullptr)
+			m_sum->zeroall();
+		m_batches = 0;
+	}
+	Scalar MeanLoss::getValue() const
+	{
+		if (m_batches == 0)
+			return Scalar(0.0);
+		return Scalar(m_sum->get<double>( { 0 }) / m_batches);
+	}
+
+	std::string MeanLoss::name() const
+	{
+		return "MeanLoss";
+	}
+	MeanLoss* MeanLoss::clone() const
+	{
+		return (m_loss == nullptr) ? new MeanLoss() : new MeanLoss(*m_loss);
+	}
+	Json MeanLoss::serialize(SerializedObject &binary_data) const
+	{
+		Json result = Metric::serialize(binary_data);
+		if (m_loss != nullptr)
+			result["loss"] = m_loss->serialize(binary_data);
+		return result;
+	}
+	void MeanLoss::unserialize(const Json &json, const SerializedObject &binary_data)
+	{
+		if (json.hasKey("loss"))
+			m_loss = loadLossFunction(json["loss"], binary_data);
+	}
+
+} /* namespace avocado */
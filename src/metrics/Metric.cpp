@@ -36,13 +36,13 @@ namespace avocado
 		if (registered_metric().find(metric.name()) == registered_metric().end())
 			registered_metric()[metric.name()] = std::unique_ptr<Metric>(metric.clone());
 		else
-			throw LogicError(METHOD_NAME, "loss function '" + metric.name() + "' has already been registered");
+			throw LogicError(METHOD_NAME, "metric '" + metric.name() + "' has already been registered");
 	}
 	std::unique_ptr<Metric> loadMetric(const Json &json, const SerializedObject &binary_data)
 	{
 		auto opt = registered_metric().find(json["name"]);
 		if (opt == registered_metric().end())
-			throw LogicError(METHOD_NAME, "unknown loss function '" + static_cast<std::string>(json["name"]) + "'");
+			throw LogicError(METHOD_NAME, "unknown metric '" + static_cast<std::string>(json["name"]) + "'");
 
 		std::unique_ptr<Metric> result(opt->second->clone());
 		result->unserialize(json, binary_data);
@@ -0,0 +1,75 @@
+/*
+ * TopKAccuracy.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <Avocado/metrics/TopKAccuracy.hpp>
+#include <Avocado/core/Context.hpp>
+#include <Avocado/core/Scalar.hpp>
+#include <Avocado/core/Tensor.hpp>
+#include <Avocado/core/error_handling.hpp>
+#include <Avocado/math/training.hpp>
+#include <Avocado/utils/json.hpp>
+#include <Avocado/utils/static_block.hpp>
+
+namespace avocado
+{
+	static_block
+	{
+		registerMetric(TopKAccuracy());
+	}
+
+	TopKAccuracy::TopKAccuracy(int k) :
+			m_k(k)
+	{
+		if (k < 1)
+			throw IllegalArgument(METHOD_NAME, "k", "must be positive", k);
+	}
+	TopKAccuracy::~TopKAccuracy() = default;
+
+	void TopKAccuracy::update(const Context &context, const Tensor &output, const Tensor &target)
+	{
+		if (m_correct == nullptr)
+		{
+			m_correct = std::make_unique<Tensor>(Shape( { 1 }), DataType::INT64, context.device());
+			m_correct->zeroall();
+		}
+		m_correct->moveTo(context.device());
+		math::accumulateTopKAccuracy(context, m_k, output, target, *m_correct);
+		m_samples += output.volume() / output.lastDim();
+	}
+	void TopKAccuracy::reset()
+	{
+		if (m_correct != nullptr)
+			m_correct->zeroall();
+		m_samples = 0;
+	}
+	Scalar TopKAccuracy::getValue() const
+	{
+		if (m_samples == 0)
+			return Scalar(0.0);
+		return Scalar(static_cast<double>(m_correct->get<int64_t>( { 0 })) / m_samples);
+	}
+
+	std::string TopKAccuracy::name() const
+	{
+		return "TopKAccuracy";
+	}
+	TopKAccuracy* TopKAccuracy::clone() const
+	{
+		return new TopKAccuracy(m_k);
+	}
+	Json TopKAccuracy::serialize(SerializedObject &binary_data) const
+	{
+		Json result = Metric::serialize(binary_data);
+		result["k"] = m_k;
+		return result;
+	}
+	void TopKAccuracy::unserialize(const Json &json, const SerializedObject &binary_data)
+	{
+		m_k = json["k"];
+	}
+
+} /* namespace avocado */
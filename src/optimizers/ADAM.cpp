@@ -8,6 +8,7 @@
 #include <Avocado/optimizers/ADAM.hpp>
 #include <Avocado/layers/Parameter.hpp>
 #include <Avocado/utils/json.hpp>
+#include <Avocado/utils/serialization.hpp>
 #include <Avocado/core/Context.hpp>
 #include <Avocado/core/Scalar.hpp>
 #include <Avocado/utils/static_block.hpp>
@@ -43,6 +44,28 @@ namespace avocado
 		return *this;
 	}
 
+	ADAM& ADAM::offloadWorkspace(const std::string &directory, int chunkSize)
+	{
+		if (directory.empty())
+			throw IllegalArgument(METHOD_NAME, "directory must not be empty");
+		if (chunkSize < 1)
+			throw IllegalArgument(METHOD_NAME, "chunkSize", "must be positive", chunkSize);
+		m_offload_directory = directory;
+		m_offload_chunk_size = chunkSize;
+		if (m_workspace != nullptr and not m_workspace->isEmpty())
+		{ // already accumulated state is moved to the file
+			SerializedObject binary_data;
+			const Json json = m_workspace->serialize(binary_data);
+			m_offloaded_workspace = std::make_unique<OffloadedWorkspace>(m_offload_directory, json, binary_data, m_offload_chunk_size);
+			m_workspace = nullptr;
+		}
+		return *this;
+	}
+	bool ADAM::isWorkspaceOffloaded() const noexcept
+	{
+		return not m_offload_directory.empty();
+	}
+
 	float ADAM::getLearningRate() const noexcept
 	{
 		return m_config.getLearningRate();
@@ -61,24 +84,37 @@ namespace avocado
 		m_config.setSteps(0);
 		if (m_workspace != nullptr)
 			m_workspace->zeroall();
+		if (m_offloaded_workspace != nullptr)
+			m_offloaded_workspace->zeroall();
 	}
 	void ADAM::moveTo(Device newDevice)
 	{
 		m_config.moveTo(newDevice);
 		if (m_workspace != nullptr)
 			m_workspace->moveTo(newDevice);
+		if (m_offloaded_workspace != nullptr)
+			m_offloaded_workspace->releaseStaging();
 	}
-	void ADAM::learn(const Context &context, Parameter &param)
+	void ADAM::learn(const Context &context, Parameter &param, double learningRateMultiplier)
 	{
 		assert(same_device(context, param));
 		size_t length = param.getParam().volume();
 		if (length == 0)
 			return;
 
-		if (m_workspace == nullptr)
-			m_workspace = std::make_unique<Tensor>(Shape( { 2 * param.shape().volume() }), param.dtype(), param.device());
-
-		math::optimizerLearn(context, m_config, 1, 1, param.getParam(), param.getUpdate(), *m_workspace);
+		if (isWorkspaceOffloaded())
+		{
+			if (m_offloaded_workspace == nullptr)
+				m_offloaded_workspace = std::make_unique<OffloadedWorkspace>(m_offload_directory, 2 * param.shape().volume(), param.dtype(),
+						m_offload_chunk_size);
+			learn_step(context, m_config, param, learningRateMultiplier, *m_offloaded_workspace);
+		}
+		else
+		{
+			if (m_workspace == nullptr)
+				m_workspace = std::make_unique<Tensor>(Shape( { 2 * param.shape().volume() }), param.dtype(), param.device());
+			learn_step(context, m_config, param, learningRateMultiplier, *m_workspace);
+		}
 		param.getUpdate().zeroall();
 	}
 
@@ -92,6 +128,10 @@ namespace avocado
 		result->m_config = this->m_config;
 		if (this->m_workspace != nullptr)
 			result->m_workspace = std::make_unique<Tensor>(*m_workspace);
+		if (this->m_offloaded_workspace != nullptr)
+			result->m_offloaded_workspace = std::make_unique<OffloadedWorkspace>(*m_offloaded_workspace);
+		result->m_offload_directory = this->m_offload_directory;
+		result->m_offload_chunk_size = this->m_offload_chunk_size;
 		return result.release();
 	}
 	Json ADAM::serialize(SerializedObject &binary_data) const
@@ -103,7 +143,10 @@ namespace avocado
 		result["beta1"] = m_config.getCoefficients()[0];
 		result["beta2"] = m_config.getCoefficients()[1];
 		result["use_amsgrad"] = m_config.getFlags()[0];
-		result["workspace"] = (m_workspace == nullptr) ? Json() : m_workspace->serialize(binary_data);
+		if (m_offloaded_workspace != nullptr)
+			result["workspace"] = m_offloaded_workspace->serialize(binary_data);
+		else
+			result["workspace"] = (m_workspace == nullptr) ? Json() : m_workspace->serialize(binary_data);
 
 		return result;
 	}
@@ -115,7 +158,13 @@ namespace avocado
 		std::array<bool, 4> flags = { json["use_amsgrad"].getBool(), false, false, false };
 		m_config.setCoefficients(coef);
 		m_config.setFlags(flags);
-		m_workspace = json["workspace"].isNull() ? nullptr : std::make_unique<Tensor>(json["workspace"], binary_data);
+		// offload directory is specific to the machine, so the state is loaded into memory and the caller may offload it again
+		m_offload_directory.clear();
+		m_offload_chunk_size = OffloadedWorkspace::default_chunk_size;
+		m_workspace = nullptr;
+		m_offloaded_workspace = nullptr;
+		if (not json["workspace"].isNull())
+			m_workspace = std::make_unique<Tensor>(json["workspace"], binary_data);
 	}
 
 } /* namespace avocado */
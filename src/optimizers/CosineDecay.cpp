@@ -0,0 +1,71 @@
+/*
+ * CosineDecay.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <Avocado/optimizers/CosineDecay.hpp>
+#include <Avocado/utils/json.hpp>
+#include <Avocado/core/error_handling.hpp>
+#include <Avocado/utils/static_block.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace avocado
+{
+	static_block
+	{
+		registerLearningRateSchedule(CosineDecay());
+	}
+
+	CosineDecay::CosineDecay(int64_t decaySteps, double minMultiplier, int64_t warmupSteps) :
+			m_decay_steps(decaySteps),
+			m_min_multiplier(minMultiplier),
+			m_warmup_steps(warmupSteps)
+	{
+		if (decaySteps < 1)
+			throw IllegalArgument(METHOD_NAME, "decaySteps", "must be positive", static_cast<int>(decaySteps));
+		if (warmupSteps < 0)
+			throw IllegalArgument(METHOD_NAME, "warmupSteps", "must not be negative", static_cast<int>(warmupSteps));
+	}
+
+	double CosineDecay::getMultiplier(int64_t step) const noexcept
+	{
+		if (step < m_warmup_steps)
+			return static_cast<double>(step + 1) / m_warmup_steps;
+		const double t = std::min(1.0, static_cast<double>(step - m_warmup_steps) / m_decay_steps);
+		return m_min_multiplier + (1.0 - m_min_multiplier) * 0.5 * (1.0 + std::cos(M_PI * t));
+	}
+
+	std::string CosineDecay::name() const
+	{
+		return "CosineDecay";
+	}
+	CosineDecay* CosineDecay::clone() const
+	{
+		std::unique_ptr<CosineDecay> result = std::make_unique<CosineDecay>();
+		result->m_decay_steps = this->m_decay_steps;
+		result->m_min_multiplier = this->m_min_multiplier;
+		result->m_warmup_steps = this->m_warmup_steps;
+		result->m_step = this->m_step;
+		return result.release();
+	}
+	Json CosineDecay::serialize(SerializedObject &binary_data) const
+	{
+		Json result = LearningRateSchedule::serialize(binary_data);
+		result["decay steps"] = m_decay_steps;
+		result["min multiplier"] = m_min_multiplier;
+		result["warmup steps"] = m_warmup_steps;
+		return result;
+	}
+	void CosineDecay::unserialize(const Json &json, const SerializedObject &binary_data)
+	{
+		LearningRateSchedule::unserialize(json, binary_data);
+		m_decay_steps = json["decay steps"].getLong();
+		m_min_multiplier = json["min multiplier"].getDouble();
+		m_warmup_steps = json["warmup steps"].getLong();
+	}
+
+} /* namespace avocado */
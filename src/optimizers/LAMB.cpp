@@ -0,0 +1,130 @@
+/*
+ * LAMB.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <Avocado/optimizers/LAMB.hpp>
+#include <Avocado/layers/Parameter.hpp>
+#include <Avocado/utils/json.hpp>
+#include <Avocado/core/Context.hpp>
+#include <Avocado/core/Scalar.hpp>
+#include <Avocado/utils/static_block.hpp>
+
+namespace avocado
+{
+	static_block
+	{
+		registerOptimizer(LAMB());
+	}
+
+	LAMB::LAMB(double learningRate, double weightDecay)
+	{
+		m_config.setType(OptimizerType::LAMB);
+		m_config.setLearningRate(learningRate);
+		m_config.setCoefficients(std::array<double, 4>( { 0.9, 0.999, weightDecay, 1.0e-6 }));
+	}
+
+	LAMB& LAMB::setBeta1(double beta1)
+	{
+		assert(beta1 >= 0.0f && beta1 < 1.0f);
+		std::array<double, 4> tmp = m_config.getCoefficients();
+		tmp[0] = beta1;
+		m_config.setCoefficients(tmp);
+		return *this;
+	}
+	LAMB& LAMB::setBeta2(double beta2)
+	{
+		assert(beta2 >= 0.0f && beta2 < 1.0f);
+		std::array<double, 4> tmp = m_config.getCoefficients();
+		tmp[1] = beta2;
+		m_config.setCoefficients(tmp);
+		return *this;
+	}
+	LAMB& LAMB::setEpsilon(double epsilon)
+	{
+		assert(epsilon > 0.0);
+		std::array<double, 4> tmp = m_config.getCoefficients();
+		tmp[3] = epsilon;
+		m_config.setCoefficients(tmp);
+		return *this;
+	}
+
+	float LAMB::getLearningRate() const noexcept
+	{
+		return m_config.getLearningRate();
+	}
+	void LAMB::setLearningRate(double learningRate) noexcept
+	{
+		m_config.setLearningRate(learningRate);
+	}
+	int LAMB::getSteps() const noexcept
+	{
+		return m_steps;
+	}
+
+	void LAMB::restart() noexcept
+	{
+		m_steps = 0;
+		if (m_workspace != nullptr)
+			m_workspace->zeroall();
+	}
+	void LAMB::moveTo(Device newDevice)
+	{
+		m_config.moveTo(newDevice);
+		if (m_workspace != nullptr)
+			m_workspace->moveTo(newDevice);
+	}
+	void LAMB::learn(const Context &context, Parameter &param, double learningRateMultiplier)
+	{
+		assert(same_device(context, param));
+		size_t length = param.getParam().volume();
+		if (length == 0)
+			return;
+
+		if (m_workspace == nullptr)
+			m_workspace = std::make_unique<Tensor>(Shape( { 2 * param.shape().volume() }), param.dtype(), param.device());
+		learn_step(context, m_config, m_steps, param, learningRateMultiplier, *m_workspace);
+		m_steps++;
+		param.getUpdate().zeroall();
+	}
+
+	std::string LAMB::name() const
+	{
+		return "LAMB";
+	}
+	LAMB* LAMB::clone() const
+	{
+		std::unique_ptr<LAMB> result = std::make_unique<LAMB>();
+		result->m_config = this->m_config;
+		result->m_steps = this->m_steps;
+		if (this->m_workspace != nullptr)
+			result->m_workspace = std::make_unique<Tensor>(*m_workspace);
+		return result.release();
+	}
+	Json LAMB::serialize(SerializedObject &binary_data) const
+	{
+		Json result;
+		result["name"] = name();
+		result["steps"] = m_steps;
+		result["learning rate"] = m_config.getLearningRate();
+		result["beta1"] = m_config.getCoefficients()[0];
+		result["beta2"] = m_config.getCoefficients()[1];
+		result["weight decay"] = m_config.getCoefficients()[2];
+		result["epsilon"] = m_config.getCoefficients()[3];
+		result["workspace"] = (m_workspace == nullptr) ? Json() : m_workspace->serialize(binary_data);
+		return result;
+	}
+	void LAMB::unserialize(const Json &json, const SerializedObject &binary_data)
+	{
+		m_config.setType(OptimizerType::LAMB);
+		m_config.setLearningRate(json["learning rate"].getDouble());
+		m_steps = json["steps"].getLong();
+		std::array<double, 4> coef = { json["beta1"].getDouble(), json["beta2"].getDouble(), json["weight decay"].getDouble(),
+				json["epsilon"].getDouble() };
+		m_config.setCoefficients(coef);
+		m_workspace = json["workspace"].isNull() ? nullptr : std::make_unique<Tensor>(json["workspace"], binary_data);
+	}
+
+} /* namespace avocado */
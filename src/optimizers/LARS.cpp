@@ -0,0 +1,117 @@
+/*
+ * LARS.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <Avocado/optimizers/LARS.hpp>
+#include <Avocado/layers/Parameter.hpp>
+#include <Avocado/utils/json.hpp>
+#include <Avocado/core/Context.hpp>
+#include <Avocado/core/Scalar.hpp>
+#include <Avocado/core/Device.hpp>
+#include <Avocado/utils/static_block.hpp>
+
+#include <array>
+
+namespace avocado
+{
+	static_block
+	{
+		registerOptimizer(LARS());
+	}
+
+	LARS::LARS(double learningRate, double beta, double trustCoefficient, double weightDecay, bool useNesterov)
+	{
+		m_config.setType(OptimizerType::LARS);
+		m_config.setLearningRate(learningRate);
+		m_config.setCoefficients(std::array<double, 4>( { beta, trustCoefficient, weightDecay, 1.0e-9 }));
+		m_config.setFlags(std::array<bool, 4>( { useNesterov, false, false, false }));
+	}
+
+	float LARS::getLearningRate() const noexcept
+	{
+		return m_config.getLearningRate();
+	}
+	void LARS::setLearningRate(double learningRate) noexcept
+	{
+		m_config.setLearningRate(learningRate);
+	}
+	int LARS::getSteps() const noexcept
+	{
+		return m_steps;
+	}
+
+	void LARS::restart() noexcept
+	{
+		m_steps = 0;
+		if (m_workspace != nullptr)
+			m_workspace->zeroall();
+	}
+	void LARS::moveTo(Device newDevice)
+	{
+		m_config.moveTo(newDevice);
+		if (m_workspace != nullptr)
+			m_workspace->moveTo(newDevice);
+	}
+	void LARS::learn(const Context &context, Parameter &param, double learningRateMultiplier)
+	{
+		assert(same_device(context, param));
+		size_t length = param.getParam().volume();
+		if (length == 0)
+			return;
+
+		if (m_workspace == nullptr)
+		{
+			if (m_config.getCoefficients()[0] != 0.0)
+				m_workspace = std::make_unique<Tensor>(param.shape(), param.dtype(), param.device());
+			else
+				m_workspace = std::make_unique<Tensor>(Shape(), param.dtype(), param.device());
+		}
+		learn_step(context, m_config, m_steps, param, learningRateMultiplier, *m_workspace);
+		m_steps++;
+		param.getUpdate().zeroall();
+	}
+
+	std::string LARS::name() const
+	{
+		return "LARS";
+	}
+	LARS* LARS::clone() const
+	{
+		std::unique_ptr<LARS> result = std::make_unique<LARS>();
+		result->m_config = this->m_config;
+		result->m_steps = this->m_steps;
+		if (this->m_workspace != nullptr)
+			result->m_workspace = std::make_unique<Tensor>(*m_workspace);
+		return result.release();
+	}
+	Json LARS::serialize(SerializedObject &binary_data) const
+	{
+		Json result;
+		result["name"] = name();
+		result["steps"] = m_steps;
+		result["learning rate"] = m_config.getLearningRate();
+		result["beta"] = m_config.getCoefficients()[0];
+		result["trust coefficient"] = m_config.getCoefficients()[1];
+		result["weight decay"] = m_config.getCoefficients()[2];
+		result["epsilon"] = m_config.getCoefficients()[3];
+		result["use_nesterov"] = m_config.getFlags()[0];
+		result["workspace"] = (m_workspace == nullptr) ? Json() : m_workspace->serialize(binary_data);
+		return result;
+	}
+	void LARS::unserialize(const Json &json, const SerializedObject &binary_data)
+	{
+		m_config.setType(OptimizerType::LARS);
+		m_config.setLearningRate(json["learning rate"].getDouble());
+		m_steps = json["steps"].getLong();
+		std::array<double, 4> coef = { json["beta"].getDouble(), json["trust coefficient"].getDouble(), json["weight decay"].getDouble(),
+				json["epsilon"].getDouble() };
+		std::array<bool, 4> flags = { json["use_nesterov"].getBool(), false, false, false };
+		m_config.setCoefficients(coef);
+		m_config.setFlags(flags);
+		m_workspace = json["workspace"].isNull() ? nullptr : std::make_unique<Tensor>(json["workspace"], binary_data);
+	}
+
+} /* namespace avocado */
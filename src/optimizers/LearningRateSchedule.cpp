@@ -0,0 +1,70 @@
+/*
+ * LearningRateSchedule.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <Avocado/optimizers/LearningRateSchedule.hpp>
+#include <Avocado/utils/json.hpp>
+#include <Avocado/core/error_handling.hpp>
+
+#include <unordered_map>
+
+namespace
+{
+	std::unordered_map<std::string, std::unique_ptr<avocado::LearningRateSchedule>>& registered_schedules()
+	{
+		static std::unordered_map<std::string, std::unique_ptr<avocado::LearningRateSchedule>> result;
+		return result;
+	}
+}
+
+namespace avocado
+{
+	double LearningRateSchedule::next() noexcept
+	{
+		const double result = getMultiplier(m_step);
+		m_step++;
+		return result;
+	}
+	int64_t LearningRateSchedule::getStep() const noexcept
+	{
+		return m_step;
+	}
+	void LearningRateSchedule::setStep(int64_t step) noexcept
+	{
+		m_step = step;
+	}
+
+	Json LearningRateSchedule::serialize(SerializedObject &binary_data) const
+	{
+		Json result;
+		result["name"] = name();
+		result["step"] = m_step;
+		return result;
+	}
+	void LearningRateSchedule::unserialize(const Json &json, const SerializedObject &binary_data)
+	{
+		m_step = json["step"].getLong();
+	}
+
+	void registerLearningRateSchedule(const LearningRateSchedule &schedule)
+	{
+		if (registered_schedules().find(schedule.name()) == registered_schedules().end())
+			registered_schedules()[schedule.name()] = std::unique_ptr<LearningRateSchedule>(schedule.clone());
+		else
+			throw LogicError(METHOD_NAME, "learning rate schedule '" + schedule.name() + "' has already been registered");
+	}
+	std::unique_ptr<LearningRateSchedule> loadLearningRateSchedule(const Json &json, const SerializedObject &binary_data)
+	{
+		auto schedule = registered_schedules().find(json["name"]);
+		if (schedule == registered_schedules().end())
+			throw LogicError(METHOD_NAME, "unknown learning rate schedule '" + static_cast<std::string>(json["name"]) + "'");
+
+		std::unique_ptr<LearningRateSchedule> result(schedule->second->clone());
+		result->unserialize(json, binary_data);
+		return result;
+	}
+
+} /* namespace avocado */
@@ -0,0 +1,58 @@
+/*
+ * LinearWarmup.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <Avocado/optimizers/LinearWarmup.hpp>
+#include <Avocado/utils/json.hpp>
+#include <Avocado/core/error_handling.hpp>
+#include <Avocado/utils/static_block.hpp>
+
+namespace avocado
+{
+	static_block
+	{
+		registerLearningRateSchedule(LinearWarmup());
+	}
+
+	LinearWarmup::LinearWarmup(int64_t warmupSteps) :
+			m_warmup_steps(warmupSteps)
+	{
+		if (warmupSteps < 1)
+			throw IllegalArgument(METHOD_NAME, "warmupSteps", "must be positive", static_cast<int>(warmupSteps));
+	}
+
+	double LinearWarmup::getMultiplier(int64_t step) const noexcept
+	{
+		if (step < m_warmup_steps)
+			return static_cast<double>(step + 1) / m_warmup_steps;
+		else
+			return 1.0;
+	}
+
+	std::string LinearWarmup::name() const
+	{
+		return "LinearWarmup";
+	}
+	LinearWarmup* LinearWarmup::clone() const
+	{
+		std::unique_ptr<LinearWarmup> result = std::make_unique<LinearWarmup>();
+		result->m_warmup_steps = this->m_warmup_steps;
+		result->m_step = this->m_step;
+		return result.release();
+	}
+	Json LinearWarmup::serialize(SerializedObject &binary_data) const
+	{
+		Json result = LearningRateSchedule::serialize(binary_data);
+		result["warmup steps"] = m_warmup_steps;
+		return result;
+	}
+	void LinearWarmup::unserialize(const Json &json, const SerializedObject &binary_data)
+	{
+		LearningRateSchedule::unserialize(json, binary_data);
+		m_warmup_steps = json["warmup steps"].getLong();
+	}
+
+} /* namespace avocado */
@@ -0,0 +1,178 @@
+/*
+ * OffloadedWorkspace.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <Avocado/optimizers/OffloadedWorkspace.hpp>
+#include <Avocado/core/Tensor.hpp>
+#include <Avocado/core/Context.hpp>
+#include <Avocado/core/Scalar.hpp>
+#include <Avocado/core/error_handling.hpp>
+#include <Avocado/math/training.hpp>
+#include <Avocado/utils/json.hpp>
+#include <Avocado/utils/serialization.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+namespace
+{
+	/* asks the system to start reading given range of the mapping in the background */
+	void prefetch(char *data, size_t offset, size_t sizeInBytes) noexcept
+	{
+		const size_t page_size = ::sysconf(_SC_PAGESIZE);
+		const size_t begin = offset / page_size * page_size; // madvise() requires page aligned address
+		::madvise(data + begin, offset + sizeInBytes - begin, MADV_WILLNEED);
+	}
+}
+
+namespace avocado
+{
+	OffloadedWorkspace::OffloadedWorkspace(const std::string &directory, int64_t volume, DataType dtype, int chunkSize) :
+			m_directory(directory),
+			m_size_in_bytes(sizeOf(dtype) * volume),
+			m_volume(volume),
+			m_dtype(dtype),
+			m_chunk_size(chunkSize)
+	{
+		if (volume < 0)
+			throw IllegalArgument(METHOD_NAME, "volume must not be negative");
+		if (chunkSize < 1)
+			throw IllegalArgument(METHOD_NAME, "chunkSize", "must be positive", chunkSize);
+		create_mapping();
+	}
+	OffloadedWorkspace::OffloadedWorkspace(const std::string &directory, const Json &json, const SerializedObject &binary_data, int chunkSize) :
+			OffloadedWorkspace(directory, Shape(json["shape"]).volume(), typeFromString(json["dtype"]), chunkSize)
+	{
+		if (m_size_in_bytes > 0)
+			binary_data.load(m_data, static_cast<size_t>(json["binary_offset"]), m_size_in_bytes);
+	}
+	OffloadedWorkspace::OffloadedWorkspace(const OffloadedWorkspace &other) :
+			OffloadedWorkspace(other.m_directory, other.m_volume, other.m_dtype, other.m_chunk_size)
+	{
+		if (m_size_in_bytes > 0)
+			std::memcpy(m_data, other.m_data, m_size_in_bytes);
+	}
+	OffloadedWorkspace::~OffloadedWorkspace()
+	{
+		if (m_data != nullptr)
+			::munmap(m_data, m_size_in_bytes); // the file has already been unlinked, so it is removed together with the mapping
+	}
+
+	const std::string& OffloadedWorkspace::directory() const noexcept
+	{
+		return m_directory;
+	}
+	int64_t OffloadedWorkspace::volume() const noexcept
+	{
+		return m_volume;
+	}
+	DataType OffloadedWorkspace::dtype() const noexcept
+	{
+		return m_dtype;
+	}
+	int OffloadedWorkspace::chunkSize() const noexcept
+	{
+		return m_chunk_size;
+	}
+
+	void OffloadedWorkspace::zeroall()
+	{
+		if (m_size_in_bytes > 0)
+			std::memset(m_data, 0, m_size_in_bytes);
+	}
+	void OffloadedWorkspace::releaseStaging() noexcept
+	{
+		m_staging = nullptr;
+	}
+	void OffloadedWorkspace::learn(const Context &context, OptimizerConfig &config, const Scalar &alpha, const Scalar &beta, Tensor &weight,
+			Tensor &update, double gradientScale, Tensor *average, double averageDecay)
+	{
+		if (config.getType() == OptimizerType::LARS or config.getType() == OptimizerType::LAMB)
+			throw LogicError(METHOD_NAME, "layer-wise adaptive optimizers cannot use offloaded workspace");
+		if (weight.dtype() != m_dtype)
+			throw DataTypeMismatch(METHOD_NAME, m_dtype, weight.dtype());
+		const int64_t length = weight.volume();
+		if (length == 0)
+			return;
+		if (m_volume % length != 0)
+			throw IllegalArgument(METHOD_NAME, "workspace volume must be a multiple of the weight volume");
+
+		const int slots = m_volume / length;
+		const int max_count = std::min(static_cast<int64_t>(m_chunk_size), length);
+		if (m_staging == nullptr or m_staging->device() != weight.device() or m_staging->volume() < slots * max_count)
+			m_staging = std::make_unique<Tensor>(Shape( { slots * max_count }), m_dtype, weight.device());
+
+		const size_t element_size = sizeOf(m_dtype);
+		const int64_t steps = config.getSteps(); // every chunk must be updated as the same step
+		for (int s = 0; s < slots; s++)
+			prefetch(m_data, element_size * s * length, element_size * max_count);
+		for (int64_t offset = 0; offset < length; offset += m_chunk_size)
+		{
+			const int count = std::min(static_cast<int64_t>(m_chunk_size), length - offset);
+			const int next_count = std::min(static_cast<int64_t>(m_chunk_size), length - offset - count);
+			if (next_count > 0)
+				for (int s = 0; s < slots; s++)
+					prefetch(m_data, element_size * (s * length + offset + count), element_size * next_count);
+
+			for (int s = 0; s < slots; s++)
+				m_staging->view(Shape( { count }), s * count).copyFromHost(m_data + element_size * (s * length + offset), count);
+			Tensor workspace = m_staging->view(Shape( { slots * count }));
+			Tensor weight_chunk = weight.view(Shape( { count }), offset);
+			Tensor update_chunk = update.view(Shape( { count }), offset);
+			Tensor average_chunk;
+			if (average != nullptr)
+				average_chunk = average->view(Shape( { count }), offset);
+
+			config.setSteps(steps);
+			math::optimizerLearn(context, config, alpha, beta, weight_chunk, update_chunk, workspace, gradientScale,
+					(average == nullptr) ? nullptr : &average_chunk, averageDecay);
+			context.synchronize();
+			for (int s = 0; s < slots; s++)
+				m_staging->view(Shape( { count }), s * count).copyToHost(m_data + element_size * (s * length + offset), count);
+		}
+		config.setSteps(steps + 1);
+	}
+	Json OffloadedWorkspace::serialize(SerializedObject &binary_data) const
+	{
+		Json result;
+		result["shape"] = Shape( { static_cast<int>(m_volume) }).toJson();
+		result["dtype"] = toString(m_dtype);
+		result["binary_offset"] = binary_data.size();
+		if (m_size_in_bytes > 0)
+			binary_data.save(m_data, m_size_in_bytes);
+		return result;
+	}
+
+	void OffloadedWorkspace::create_mapping()
+	{
+		if (m_size_in_bytes == 0)
+			return;
+		std::string tmp = m_directory + "/avocado_workspace_XXXXXX";
+		std::vector<char> path(tmp.begin(), tmp.end());
+		path.push_back('\0');
+		const int fd = ::mkstemp(path.data());
+		if (fd == -1)
+			throw RuntimeError(METHOD_NAME, "could not create file in '" + m_directory + "'");
+		::unlink(path.data()); // the file is accessible only through the mapping from now on
+		if (::ftruncate(fd, m_size_in_bytes) == -1) // new file is sparse and reads as zeros
+		{
+			::close(fd);
+			throw RuntimeError(METHOD_NAME, "could not allocate " + std::to_string(m_size_in_bytes) + " bytes in '" + m_directory + "'");
+		}
+		void *ptr = ::mmap(nullptr, m_size_in_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		::close(fd); // the mapping keeps the file open
+		if (ptr == MAP_FAILED)
+			throw RuntimeError(METHOD_NAME, "could not map file in '" + m_directory + "'");
+		m_data = reinterpret_cast<char*>(ptr);
+		::madvise(ptr, m_size_in_bytes, MADV_SEQUENTIAL); // updates always traverse the workspace in order
+	}
+
+} /* namespace avocado */
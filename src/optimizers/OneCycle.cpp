@@ -0,0 +1,87 @@
+/*
+ * OneCycle.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <Avocado/optimizers/OneCycle.hpp>
+#include <Avocado/utils/json.hpp>
+#include <Avocado/core/error_handling.hpp>
+#include <Avocado/utils/static_block.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace avocado
+{
+	static_block
+	{
+		registerLearningRateSchedule(OneCycle());
+	}
+
+	OneCycle::OneCycle(int64_t totalSteps, double pctStart, double divFactor, double finalDivFactor) :
+			m_total_steps(totalSteps),
+			m_pct_start(pctStart),
+			m_div_factor(divFactor),
+			m_final_div_factor(finalDivFactor)
+	{
+		if (totalSteps < 2)
+			throw IllegalArgument(METHOD_NAME, "totalSteps", "must be at least 2", static_cast<int>(totalSteps));
+		if (pctStart <= 0.0 or pctStart >= 1.0)
+			throw IllegalArgument(METHOD_NAME, "pctStart must be in range (0, 1)");
+		if (divFactor < 1.0 or finalDivFactor < 1.0)
+			throw IllegalArgument(METHOD_NAME, "division factors must not be smaller than 1");
+	}
+
+	double OneCycle::getMultiplier(int64_t step) const noexcept
+	{
+		const double initial = 1.0 / m_div_factor;
+		const double lowest = initial / m_final_div_factor;
+		const int64_t peak_step = std::max(static_cast<int64_t>(1), static_cast<int64_t>(m_pct_start * m_total_steps));
+		if (step < peak_step)
+		{
+			const double t = static_cast<double>(step) / peak_step;
+			return initial + (1.0 - initial) * 0.5 * (1.0 - std::cos(M_PI * t));
+		}
+		else
+		{
+			const int64_t decay_steps = std::max(static_cast<int64_t>(1), m_total_steps - 1 - peak_step);
+			const double t = std::min(1.0, static_cast<double>(step - peak_step) / decay_steps);
+			return lowest + (1.0 - lowest) * 0.5 * (1.0 + std::cos(M_PI * t));
+		}
+	}
+
+	std::string OneCycle::name() const
+	{
+		return "OneCycle";
+	}
+	OneCycle* OneCycle::clone() const
+	{
+		std::unique_ptr<OneCycle> result = std::make_unique<OneCycle>();
+		result->m_total_steps = this->m_total_steps;
+		result->m_pct_start = this->m_pct_start;
+		result->m_div_factor = this->m_div_factor;
+		result->m_final_div_factor = this->m_final_div_factor;
+		result->m_step = this->m_step;
+		return result.release();
+	}
+	Json OneCycle::serialize(SerializedObject &binary_data) const
+	{
+		Json result = LearningRateSchedule::serialize(binary_data);
+		result["total steps"] = m_total_steps;
+		result["pct start"] = m_pct_start;
+		result["div factor"] = m_div_factor;
+		result["final div factor"] = m_final_div_factor;
+		return result;
+	}
+	void OneCycle::unserialize(const Json &json, const SerializedObject &binary_data)
+	{
+		LearningRateSchedule::unserialize(json, binary_data);
+		m_total_steps = json["total steps"].getLong();
+		m_pct_start = json["pct start"].getDouble();
+		m_div_factor = json["div factor"].getDouble();
+		m_final_div_factor = json["final div factor"].getDouble();
+	}
+
+} /* namespace avocado */
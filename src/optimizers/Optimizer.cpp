@@ -6,6 +6,10 @@
  */
 
 #include <Avocado/optimizers/Optimizer.hpp>
+#include <Avocado/optimizers/OffloadedWorkspace.hpp>
+#include <Avocado/layers/Parameter.hpp>
+#include <Avocado/math/training.hpp>
+#include <Avocado/core/Scalar.hpp>
 #include <Avocado/utils/json.hpp>
 #include <Avocado/core/error_handling.hpp>
 
@@ -13,6 +17,13 @@
 
 namespace
 {
+	using namespace avocado;
+
+	/* factor the parameter is multiplied by for decoupled weight decay */
+	double get_decay(const OptimizerConfig &config, const Parameter &param, double learningRateMultiplier)
+	{
+		return 1.0 - learningRateMultiplier * config.getLearningRate() * param.getWeightDecay();
+	}
 	std::unordered_map<std::string, std::unique_ptr<avocado::Optimizer>>& registered_optimizers()
 	{
 		static std::unordered_map<std::string, std::unique_ptr<avocado::Optimizer>> result;
@@ -22,6 +33,28 @@ namespace
 
 namespace avocado
 {
+	void Optimizer::learn_step(const Context &context, OptimizerConfig &config, Parameter &param, double learningRateMultiplier,
+			Tensor &workspace)
+	{
+		Tensor *average = param.hasAverage() ? &(param.getAverage()) : nullptr;
+		math::optimizerLearn(context, config, learningRateMultiplier, get_decay(config, param, learningRateMultiplier), param.mutableParam(),
+				param.getUpdate(), workspace, param.getGradientScale(), average, param.getAveragingDecay());
+	}
+	void Optimizer::learn_step(const Context &context, OptimizerConfig &config, Parameter &param, double learningRateMultiplier,
+			OffloadedWorkspace &workspace)
+	{
+		Tensor *average = param.hasAverage() ? &(param.getAverage()) : nullptr;
+		workspace.learn(context, config, learningRateMultiplier, get_decay(config, param, learningRateMultiplier), param.mutableParam(),
+				param.getUpdate(), param.getGradientScale(), average, param.getAveragingDecay());
+	}
+	void Optimizer::learn_step(const Context &context, const OptimizerConfig &config, int64_t step, Parameter &param,
+			double learningRateMultiplier, Tensor &workspace)
+	{
+		Tensor *average = param.hasAverage() ? &(param.getAverage()) : nullptr;
+		math::layerwiseAdaptiveLearn(context, config, step, learningRateMultiplier, get_decay(config, param, learningRateMultiplier),
+				param.mutableParam(), param.getUpdate(), workspace, param.getGradientScale(), average, param.getAveragingDecay());
+	}
+
 	void registerOptimizer(const Optimizer &opt)
 	{
 		if (registered_optimizers().find(opt.name()) == registered_optimizers().end())
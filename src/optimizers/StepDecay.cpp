@@ -0,0 +1,61 @@
+/*
+ * StepDecay.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <Avocado/optimizers/StepDecay.hpp>
+#include <Avocado/utils/json.hpp>
+#include <Avocado/core/error_handling.hpp>
+#include <Avocado/utils/static_block.hpp>
+
+#include <cmath>
+
+namespace avocado
+{
+	static_block
+	{
+		registerLearningRateSchedule(StepDecay());
+	}
+
+	StepDecay::StepDecay(int64_t stepSize, double gamma) :
+			m_step_size(stepSize),
+			m_gamma(gamma)
+	{
+		if (stepSize < 1)
+			throw IllegalArgument(METHOD_NAME, "stepSize", "must be positive", static_cast<int>(stepSize));
+	}
+
+	double StepDecay::getMultiplier(int64_t step) const noexcept
+	{
+		return std::pow(m_gamma, static_cast<double>(step / m_step_size));
+	}
+
+	std::string StepDecay::name() const
+	{
+		return "StepDecay";
+	}
+	StepDecay* StepDecay::clone() const
+	{
+		std::unique_ptr<StepDecay> result = std::make_unique<StepDecay>();
+		result->m_step_size = this->m_step_size;
+		result->m_gamma = this->m_gamma;
+		result->m_step = this->m_step;
+		return result.release();
+	}
+	Json StepDecay::serialize(SerializedObject &binary_data) const
+	{
+		Json result = LearningRateSchedule::serialize(binary_data);
+		result["step size"] = m_step_size;
+		result["gamma"] = m_gamma;
+		return result;
+	}
+	void StepDecay::unserialize(const Json &json, const SerializedObject &binary_data)
+	{
+		LearningRateSchedule::unserialize(json, binary_data);
+		m_step_size = json["step size"].getLong();
+		m_gamma = json["gamma"].getDouble();
+	}
+
+} /* namespace avocado */
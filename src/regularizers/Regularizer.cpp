@@ -22,6 +22,11 @@ namespace
 
 namespace avocado
 {
+	double Regularizer::getWeightDecay() const noexcept
+	{
+		return 0.0;
+	}
+
 	void registerRegularizer(const Regularizer &reg)
 	{
 		if (registered_regularizers().find(reg.name()) == registered_regularizers().end())
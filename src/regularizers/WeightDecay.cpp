@@ -0,0 +1,55 @@
+/*
+ * WeightDecay.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <Avocado/regularizers/WeightDecay.hpp>
+#include <Avocado/core/error_handling.hpp>
+#include <Avocado/utils/json.hpp>
+#include <Avocado/utils/static_block.hpp>
+
+namespace avocado
+{
+	static_block
+	{
+		registerRegularizer(WeightDecay());
+	}
+
+	WeightDecay::WeightDecay(double decay) :
+			m_decay(decay)
+	{
+		if (decay < 0.0)
+			throw IllegalArgument(METHOD_NAME, "decay must not be negative");
+	}
+
+	void WeightDecay::apply(const Context &context, Parameter &param)
+	{
+		// applied by the optimizer
+	}
+	double WeightDecay::getWeightDecay() const noexcept
+	{
+		return m_decay;
+	}
+
+	std::string WeightDecay::name() const
+	{
+		return "WeightDecay";
+	}
+	WeightDecay* WeightDecay::clone() const
+	{
+		return new WeightDecay(this->m_decay);
+	}
+	Json WeightDecay::serialize(SerializedObject &binary_data) const
+	{
+		Json result;
+		result["name"] = name();
+		result["decay"] = m_decay;
+		return result;
+	}
+	void WeightDecay::unserialize(const Json &json, const SerializedObject &binary_data)
+	{
+		m_decay = json["decay"];
+	}
+} /* namespace avocado */
@@ -0,0 +1,181 @@
+/*
+ * test_Context.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <Avocado/core/Context.hpp>
+#include <Avocado/core/Device.hpp>
+#include <Avocado/core/error_handling.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+	using namespace avocado;
+
+	void write_file(const std::filesystem::path &path, const std::string &content)
+	{
+		std::filesystem::create_directories(path.parent_path());
+		std::ofstream file(path);
+		file << content << '\n';
+	}
+	/* 2 sockets (with package ids 0 and 3), each with 2 cores, own L1 and shared L3, forming one NUMA node */
+	std::filesystem::path create_sysfs()
+	{
+		const std::filesystem::path root = std::filesystem::temp_directory_path() / "avocado_test_sysfs";
+		std::filesystem::remove_all(root);
+		write_file(root / "cpu" / "online", "0-3");
+		for (int i = 0; i < 4; i++)
+		{
+			const std::filesystem::path cpu = root / "cpu" / ("cpu" + std::to_string(i));
+			write_file(cpu / "topology" / "core_id", std::to_string(i % 2));
+			write_file(cpu / "topology" / "physical_package_id", (i < 2) ? "0" : "3");
+			write_file(cpu / "cache" / "index0" / "level", "1");
+			write_file(cpu / "cache" / "index0" / "size", "32K");
+			write_file(cpu / "cache" / "index0" / "type", "Data");
+			write_file(cpu / "cache" / "index0" / "shared_cpu_list", std::to_string(i));
+			write_file(cpu / "cache" / "index1" / "level", "3");
+			write_file(cpu / "cache" / "index1" / "size", "8M");
+			write_file(cpu / "cache" / "index1" / "type", "Unified");
+			write_file(cpu / "cache" / "index1" / "shared_cpu_list", (i < 2) ? "0-1" : "2-3");
+		}
+		write_file(root / "node" / "online", "0-1");
+		write_file(root / "node" / "node0" / "cpulist", "0-1");
+		write_file(root / "node" / "node1" / "cpulist", "2,3");
+		return root;
+	}
+	CpuTopology create_topology(const std::vector<int> &coresPerNode)
+	{
+		CpuTopology result;
+		int index = 0;
+		for (size_t i = 0; i < coresPerNode.size(); i++)
+		{
+			result.numaNodes.push_back(std::vector<int>());
+			for (int j = 0; j < coresPerNode[i]; j++, index++)
+			{
+				CpuTopology::Core core;
+				core.index = index;
+				core.numaNode = i;
+				result.cores.push_back(core);
+				result.numaNodes.back().push_back(index);
+			}
+		}
+		return result;
+	}
+	void check_partition(const std::vector<ThreadGroup> &groups, const CpuTopology &topology)
+	{
+		std::vector<int> all_cores;
+		for (size_t i = 0; i < groups.size(); i++)
+			all_cores.insert(all_cores.end(), groups[i].cores().begin(), groups[i].cores().end());
+		std::sort(all_cores.begin(), all_cores.end());
+		EXPECT_TRUE(std::adjacent_find(all_cores.begin(), all_cores.end()) == all_cores.end()); // groups are disjoint
+		EXPECT_EQ(static_cast<int>(all_cores.size()), topology.numberOfCores()); // and cover all cores
+	}
+}
+
+namespace avocado
+{
+	TEST(TestCpuTopology, parse_sysfs)
+	{
+		const std::filesystem::path root = create_sysfs();
+		const CpuTopology topology = CpuTopology::fromSysfs(root.string());
+		std::filesystem::remove_all(root);
+
+		EXPECT_EQ(topology.numberOfCores(), 4);
+		EXPECT_EQ(topology.sockets, 2);
+		EXPECT_EQ(topology.coresOfSocket(0), std::vector<int>( { 0, 1 }));
+		EXPECT_EQ(topology.coresOfSocket(1), std::vector<int>( { 2, 3 }));
+		EXPECT_EQ(topology.cores[3].physicalCore, 1);
+
+		EXPECT_EQ(topology.numberOfNumaNodes(), 2);
+		EXPECT_EQ(topology.coresOfNumaNode(0), std::vector<int>( { 0, 1 }));
+		EXPECT_EQ(topology.coresOfNumaNode(1), std::vector<int>( { 2, 3 }));
+		EXPECT_EQ(topology.cores[2].numaNode, 1);
+
+		EXPECT_EQ(topology.caches.size(), 6u); // shared caches are listed once
+		EXPECT_EQ(topology.cacheSize(1, 2), 32 * 1024);
+		EXPECT_EQ(topology.cacheSize(3, 2), 8 * 1024 * 1024);
+		EXPECT_EQ(topology.cacheSize(2, 2), 0);
+	}
+	TEST(TestCpuTopology, parse_missing_numa)
+	{
+		const std::filesystem::path root = create_sysfs();
+		std::filesystem::remove_all(root / "node");
+		const CpuTopology topology = CpuTopology::fromSysfs(root.string());
+		std::filesystem::remove_all(root);
+
+		EXPECT_EQ(topology.numberOfNumaNodes(), 1);
+		EXPECT_EQ(topology.coresOfNumaNode(0), std::vector<int>( { 0, 1, 2, 3 }));
+	}
+
+	TEST(TestThreadGroup, partition_within_nodes)
+	{
+		const CpuTopology topology = create_topology( { 4, 4 });
+		const std::vector<ThreadGroup> groups = ThreadGroup::partition(4, topology);
+		ASSERT_EQ(groups.size(), 4u);
+		check_partition(groups, topology);
+		for (size_t i = 0; i < groups.size(); i++)
+		{
+			EXPECT_EQ(groups[i].size(), 2);
+			EXPECT_EQ(groups[i].numaNode(), static_cast<int>(i) / 2);
+			for (int core : groups[i].cores())
+				EXPECT_EQ(topology.cores[core].numaNode, groups[i].numaNode());
+		}
+	}
+	TEST(TestThreadGroup, partition_uneven)
+	{
+		const CpuTopology topology = create_topology( { 5, 3 });
+		const std::vector<ThreadGroup> groups = ThreadGroup::partition(3, topology);
+		ASSERT_EQ(groups.size(), 3u);
+		check_partition(groups, topology);
+		EXPECT_EQ(groups[0].numaNode(), 0);
+		EXPECT_EQ(groups[1].numaNode(), 0);
+		EXPECT_EQ(groups[2].numaNode(), 1);
+		EXPECT_EQ(groups[2].size(), 3);
+	}
+	TEST(TestThreadGroup, partition_merge_nodes)
+	{
+		const CpuTopology topology = create_topology( { 2, 2, 2, 2 });
+		const std::vector<ThreadGroup> groups = ThreadGroup::partition(2, topology);
+		ASSERT_EQ(groups.size(), 2u);
+		check_partition(groups, topology);
+		EXPECT_EQ(groups[0].cores(), std::vector<int>( { 0, 1, 2, 3 }));
+		EXPECT_EQ(groups[1].cores(), std::vector<int>( { 4, 5, 6, 7 }));
+		EXPECT_EQ(groups[0].numaNode(), -1);
+		EXPECT_EQ(groups[1].numaNode(), -1);
+
+		EXPECT_EQ(ThreadGroup::partition(1, create_topology( { 4 }))[0].numaNode(), 0);
+	}
+	TEST(TestThreadGroup, partition_small_nodes)
+	{
+		const CpuTopology topology = create_topology( { 5, 1 });
+		const std::vector<ThreadGroup> groups = ThreadGroup::partition(4, topology);
+		ASSERT_EQ(groups.size(), 4u);
+		check_partition(groups, topology);
+		for (size_t i = 0; i < groups.size(); i++)
+			EXPECT_FALSE(groups[i].isEmpty());
+		EXPECT_EQ(groups[3].cores(), std::vector<int>( { 5 }));
+
+		EXPECT_EQ(ThreadGroup::partition(6, topology).size(), 6u);
+		EXPECT_THROW(ThreadGroup::partition(7, topology), IllegalArgument); // more groups than cores
+	}
+	TEST(TestThreadGroup, partition_empty_topology)
+	{
+		EXPECT_THROW(ThreadGroup::partition(1, CpuTopology()), IllegalArgument);
+		EXPECT_THROW(ThreadGroup::partition(1, create_topology( { 0, 0 })), IllegalArgument);
+	}
+	TEST(TestThreadGroup, partition_this_machine)
+	{
+		const CpuTopology &topology = Device::cpuTopology();
+		for (int n = 1; n <= std::min(4, topology.numberOfCores()); n++)
+			check_partition(ThreadGroup::partition(n), topology);
+		EXPECT_THROW(ThreadGroup::partition(0), IllegalArgument);
+	}
+
+} /* namespace avocado */
@@ -0,0 +1,52 @@
+/*
+ * test_MemoryTracker.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <Avocado/core/MemoryTracker.hpp>
+#include <Avocado/core/Context.hpp>
+#include <Avocado/core/Tensor.hpp>
+
+#include <gtest/gtest.h>
+
+namespace avocado
+{
+	TEST(TestMemoryTracker, categories)
+	{
+		Context context;
+		const MemoryUsage before = context.getMemoryUsage();
+		{
+			MemoryCategoryScope scope(MemoryCategory::ACTIVATIONS);
+			Tensor t( { 100 }, DataType::FLOAT32, Device::cpu());
+			EXPECT_EQ(t.memoryCategory(), MemoryCategory::ACTIVATIONS);
+
+			MemoryUsage usage = context.getMemoryUsage();
+			EXPECT_EQ(usage.total, before.total + 400);
+			EXPECT_EQ(usage[MemoryCategory::ACTIVATIONS], before[MemoryCategory::ACTIVATIONS] + 400);
+
+			t.setMemoryCategory(MemoryCategory::GRADIENTS);
+			usage = context.getMemoryUsage();
+			EXPECT_EQ(usage[MemoryCategory::ACTIVATIONS], before[MemoryCategory::ACTIVATIONS]);
+			EXPECT_EQ(usage[MemoryCategory::GRADIENTS], before[MemoryCategory::GRADIENTS] + 400);
+
+			Tensor copy(t);
+			EXPECT_EQ(copy.memoryCategory(), MemoryCategory::GRADIENTS);
+			EXPECT_EQ(t.view().memoryCategory(), MemoryCategory::GRADIENTS);
+		}
+		EXPECT_EQ(context.getMemoryUsage().total, before.total);
+		EXPECT_EQ(MemoryTracker::currentCategory(), MemoryCategory::OTHER);
+	}
+	TEST(TestMemoryTracker, peak_watcher)
+	{
+		MemoryTracker::PeakWatcher watcher(Device::cpu());
+		const size_t before = MemoryTracker::getCurrentUsage(Device::cpu()).total;
+		{
+			Tensor t( { 1000 }, DataType::FLOAT64, Device::cpu());
+		}
+		EXPECT_EQ(MemoryTracker::getCurrentUsage(Device::cpu()).total, before);
+		EXPECT_GE(watcher.getPeak().total, before + 8000);
+	}
+
+} /* namespace avocado */
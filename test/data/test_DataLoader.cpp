@@ -0,0 +1,123 @@
+/*
+ * test_DataLoader.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <Avocado/data/DataLoader.hpp>
+#include <Avocado/data/Dataset.hpp>
+#include <Avocado/graph/Graph.hpp>
+#include <Avocado/core/Tensor.hpp>
+#include <Avocado/core/Scalar.hpp>
+
+#include <set>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+	using namespace avocado;
+
+	/* sample i has input (i, -i) and target (2i, 0), sample 'broken_index' throws */
+	class IndexDataset: public Dataset
+	{
+		private:
+			size_t m_size;
+			size_t m_broken_index;
+		public:
+			IndexDataset(size_t size, size_t brokenIndex = -1) :
+					m_size(size),
+					m_broken_index(brokenIndex)
+			{
+			}
+			size_t size() const
+			{
+				return m_size;
+			}
+			void load(size_t index, std::vector<Tensor> &rows) const
+			{
+				if (index == m_broken_index)
+					throw std::runtime_error("broken sample");
+				float *input = reinterpret_cast<float*>(rows[0].data());
+				float *target = reinterpret_cast<float*>(rows[1].data());
+				input[0] = index;
+				input[1] = -static_cast<float>(index);
+				target[0] = 2 * index;
+				target[1] = 0.0f;
+			}
+	};
+
+	void create_graph(Graph &graph)
+	{
+		auto x = graph.addInput( { 4, 2 });
+		graph.addOutput(x);
+	}
+}
+
+namespace avocado
+{
+	TEST(TestDataLoader, epochs)
+	{
+		IndexDataset dataset(10);
+		for (int workers : { 1, 3 })
+			for (int prefetched : { 1, 2 })
+			{
+				Graph graph;
+				create_graph(graph);
+				DataLoader loader(dataset, graph, workers, prefetched, true, 123);
+				EXPECT_EQ(loader.batchSize(), 4);
+				EXPECT_EQ(loader.numberOfBatches(), 3);
+
+				for (int epoch = 0; epoch < 3; epoch++)
+				{
+					std::set<int> samples;
+					for (int batch = 0; batch < loader.numberOfBatches(); batch++)
+					{
+						const int size = loader.next();
+						EXPECT_EQ(size, (batch == 2) ? 2 : 4);
+						EXPECT_EQ(loader.currentEpoch(), epoch);
+						EXPECT_EQ(loader.currentBatch(), batch);
+						EXPECT_EQ(loader.isLastBatchOfEpoch(), batch == 2);
+						for (int i = 0; i < size; i++)
+						{
+							const int index = static_cast<int>(graph.getInput().get<float>( { i, 0 }));
+							EXPECT_EQ(graph.getInput().get<float>( { i, 1 }), -index);
+							EXPECT_EQ(graph.getTarget().get<float>( { i, 0 }), 2 * index);
+							samples.insert(index);
+						}
+					}
+					EXPECT_EQ(samples.size(), 10u); // every sample is used exactly once per epoch
+				}
+			}
+	}
+	TEST(TestDataLoader, tensor_dataset)
+	{
+		Tensor inputs = toTensor<float>( { { 0, 1 }, { 2, 3 }, { 4, 5 }, { 6, 7 }, { 8, 9 } });
+		Tensor targets = toTensor<float>( { { 0, 0 }, { 1, 1 }, { 2, 2 }, { 3, 3 }, { 4, 4 } });
+		TensorDataset dataset( { inputs, targets });
+		EXPECT_EQ(dataset.size(), 5u);
+
+		Graph graph;
+		create_graph(graph);
+		DataLoader loader(dataset, graph, 2, 2, false);
+		EXPECT_EQ(loader.next(), 4);
+		EXPECT_EQ(graph.getInput().get<float>( { 2, 1 }), 5.0f);
+		EXPECT_EQ(graph.getTarget().get<float>( { 3, 0 }), 3.0f);
+		EXPECT_EQ(loader.next(), 1);
+		EXPECT_EQ(graph.getInput().get<float>( { 0, 0 }), 8.0f);
+	}
+	TEST(TestDataLoader, error_in_dataset)
+	{
+		IndexDataset dataset(8, 5);
+		Graph graph;
+		create_graph(graph);
+		DataLoader loader(dataset, graph, 2, 2, false);
+		EXPECT_EQ(loader.next(), 4);
+		EXPECT_THROW(loader.next(), std::runtime_error);
+		EXPECT_EQ(loader.next(), 4); // the stream continues with the next epoch
+		EXPECT_EQ(loader.currentEpoch(), 1);
+	}
+
+} /* namespace avocado */
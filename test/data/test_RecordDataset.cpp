@@ -0,0 +1,79 @@
+/*
+ * test_RecordDataset.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <Avocado/data/RecordDataset.hpp>
+#include <Avocado/core/Tensor.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+	using namespace avocado;
+
+	std::string create_file(int records)
+	{
+		const std::string path = (std::filesystem::temp_directory_path() / "avocado_test_records.bin").string();
+		RecordWriter writer(path, { RecordField( { 3 }, DataType::FLOAT32), RecordField( { 1 }, DataType::INT32) });
+		for (int i = 0; i < records; i++)
+		{
+			Tensor values = toTensor<float>( { 10.0f * i, 10.0f * i + 1, 10.0f * i + 2 });
+			Tensor label = toTensor<int32_t>( { i });
+			writer.write( { values, label });
+		}
+		EXPECT_EQ(writer.numberOfRecords(), static_cast<uint64_t>(records));
+		return path;
+	}
+}
+
+namespace avocado
+{
+	TEST(TestRecordDataset, random_access)
+	{
+		const std::string path = create_file(10);
+		RecordDataset dataset(path);
+		EXPECT_EQ(dataset.size(), 10u);
+		ASSERT_EQ(dataset.fields().size(), 2u);
+		EXPECT_EQ(dataset.fields()[0].shape, Shape( { 3 }));
+		EXPECT_EQ(dataset.fields()[1].dtype, DataType::INT32);
+
+		for (size_t i : { 7, 0, 9, 3 })
+		{
+			EXPECT_EQ(reinterpret_cast<uintptr_t>(dataset.data(i, 0)) % 64, 0u);
+			EXPECT_EQ(reinterpret_cast<const float*>(dataset.data(i, 0))[2], 10.0f * i + 2);
+			EXPECT_EQ(reinterpret_cast<const int32_t*>(dataset.data(i, 1))[0], static_cast<int32_t>(i));
+		}
+		EXPECT_ANY_THROW(dataset.data(10, 0));
+
+		std::vector<Tensor> rows = { Tensor( { 1, 3 }, DataType::FLOAT32, Device::cpu()), Tensor( { 1, 1 }, DataType::INT32, Device::cpu()) };
+		dataset.load(4, rows);
+		EXPECT_EQ(rows[0].get<float>( { 0, 1 }), 41.0f);
+		EXPECT_EQ(rows[1].get<int32_t>( { 0, 0 }), 4);
+		std::remove(path.c_str());
+	}
+	TEST(TestRecordDataset, sharding)
+	{
+		const std::string path = create_file(10);
+		size_t total = 0;
+		int32_t next_record = 0;
+		for (int shard = 0; shard < 3; shard++)
+		{
+			RecordDataset dataset(path, shard, 3);
+			EXPECT_EQ(dataset.numberOfRecords(), 10u);
+			for (size_t i = 0; i < dataset.size(); i++, next_record++) // shards are contiguous and cover all records
+				EXPECT_EQ(reinterpret_cast<const int32_t*>(dataset.data(i, 1))[0], next_record);
+			total += dataset.size();
+		}
+		EXPECT_EQ(total, 10u);
+		EXPECT_ANY_THROW(RecordDataset(path, 3, 3));
+		std::remove(path.c_str());
+	}
+
+} /* namespace avocado */
@@ -0,0 +1,70 @@
+/*
+ * test_Graph.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <Avocado/graph/Graph.hpp>
+#include <Avocado/layers/Dense.hpp>
+#include <Avocado/layers/Softmax.hpp>
+#include <Avocado/losses/CrossEntropyLoss.hpp>
+#include <Avocado/core/Tensor.hpp>
+#include <Avocado/utils/json.hpp>
+#include <Avocado/utils/serialization.hpp>
+
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+	using namespace avocado;
+
+	void fill(Tensor &tensor, float phase)
+	{
+		for (int i = 0; i < tensor.firstDim(); i++)
+			for (int j = 0; j < tensor.lastDim(); j++)
+				tensor.set<float>(0.5f + 0.4f * std::sin(phase + i + 3 * j), { i, j });
+	}
+	std::vector<float> to_vector(const Tensor &tensor)
+	{
+		std::vector<float> result(tensor.volume());
+		tensor.copyToHost(result.data(), result.size());
+		return result;
+	}
+}
+
+namespace avocado
+{
+	TEST(TestGraph, load_combines_loss_with_output)
+	{
+		Graph original;
+		auto x = original.addInput( { 4, 5 });
+		x = original.add(Dense(3), x);
+		x = original.add(Softmax(), x);
+		original.addOutput(x, CrossEntropyLoss());
+		original.init();
+
+		SerializedObject binary_data;
+		const Json json = original.save(binary_data);
+		Graph loaded;
+		loaded.load(json, binary_data);
+
+		Graph *graphs[2] = { &original, &loaded };
+		for (Graph *graph : graphs)
+		{
+			fill(graph->getInput(), 0.0f);
+			fill(graph->getTarget(), 1.0f);
+			graph->forward(4);
+			graph->backward(4);
+		}
+		// the softmax node must be bypassed in backward in the loaded graph as well, otherwise its gradient is applied twice
+		const std::vector<float> expected = to_vector(original.getLayer(1).getWeights().getUpdate());
+		const std::vector<float> actual = to_vector(loaded.getLayer(1).getWeights().getUpdate());
+		ASSERT_EQ(actual.size(), expected.size());
+		for (size_t i = 0; i < expected.size(); i++)
+			EXPECT_NEAR(actual[i], expected[i], 1.0e-6f);
+	}
+
+} /* namespace avocado */
@@ -0,0 +1,115 @@
+/*
+ * test_Pipeline.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <Avocado/graph/Pipeline.hpp>
+#include <Avocado/graph/Graph.hpp>
+#include <Avocado/layers/Dense.hpp>
+#include <Avocado/losses/MeanSquareLoss.hpp>
+#include <Avocado/core/Tensor.hpp>
+#include <Avocado/core/Scalar.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+namespace
+{
+	using namespace avocado;
+
+	const int batch_size = 16;
+
+	std::vector<float> to_vector(const Tensor &t)
+	{
+		std::vector<float> result(t.volume());
+		t.copyToHost(result.data(), t.volume());
+		return result;
+	}
+
+	void create_model(Graph &model)
+	{
+		auto x = model.addInput( { batch_size, 8 });
+		auto y = model.add(Dense(12), x);
+		y = model.add(Dense(12), y);
+		y = model.add(Dense(10), y);
+		model.addOutput(y, MeanSquareLoss());
+		model.init();
+
+		for (int b = 0; b < batch_size; b++)
+		{
+			for (int i = 0; i < 8; i++)
+				model.getInput().set<float>(0.1f * std::sin(b + 3 * i), { b, i });
+			for (int i = 0; i < 10; i++)
+				model.getTarget().set<float>(0.1f * std::cos(2 * b + i), { b, i });
+		}
+	}
+	std::vector<std::vector<float>> get_and_clear_updates(Graph &model)
+	{
+		std::vector<std::vector<float>> result;
+		for (int i = 1; i < model.numberOfLayers(); i++)
+		{
+			Tensor &update = model.getLayer(i).getWeights().getUpdate();
+			result.push_back(to_vector(update));
+			update.zeroall();
+			model.getLayer(i).getBias().getUpdate().zeroall();
+		}
+		return result;
+	}
+	float max_diff(const std::vector<std::vector<float>> &lhs, const std::vector<std::vector<float>> &rhs)
+	{
+		float result = 0.0f;
+		for (size_t i = 0; i < lhs.size(); i++)
+			for (size_t j = 0; j < lhs[i].size(); j++)
+				result = std::max(result, std::fabs(lhs[i][j] - rhs[i][j]));
+		return result;
+	}
+}
+
+namespace avocado
+{
+	TEST(TestPipeline, balance)
+	{
+		Graph model;
+		create_model(model);
+
+		std::vector<int> stages = Pipeline::balance(model, 3);
+		EXPECT_EQ(stages.size(), 3u);
+		EXPECT_EQ(stages[0], 0);
+		for (size_t i = 1; i < stages.size(); i++)
+			EXPECT_LT(stages[i - 1], stages[i]);
+		EXPECT_THROW(Pipeline::balance(model, model.numberOfNodes() + 1), IllegalArgument);
+	}
+	TEST(TestPipeline, same_as_graph)
+	{
+		for (PipelineSchedule schedule : { PipelineSchedule::GPIPE, PipelineSchedule::ONE_F_ONE_B })
+		{
+			Graph model;
+			create_model(model);
+			get_and_clear_updates(model);
+
+			model.forward(batch_size);
+			model.backward(batch_size);
+			const std::vector<float> expected_output = to_vector(model.getOutput());
+			const std::vector<std::vector<float>> expected_updates = get_and_clear_updates(model);
+			const double expected_loss = model.getAccumulatedLoss().at(0).get<double>();
+			model.getOutput().zeroall();
+			model.resetAccumulatedLoss();
+
+			{
+				Pipeline pipeline(model, 2, 4, schedule);
+				EXPECT_EQ(pipeline.numberOfStages(), 2);
+				pipeline.train(batch_size);
+			}
+			const std::vector<float> output = to_vector(model.getOutput());
+			for (size_t i = 0; i < output.size(); i++)
+				EXPECT_NEAR(output[i], expected_output[i], 1.0e-4f);
+			EXPECT_LT(max_diff(get_and_clear_updates(model), expected_updates), 1.0e-4f);
+			EXPECT_EQ(model.numberOfAccumulatedSteps(), 1);
+			EXPECT_NEAR(model.getAccumulatedLoss().at(0).get<double>(), expected_loss, 1.0e-5 * std::fabs(expected_loss));
+		}
+	}
+
+} /* namespace avocado */
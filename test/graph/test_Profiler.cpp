@@ -0,0 +1,53 @@
+/*
+ * test_Profiler.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <Avocado/graph/Graph.hpp>
+#include <Avocado/graph/Profiler.hpp>
+#include <Avocado/layers/Dense.hpp>
+#include <Avocado/utils/json.hpp>
+
+#include <gtest/gtest.h>
+
+namespace avocado
+{
+	TEST(TestProfiler, disabled_by_default)
+	{
+		Graph model;
+		EXPECT_FALSE(model.isProfiling());
+		EXPECT_THROW(model.getProfiler(), LogicError);
+	}
+	TEST(TestProfiler, forward)
+	{
+		Graph model;
+		auto x = model.addInput( { 8, 16 });
+		auto y = model.add(Dense(32), x);
+		y = model.add(Dense(4), y);
+		model.addOutput(y);
+		model.init();
+
+		model.setProfiling(true);
+		model.forward(8);
+		model.forward(4);
+
+		const Profiler &profiler = model.getProfiler();
+		ASSERT_EQ(profiler.getEvents().size(), 4u); // input node is not recorded
+		const ProfilerEvent &event = profiler.getEvents().at(0);
+		EXPECT_EQ(event.name, "Dense");
+		EXPECT_EQ(event.phase, ProfilerPhase::FORWARD);
+		EXPECT_EQ(event.index, 1);
+		EXPECT_DOUBLE_EQ(event.flops, 2.0 * 8 * 16 * 32);
+		EXPECT_GE(event.duration, 0.0);
+
+		Json trace = profiler.getChromeTrace();
+		EXPECT_EQ(trace["traceEvents"].size(), 4);
+		EXPECT_FALSE(profiler.summary().empty());
+
+		model.setProfiling(false);
+		EXPECT_FALSE(model.isProfiling());
+	}
+
+} /* namespace avocado */
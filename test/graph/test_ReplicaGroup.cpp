@@ -0,0 +1,166 @@
+/*
+ * test_ReplicaGroup.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <Avocado/graph/ReplicaGroup.hpp>
+#include <Avocado/graph/Graph.hpp>
+#include <Avocado/layers/Dense.hpp>
+#include <Avocado/losses/MeanSquareLoss.hpp>
+#include <Avocado/optimizers/ADAM.hpp>
+#include <Avocado/core/MemoryTracker.hpp>
+#include <Avocado/core/Tensor.hpp>
+#include <Avocado/core/Scalar.hpp>
+
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+	using namespace avocado;
+
+	void create_model(Graph &model)
+	{
+		auto x = model.addInput( { 8, 5 });
+		x = model.add(Dense(3), x);
+		model.addOutput(x, MeanSquareLoss());
+		model.init();
+		model.setOptimizer(ADAM(0.01));
+	}
+	void fill(Tensor &tensor, float phase)
+	{
+		for (int i = 0; i < tensor.firstDim(); i++)
+			for (int j = 0; j < tensor.lastDim(); j++)
+				tensor.set<float>(0.1f * std::sin(phase + i + 3 * j), { i, j });
+	}
+	std::vector<float> to_vector(const Tensor &tensor)
+	{
+		std::vector<float> result(tensor.volume());
+		tensor.copyToHost(result.data(), result.size());
+		return result;
+	}
+	std::vector<Parameter*> parameters(Graph &model)
+	{
+		std::vector<Parameter*> result;
+		for (int i = 0; i < model.numberOfLayers(); i++)
+			if (model.getLayer(i).getWeights().shape().volume() > 0)
+			{
+				result.push_back(&(model.getLayer(i).getWeights()));
+				result.push_back(&(model.getLayer(i).getBias()));
+			}
+		return result;
+	}
+
+	/*
+	 * Runs one step of a group of three replicas and the same step of a single graph trained on the averaged gradient.
+	 */
+	void compare_with_single_graph(double maxNorm)
+	{
+		Graph replica0, replica1, replica2, reference;
+		create_model(replica0);
+		create_model(replica1);
+		create_model(replica2);
+		create_model(reference);
+
+		ReplicaGroup group( { &replica0, &replica1, &replica2 });
+		group.setGradientClipping(maxNorm);
+		const std::vector<Parameter*> ref_params = parameters(reference);
+		for (size_t j = 0; j < ref_params.size(); j++)
+			ref_params[j]->mutableParam().copyFrom(parameters(replica0)[j]->getParam());
+		const std::vector<float> initial = to_vector(ref_params[0]->getParam());
+
+		for (int r = 0; r < group.numberOfReplicas(); r++)
+		{
+			fill(group.getReplica(r).getInput(), r);
+			fill(group.getReplica(r).getTarget(), 10 + r);
+			group.getReplica(r).forward(8);
+			group.getReplica(r).backward(8);
+		}
+		for (size_t j = 0; j < ref_params.size(); j++)
+		{
+			std::vector<float> average(ref_params[j]->getUpdate().volume(), 0.0f);
+			for (int r = 0; r < group.numberOfReplicas(); r++)
+			{
+				const std::vector<float> update = to_vector(parameters(group.getReplica(r))[j]->getUpdate());
+				for (size_t k = 0; k < average.size(); k++)
+					average[k] += update[k] / group.numberOfReplicas();
+			}
+			ref_params[j]->getUpdate().copyFromHost(average.data(), average.size());
+		}
+
+		group.learn();
+		if (maxNorm > 0.0)
+		{
+			const double norm = reference.clipGradients(maxNorm);
+			EXPECT_NEAR(group.getLastGradientNorm(), norm, 1.0e-5 * norm);
+			EXPECT_GT(norm, maxNorm); // so that clipping is actually tested
+		}
+		reference.learn();
+
+		EXPECT_NE(to_vector(ref_params[0]->getParam()), initial);
+		for (int r = 0; r < group.numberOfReplicas(); r++)
+		{
+			const std::vector<Parameter*> params = parameters(group.getReplica(r));
+			for (size_t j = 0; j < ref_params.size(); j++)
+			{
+				const std::vector<float> expected = to_vector(ref_params[j]->getParam());
+				const std::vector<float> actual = to_vector(params[j]->getParam());
+				for (size_t k = 0; k < expected.size(); k++)
+					EXPECT_NEAR(actual[k], expected[k], 1.0e-6f);
+			}
+		}
+	}
+}
+
+namespace avocado
+{
+	TEST(TestReplicaGroup, partitioning)
+	{
+		Graph replica0, replica1, replica2;
+		create_model(replica0);
+		create_model(replica1);
+		create_model(replica2);
+
+		ReplicaGroup group( { &replica0, &replica1, &replica2 });
+		EXPECT_EQ(group.shardSize(0) + group.shardSize(1) + group.shardSize(2), 5 * 3 + 3);
+		EXPECT_LE(group.shardSize(0) - group.shardSize(2), 1);
+		EXPECT_EQ(to_vector(parameters(replica2)[0]->getParam()), to_vector(parameters(replica0)[0]->getParam())); // copied from the first replica
+	}
+	TEST(TestReplicaGroup, memory)
+	{
+		Graph replica0, replica1, replica2;
+		create_model(replica0);
+		create_model(replica1);
+		create_model(replica2);
+		Graph *replicas[3] = { &replica0, &replica1, &replica2 };
+		for (int r = 0; r < 3; r++)
+		{
+			fill(replicas[r]->getInput(), r);
+			fill(replicas[r]->getTarget(), 10 + r);
+			replicas[r]->forward(8);
+			replicas[r]->backward(8);
+		}
+		const MemoryUsage before = MemoryTracker::getCurrentUsage(Device::cpu());
+
+		ReplicaGroup group( { &replica0, &replica1, &replica2 });
+		group.learn();
+		const MemoryUsage after = MemoryTracker::getCurrentUsage(Device::cpu());
+		EXPECT_EQ(after[MemoryCategory::PARAMETERS], before[MemoryCategory::PARAMETERS]); // no copies of the weights
+		EXPECT_EQ(after[MemoryCategory::UPDATES], before[MemoryCategory::UPDATES]); // nor of the updates
+		const size_t parameters = 5 * 3 + 3;
+		const size_t workspace = after[MemoryCategory::OPTIMIZER_WORKSPACE] - before[MemoryCategory::OPTIMIZER_WORKSPACE];
+		EXPECT_EQ(workspace, 2 * parameters * sizeof(float)); // moments of ADAM are stored once for all replicas, not in each of them
+	}
+	TEST(TestReplicaGroup, learn)
+	{
+		compare_with_single_graph(0.0);
+	}
+	TEST(TestReplicaGroup, clipping)
+	{
+		compare_with_single_graph(1.0e-3);
+	}
+
+} /* namespace avocado */
@@ -0,0 +1,180 @@
+/*
+ * test_Trainer.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <Avocado/graph/Trainer.hpp>
+#include <Avocado/graph/Graph.hpp>
+#include <Avocado/data/DataLoader.hpp>
+#include <Avocado/data/Dataset.hpp>
+#include <Avocado/layers/Dense.hpp>
+#include <Avocado/losses/MeanSquareLoss.hpp>
+#include <Avocado/optimizers/SGD.hpp>
+#include <Avocado/optimizers/StepDecay.hpp>
+#include <Avocado/metrics/MeanLoss.hpp>
+#include <Avocado/core/Tensor.hpp>
+#include <Avocado/core/Scalar.hpp>
+
+#include <cmath>
+#include <filesystem>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+	using namespace avocado;
+
+	Tensor create_data(int samples, int features, float phase)
+	{
+		Tensor result( { samples, features }, DataType::FLOAT32, Device::cpu());
+		for (int i = 0; i < samples; i++)
+			for (int j = 0; j < features; j++)
+				result.set<float>(0.1f * std::sin(phase + i + 3 * j), { i, j });
+		return result;
+	}
+	void create_model(Graph &model)
+	{
+		auto x = model.addInput( { 8, 4 });
+		x = model.add(Dense(3), x);
+		model.addOutput(x, MeanSquareLoss());
+		model.init();
+		model.setOptimizer(SGD(0.1));
+	}
+
+	std::vector<float> to_vector(const Tensor &tensor)
+	{
+		std::vector<float> result(tensor.volume());
+		tensor.copyToHost(result.data(), result.size());
+		return result;
+	}
+
+	class RecordingCallback: public TrainerCallback
+	{
+		public:
+			int epochs = 0;
+			int64_t steps = 0;
+			std::vector<TrainingLog> logs;
+			std::vector<TrainingLog> evaluations;
+			int64_t stop_at_step = -1;
+
+			void onEpochEnd(Trainer &trainer, int epoch)
+			{
+				epochs++;
+			}
+			void onStepEnd(Trainer &trainer, int64_t step)
+			{
+				steps++;
+				if (step == stop_at_step)
+					trainer.stop();
+			}
+			void onLog(Trainer &trainer, const TrainingLog &log)
+			{
+				logs.push_back(log);
+			}
+			void onEvaluation(Trainer &trainer, const TrainingLog &log)
+			{
+				evaluations.push_back(log);
+			}
+	};
+}
+
+namespace avocado
+{
+	TEST(TestTrainer, fit)
+	{
+		Graph model;
+		create_model(model);
+		TensorDataset train_set( { create_data(20, 4, 0.0f), create_data(20, 3, 1.0f) });
+		TensorDataset validation_set( { create_data(10, 4, 2.0f), create_data(10, 3, 3.0f) });
+		DataLoader train_loader(train_set, model);
+		DataLoader validation_loader(validation_set, model, 1, 2, false);
+
+		RecordingCallback callback;
+		const std::string checkpoint = (std::filesystem::temp_directory_path() / "avocado_test_checkpoint.bin").string();
+		Trainer trainer(model, train_loader);
+		trainer.setValidationData(validation_loader).addMetric(MeanLoss(MeanSquareLoss())).addCallback(callback).setLogInterval(2);
+		trainer.setLearningRateSchedule(StepDecay(2, 0.5));
+		trainer.setCheckpoint(checkpoint, 2);
+		trainer.fit(2);
+
+		EXPECT_EQ(trainer.currentEpoch(), 2);
+		EXPECT_EQ(trainer.currentStep(), 6); // 3 batches per epoch (8 + 8 + 4 samples)
+		EXPECT_EQ(callback.epochs, 2);
+		EXPECT_EQ(callback.steps, 6);
+		ASSERT_EQ(callback.logs.size(), 4u); // after 2 steps and at the end of each epoch
+		EXPECT_EQ(callback.logs[0].steps, 2);
+		EXPECT_EQ(callback.logs[1].steps, 1);
+		EXPECT_EQ(callback.logs[1].step, 3);
+		EXPECT_FLOAT_EQ(callback.logs[1].learningRate, 0.1 * 0.5); // rate of the next step
+		for (size_t i = 0; i < callback.logs.size(); i++)
+		{
+			ASSERT_EQ(callback.logs[i].loss.size(), 1u);
+			EXPECT_TRUE(std::isfinite(callback.logs[i].loss[0]));
+			ASSERT_EQ(callback.logs[i].metrics.size(), 1u);
+		}
+		EXPECT_FLOAT_EQ(model.getLayer(1).getWeights().getOptimizer().getLearningRate(), 0.1); // schedule does not change the optimizers
+		EXPECT_EQ(model.getLearningRateSchedule().getStep(), 6);
+
+		ASSERT_EQ(callback.evaluations.size(), 2u);
+		EXPECT_EQ(callback.evaluations[0].steps, 2);
+		EXPECT_NEAR(callback.evaluations[1].loss[0], callback.evaluations[1].metrics[0].second, 1.0e-6);
+
+		EXPECT_TRUE(std::filesystem::exists(checkpoint));
+		std::filesystem::remove(checkpoint);
+	}
+	TEST(TestTrainer, stop)
+	{
+		Graph model;
+		create_model(model);
+		TensorDataset train_set( { create_data(20, 4, 0.0f), create_data(20, 3, 1.0f) });
+		DataLoader train_loader(train_set, model);
+
+		RecordingCallback callback;
+		callback.stop_at_step = 4;
+		Trainer trainer(model, train_loader);
+		trainer.addCallback(callback);
+		trainer.fit(5);
+		EXPECT_EQ(trainer.currentStep(), 4); // the first step of the second epoch
+		EXPECT_EQ(trainer.currentEpoch(), 1);
+		EXPECT_EQ(callback.epochs, 1); // the interrupted epoch is not finished
+		ASSERT_EQ(callback.logs.size(), 2u); // the steps since the last log are still reported
+		EXPECT_EQ(callback.logs[1].step, 4);
+	}
+	TEST(TestTrainer, resume_from_checkpoint)
+	{
+		TensorDataset train_set( { create_data(20, 4, 0.0f), create_data(20, 3, 1.0f) });
+		const std::string checkpoint = (std::filesystem::temp_directory_path() / "avocado_test_resume.bin").string();
+
+		Graph model;
+		create_model(model);
+		DataLoader train_loader(train_set, model, 1, 2, false);
+		Trainer trainer(model, train_loader);
+		trainer.setLearningRateSchedule(StepDecay(2, 0.5));
+		trainer.fit(1);
+		trainer.saveCheckpoint(checkpoint);
+		trainer.fit(1);
+
+		Graph resumed_model;
+		create_model(resumed_model); // initialized differently, everything must come from the checkpoint
+		DataLoader resumed_loader(train_set, resumed_model, 1, 2, false);
+		Trainer resumed(resumed_model, resumed_loader);
+		resumed.loadCheckpoint(checkpoint);
+		std::filesystem::remove(checkpoint);
+		EXPECT_EQ(resumed.currentEpoch(), 1);
+		EXPECT_EQ(resumed.currentStep(), 3);
+		EXPECT_EQ(resumed_model.getLearningRateSchedule().getStep(), 3);
+		resumed.fit(1);
+
+		EXPECT_EQ(resumed.currentEpoch(), trainer.currentEpoch());
+		EXPECT_EQ(resumed.currentStep(), trainer.currentStep());
+		const std::vector<float> expected = to_vector(model.getLayer(1).getWeights().getParam());
+		const std::vector<float> actual = to_vector(resumed_model.getLayer(1).getWeights().getParam());
+		for (size_t i = 0; i < expected.size(); i++)
+			EXPECT_NEAR(actual[i], expected[i], 1.0e-6f);
+
+		EXPECT_THROW(resumed.loadCheckpoint(checkpoint), std::exception); // the file was removed
+	}
+
+} /* namespace avocado */
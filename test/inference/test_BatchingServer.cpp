@@ -0,0 +1,94 @@
+/*
+ * test_BatchingServer.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <Avocado/inference/BatchingServer.hpp>
+#include <Avocado/graph/Graph.hpp>
+#include <Avocado/layers/Dense.hpp>
+#include <Avocado/core/Tensor.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cmath>
+#include <thread>
+
+namespace
+{
+	using namespace avocado;
+
+	const int inputs = 8;
+	const int neurons = 4;
+
+	void create_model(Graph &model)
+	{
+		auto x = model.addInput( { 16, inputs });
+		auto y = model.add(Dense(neurons), x);
+		model.addOutput(y);
+		model.init();
+		model.makeNonTrainable();
+	}
+	float expected_output(const Graph &model, const Tensor &sample, int neuron)
+	{
+		const Tensor &weights = model.getLayer(1).getWeights().getParam();
+		const Tensor &bias = model.getLayer(1).getBias().getParam();
+		float result = bias.get<float>( { neuron });
+		for (int i = 0; i < inputs; i++)
+			result += weights.get<float>( { neuron, i }) * sample.get<float>( { i });
+		return result;
+	}
+}
+
+namespace avocado
+{
+	TEST(TestBatchingServer, load_generator)
+	{
+		Graph model;
+		create_model(model);
+
+		const int clients = 8;
+		const int requests_per_client = 50;
+		inference::BatchingServer server(model, std::chrono::milliseconds(2), 8);
+
+		std::atomic<int> errors(0);
+		std::vector<std::thread> threads;
+		for (int c = 0; c < clients; c++)
+			threads.push_back(std::thread([&, c]()
+			{
+				for (int r = 0; r < requests_per_client; r++)
+				{
+					Tensor sample( { inputs }, DataType::FLOAT32, Device::cpu());
+					for (int i = 0; i < inputs; i++)
+						sample.set<float>(0.01f * (c + 1) * (r - i), { i });
+
+					std::vector<Tensor> output = server.submit(sample).get();
+					for (int n = 0; n < neurons; n++)
+						if (std::fabs(output.at(0).get<float>( { 0, n }) - expected_output(model, sample, n)) > 1.0e-4f)
+							errors++;
+				}
+			}));
+		for (size_t i = 0; i < threads.size(); i++)
+			threads[i].join();
+
+		inference::ServingStatistics stats = server.getStatistics();
+		EXPECT_EQ(errors.load(), 0);
+		EXPECT_EQ(stats.processedRequests, static_cast<size_t>(clients * requests_per_client));
+		EXPECT_LE(stats.processedBatches, stats.processedRequests);
+		EXPECT_GT(stats.averageBatchFill(), 0.0);
+		EXPECT_LE(stats.averageBatchFill(), 1.0);
+		EXPECT_GT(stats.throughput(), 0.0);
+	}
+	TEST(TestBatchingServer, wrong_input)
+	{
+		Graph model;
+		create_model(model);
+		inference::BatchingServer server(model, std::chrono::milliseconds(1));
+
+		EXPECT_THROW(server.submit(Tensor( { inputs + 1 }, DataType::FLOAT32, Device::cpu())), ShapeMismatch);
+		EXPECT_THROW(server.submit(Tensor( { inputs }, DataType::FLOAT64, Device::cpu())), DataTypeMismatch);
+	}
+
+} /* namespace avocado */
@@ -0,0 +1,130 @@
+/*
+ * test_InferenceSession.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <Avocado/inference/InferenceSession.hpp>
+#include <Avocado/graph/Graph.hpp>
+#include <Avocado/graph/GraphNode.hpp>
+#include <Avocado/layers/Add.hpp>
+#include <Avocado/layers/Dense.hpp>
+#include <Avocado/core/MemoryTracker.hpp>
+#include <Avocado/core/Tensor.hpp>
+#include <Avocado/core/error_handling.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+	using namespace avocado;
+
+	/* input -> a -> (b, c) -> d = b + c -> e -> output, so that 'd' can reuse memory of 'a' */
+	void create_model(Graph &model)
+	{
+		auto x = model.addInput( { 4, 8 });
+		auto a = model.add(Dense(32), x);
+		auto b = model.add(Dense(32), a);
+		auto c = model.add(Dense(32), a);
+		auto d = model.add(Add(), { b, c });
+		auto e = model.add(Dense(32), d);
+		model.addOutput(model.add(Dense(3), e));
+		model.init();
+		model.makeNonTrainable();
+	}
+	void fill(Tensor &tensor)
+	{
+		for (int i = 0; i < tensor.firstDim(); i++)
+			for (int j = 0; j < tensor.lastDim(); j++)
+				tensor.set<float>(0.1f * std::sin(i + 3 * j), { i, j });
+	}
+	/* index of the last node that needs output of each node */
+	std::vector<int> get_last_use(const Graph &model)
+	{
+		std::vector<int> result(model.numberOfNodes());
+		for (int i = 0; i < model.numberOfNodes(); i++)
+		{
+			result[i] = std::max(result[i], i);
+			for (int j = 0; j < model.getNode(i).numberOfInputs(); j++)
+			{
+				const int input = model.getNodeID(model.getNode(i).getInputNode(j));
+				result[input] = std::max(result[input], i);
+			}
+		}
+		for (int i = 0; i < model.numberOfInputs(); i++)
+			result[model.getInputNodeID(i)] = std::numeric_limits<int>::max();
+		for (int i = 0; i < model.numberOfOutputs(); i++)
+			result[model.getOutputNodeID(i)] = std::numeric_limits<int>::max();
+		return result;
+	}
+	bool overlap(const Tensor &lhs, const Tensor &rhs)
+	{
+		const char *lhs_begin = reinterpret_cast<const char*>(lhs.data());
+		const char *rhs_begin = reinterpret_cast<const char*>(rhs.data());
+		return lhs_begin < rhs_begin + rhs.sizeInBytes() and rhs_begin < lhs_begin + lhs.sizeInBytes();
+	}
+}
+
+namespace avocado
+{
+	TEST(TestInferenceSession, arena_planning)
+	{
+		Graph model;
+		create_model(model);
+		inference::InferenceSession session(model);
+
+		const std::vector<int> last_use = get_last_use(model);
+		size_t total_size = 0;
+		for (int i = 0; i < model.numberOfNodes(); i++)
+		{
+			total_size += session.getActivation(i).sizeInBytes();
+			for (int j = i + 1; j < model.numberOfNodes(); j++)
+				if (j <= last_use[i]) // both are live when node 'j' is computed
+				{
+					EXPECT_FALSE(overlap(session.getActivation(i), session.getActivation(j))) << "nodes " << i << " and " << j;
+				}
+		}
+		EXPECT_EQ(session.getActivation(4).data(), session.getActivation(1).data()); // 'd' takes the first free block, released by 'a'
+		EXPECT_LT(session.sizeInBytes(), total_size);
+		EXPECT_THROW(session.getActivation(model.numberOfNodes()), IndexOutOfBounds);
+
+		fill(model.getInput());
+		fill(session.getInput());
+		model.forward(4);
+		session.forward(4);
+		for (int i = 0; i < 4; i++)
+			for (int j = 0; j < 3; j++)
+				EXPECT_NEAR(session.getOutput().get<float>( { i, j }), model.getOutput().get<float>( { i, j }), 1.0e-5f);
+	}
+	TEST(TestInferenceSession, shared_weights)
+	{
+		Graph model;
+		create_model(model);
+		const size_t parameters = MemoryTracker::getCurrentUsage(Device::cpu())[MemoryCategory::PARAMETERS];
+
+		inference::InferenceSession session1(model);
+		inference::InferenceSession session2(model);
+		fill(session1.getInput());
+		fill(session2.getInput());
+		session1.forward(4);
+		session2.forward(2);
+
+		EXPECT_EQ(MemoryTracker::getCurrentUsage(Device::cpu())[MemoryCategory::PARAMETERS], parameters); // no copy was made
+		for (int i = 0; i < model.numberOfLayers(); i++)
+			if (model.getLayer(i).getWeights().shape().volume() > 0)
+			{
+				EXPECT_TRUE(model.getLayer(i).getWeights().isShared());
+				EXPECT_TRUE(model.getLayer(i).getBias().isShared());
+			}
+		EXPECT_FALSE(overlap(session1.getOutput(), session2.getOutput()));
+		for (int i = 0; i < 2; i++)
+			for (int j = 0; j < 3; j++)
+				EXPECT_EQ(session1.getOutput().get<float>( { i, j }), session2.getOutput().get<float>( { i, j }));
+	}
+
+} /* namespace avocado */
@@ -0,0 +1,175 @@
+/*
+ * test_Parameter.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <Avocado/layers/Parameter.hpp>
+#include <Avocado/core/Context.hpp>
+#include <Avocado/core/Scalar.hpp>
+#include <Avocado/optimizers/SGD.hpp>
+#include <Avocado/optimizers/ADAM.hpp>
+#include <Avocado/optimizers/LAMB.hpp>
+#include <Avocado/regularizers/RegularizerL2.hpp>
+#include <Avocado/regularizers/WeightDecay.hpp>
+#include <Avocado/utils/json.hpp>
+#include <Avocado/utils/serialization.hpp>
+
+#include <filesystem>
+
+#include <gtest/gtest.h>
+
+namespace avocado
+{
+	TEST(TestParameter, shared_storage)
+	{
+		Parameter p1( { 4, 4 }, DataType::FLOAT32, Device::cpu());
+		p1.mutableParam().setall(1.0f);
+
+		Parameter p2( { }, DataType::FLOAT32, Device::cpu());
+		p2.shareStorageWith(p1);
+		EXPECT_TRUE(p1.isShared());
+		EXPECT_TRUE(p2.isShared());
+		EXPECT_EQ(&(p1.getParam()), &(p2.getParam()));
+		EXPECT_EQ(p2.shape(), Shape( { 4, 4 }));
+
+		Parameter p3(p1);
+		EXPECT_EQ(&(p1.getParam()), &(p3.getParam()));
+	}
+	TEST(TestParameter, copy_on_write)
+	{
+		Parameter p1( { 4, 4 }, DataType::FLOAT32, Device::cpu());
+		p1.mutableParam().setall(1.0f);
+		Parameter p2(p1);
+
+		p2.init(Context()); // writing into shared parameter makes a private copy
+		EXPECT_FALSE(p1.isShared());
+		EXPECT_FALSE(p2.isShared());
+		EXPECT_NE(&(p1.getParam()), &(p2.getParam()));
+		EXPECT_EQ(p1.getParam().get<float>( { 0, 0 }), 1.0f);
+	}
+	TEST(TestParameter, mutable_access_detaches)
+	{
+		Parameter p1( { 4, 4 }, DataType::FLOAT32, Device::cpu());
+		p1.mutableParam().setall(1.0f);
+		Parameter p2(p1);
+
+		EXPECT_EQ(p2.getParam().get<float>( { 0, 0 }), 1.0f); // reading does not copy
+		EXPECT_TRUE(p2.isShared());
+		p2.mutableParam().setall(2.0f);
+		EXPECT_FALSE(p1.isShared());
+		EXPECT_EQ(p1.getParam().get<float>( { 0, 0 }), 1.0f);
+		EXPECT_EQ(p2.getParam().get<float>( { 0, 0 }), 2.0f);
+	}
+	TEST(TestParameter, unserialize_shared)
+	{
+		Parameter saved( { 4 }, DataType::FLOAT32, Device::cpu());
+		saved.mutableParam().setall(3.0f);
+		SerializedObject binary_data;
+		const Json json = saved.serialize(binary_data);
+
+		Parameter p1( { 4 }, DataType::FLOAT32, Device::cpu());
+		p1.mutableParam().setall(1.0f);
+		Parameter p2(p1);
+		p2.unserialize(json, binary_data);
+		EXPECT_FALSE(p1.isShared());
+		EXPECT_EQ(p1.getParam().get<float>( { 0 }), 1.0f);
+		EXPECT_EQ(p2.getParam().get<float>( { 0 }), 3.0f);
+	}
+	TEST(TestParameter, decoupled_weight_decay)
+	{
+		Parameter p( { 4 }, DataType::FLOAT32, Device::cpu());
+		EXPECT_EQ(p.getWeightDecay(), 0.0);
+		p.setRegularizer(RegularizerL2(0.5));
+		EXPECT_EQ(p.getWeightDecay(), 0.0);
+
+		p.setRegularizer(WeightDecay(0.5));
+		p.setOptimizer(SGD(0.1));
+		EXPECT_EQ(p.getWeightDecay(), 0.5);
+		p.mutableParam().setall(1.0f);
+		p.getUpdate().zeroall();
+		p.learn(Context(), 1.0);
+		EXPECT_FLOAT_EQ(p.getParam().get<float>( { 0 }), 0.95f); // scaled by 1 - learning rate * decay
+	}
+	TEST(TestParameter, layerwise_optimizer_steps)
+	{
+		Parameter p( { 4 }, DataType::FLOAT32, Device::cpu());
+		p.setOptimizer(LAMB(0.01));
+		p.mutableParam().setall(1.0f);
+		for (int i = 0; i < 2; i++)
+		{
+			p.getUpdate().setall(0.1f);
+			p.learn(Context(), 1.0);
+		}
+		EXPECT_EQ(p.getOptimizer().getSteps(), 2);
+
+		SerializedObject binary_data;
+		const Json json = p.serialize(binary_data);
+		Parameter loaded(json, binary_data);
+		EXPECT_EQ(loaded.getOptimizer().getSteps(), 2);
+		EXPECT_EQ(std::unique_ptr<Optimizer>(p.getOptimizer().clone())->getSteps(), 2);
+	}
+	TEST(TestParameter, averaging)
+	{
+		Parameter p( { 4 }, DataType::FLOAT32, Device::cpu());
+		p.setOptimizer(SGD(0.1));
+		p.mutableParam().setall(1.0f);
+		p.setAveraging(0.75);
+		EXPECT_TRUE(p.hasAverage());
+		EXPECT_EQ(p.getAverage().get<float>( { 0 }), 1.0f);
+
+		p.getUpdate().setall(1.0f);
+		p.learn(Context(), 1.0);
+		EXPECT_FLOAT_EQ(p.getParam().get<float>( { 0 }), 0.9f);
+		EXPECT_FLOAT_EQ(p.getAverage().get<float>( { 0 }), 0.75f * 1.0f + 0.25f * 0.9f);
+
+		const Tensor *trained = &(p.getParam());
+		p.swapAverage();
+		EXPECT_TRUE(p.isAverageSwapped());
+		EXPECT_EQ(&(p.getAverage()), trained); // no copy was made
+		EXPECT_FLOAT_EQ(p.getParam().get<float>( { 0 }), 0.975f);
+		EXPECT_THROW(p.learn(Context(), 1.0), LogicError);
+		p.swapAverage();
+		EXPECT_EQ(&(p.getParam()), trained);
+	}
+	TEST(TestParameter, offloaded_workspace)
+	{
+		Parameter p1( { 5, 7 }, DataType::FLOAT32, Device::cpu());
+		Parameter p2( { 5, 7 }, DataType::FLOAT32, Device::cpu());
+		p1.setOptimizer(ADAM(0.01));
+		p2.setOptimizer(ADAM(0.01).offloadWorkspace(std::filesystem::temp_directory_path().string(), 8)); // not a divisor of the volume
+		p1.mutableParam().setall(1.0f);
+		p2.mutableParam().setall(1.0f);
+
+		for (int step = 0; step < 3; step++)
+		{
+			for (int i = 0; i < 5; i++)
+				for (int j = 0; j < 7; j++)
+				{
+					p1.getUpdate().set<float>(0.1f * (i - j + step), { i, j });
+					p2.getUpdate().set<float>(0.1f * (i - j + step), { i, j });
+				}
+			p1.learn(Context(), 1.0);
+			p2.learn(Context(), 1.0);
+		}
+		EXPECT_EQ(p1.getOptimizer().getSteps(), p2.getOptimizer().getSteps());
+		for (int i = 0; i < 5; i++)
+			for (int j = 0; j < 7; j++)
+				EXPECT_NEAR(p1.getParam().get<float>( { i, j }), p2.getParam().get<float>( { i, j }), 1.0e-6f);
+
+		SerializedObject binary_data;
+		const Json json = p2.serialize(binary_data);
+		EXPECT_FALSE(json["optimizer"].hasKey("offload directory")); // it may not exist on the machine where the state is loaded
+		Parameter p3(json, binary_data);
+		EXPECT_FALSE(dynamic_cast<ADAM&>(p3.getOptimizer()).isWorkspaceOffloaded());
+		p1.getUpdate().setall(0.1f);
+		p3.getUpdate().setall(0.1f);
+		p1.learn(Context(), 1.0);
+		p3.learn(Context(), 1.0); // with the state loaded into memory
+		for (int i = 0; i < 5; i++)
+			for (int j = 0; j < 7; j++)
+				EXPECT_NEAR(p1.getParam().get<float>( { i, j }), p3.getParam().get<float>( { i, j }), 1.0e-6f);
+	}
+
+} /* namespace avocado */
@@ -0,0 +1,152 @@
+/*
+ * test_fast_math.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <Avocado/math/fast_math.hpp>
+#include <Avocado/core/Context.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+	typedef void (*Function)(avocado::FastMathMode, const float*, float*, size_t);
+
+	std::vector<float> linspace(float start, float stop, size_t elements)
+	{
+		std::vector<float> result(elements);
+		for (size_t i = 0; i < elements; i++)
+			result[i] = start + (stop - start) * i / (elements - 1);
+		return result;
+	}
+	int64_t ulp_distance(float a, float b)
+	{
+		int32_t ia, ib;
+		std::memcpy(&ia, &a, sizeof(float));
+		std::memcpy(&ib, &b, sizeof(float));
+		if (ia < 0)
+			ia = std::numeric_limits<int32_t>::min() - ia;
+		if (ib < 0)
+			ib = std::numeric_limits<int32_t>::min() - ib;
+		return std::abs(static_cast<int64_t>(ia) - static_cast<int64_t>(ib));
+	}
+	/*
+	 * Returns the largest error in ulps (for FAST mode) or the largest relative error (for FASTEST mode).
+	 */
+	double max_error(avocado::FastMathMode mode, Function function, double (*reference)(double), const std::vector<float> &src)
+	{
+		std::vector<float> dst(src.size());
+		function(mode, src.data(), dst.data(), src.size());
+		double result = 0.0;
+		for (size_t i = 0; i < src.size(); i++)
+		{
+			const float correct = static_cast<float>(reference(src[i]));
+			if (mode == avocado::FastMathMode::FAST)
+				result = std::max(result, static_cast<double>(ulp_distance(dst[i], correct)));
+			else
+			{
+				if (std::fabs(correct) > std::numeric_limits<float>::min())
+					result = std::max(result, std::fabs(static_cast<double>(dst[i]) - correct) / std::fabs(correct));
+			}
+		}
+		return result;
+	}
+	double sigmoid(double x)
+	{
+		return 1.0 / (1.0 + std::exp(-x));
+	}
+	double exp_(double x)
+	{
+		return std::exp(x);
+	}
+	double log_(double x)
+	{
+		return std::log(x);
+	}
+	double tanh_(double x)
+	{
+		return std::tanh(x);
+	}
+}
+
+namespace avocado
+{
+	TEST(TestFastMath, mode_to_string)
+	{
+		EXPECT_EQ(fastMathModeFromString(toString(FastMathMode::EXACT)), FastMathMode::EXACT);
+		EXPECT_EQ(fastMathModeFromString(toString(FastMathMode::FAST)), FastMathMode::FAST);
+		EXPECT_EQ(fastMathModeFromString(toString(FastMathMode::FASTEST)), FastMathMode::FASTEST);
+		EXPECT_ANY_THROW(fastMathModeFromString("approximate"));
+
+		Context context;
+		EXPECT_EQ(context.fastMathMode(), FastMathMode::EXACT);
+		context.setFastMathMode(FastMathMode::FASTEST);
+		EXPECT_EQ(context.fastMathMode(), FastMathMode::FASTEST);
+	}
+
+	TEST(TestFastMath, exp)
+	{
+		const std::vector<float> src = linspace(-87.0f, 88.0f, 100003);
+		EXPECT_LE(max_error(FastMathMode::FAST, math::fastExp, exp_, src), 2.0);
+		EXPECT_LE(max_error(FastMathMode::FASTEST, math::fastExp, exp_, src), 1.0e-4);
+	}
+	TEST(TestFastMath, log)
+	{
+		const std::vector<float> src = linspace(1.0e-30f, 1.0e5f, 100003);
+		EXPECT_LE(max_error(FastMathMode::FAST, math::fastLog, log_, src), 2.0);
+		EXPECT_LE(max_error(FastMathMode::FASTEST, math::fastLog, log_, src), 1.0e-4);
+	}
+	TEST(TestFastMath, tanh)
+	{
+		const std::vector<float> src = linspace(-12.0f, 12.0f, 100003);
+		EXPECT_LE(max_error(FastMathMode::FAST, math::fastTanh, tanh_, src), 2.0);
+		EXPECT_LE(max_error(FastMathMode::FASTEST, math::fastTanh, tanh_, src), 1.0e-4);
+	}
+	TEST(TestFastMath, sigmoid)
+	{
+		const std::vector<float> src = linspace(-80.0f, 80.0f, 100003);
+		EXPECT_LE(max_error(FastMathMode::FAST, math::fastSigmoid, sigmoid, src), 2.0);
+		EXPECT_LE(max_error(FastMathMode::FASTEST, math::fastSigmoid, sigmoid, src), 1.0e-4);
+	}
+	TEST(TestFastMath, special_values)
+	{
+		const float inf = std::numeric_limits<float>::infinity();
+		const std::vector<float> src = { -inf, -100.0f, 0.0f, 100.0f, inf };
+		std::vector<float> dst(src.size());
+		for (FastMathMode mode : { FastMathMode::FAST, FastMathMode::FASTEST })
+		{
+			math::fastExp(mode, src.data(), dst.data(), src.size());
+			EXPECT_EQ(dst[0], 0.0f);
+			EXPECT_EQ(dst[1], 0.0f);
+			EXPECT_EQ(dst[2], 1.0f);
+			EXPECT_EQ(dst[3], inf);
+			EXPECT_EQ(dst[4], inf);
+
+			math::fastLog(mode, src.data(), dst.data(), src.size());
+			EXPECT_TRUE(std::isnan(dst[0]));
+			EXPECT_TRUE(std::isnan(dst[1]));
+			EXPECT_EQ(dst[2], -inf);
+			EXPECT_EQ(dst[4], inf);
+
+			math::fastTanh(mode, src.data(), dst.data(), src.size());
+			EXPECT_EQ(dst[0], -1.0f);
+			EXPECT_EQ(dst[2], 0.0f);
+			EXPECT_EQ(dst[4], 1.0f);
+
+			math::fastSigmoid(mode, src.data(), dst.data(), src.size());
+			EXPECT_EQ(dst[0], 0.0f);
+			EXPECT_EQ(dst[2], 0.5f);
+			EXPECT_EQ(dst[4], 1.0f);
+		}
+	}
+
+} /* namespace avocado */
@@ -0,0 +1,80 @@
+/*
+ * test_instrumentation.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <Avocado/math/instrumentation.hpp>
+#include <Avocado/math/tensor_operations.hpp>
+#include <Avocado/core/Context.hpp>
+#include <Avocado/core/Tensor.hpp>
+#include <Avocado/core/Scalar.hpp>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+	using namespace avocado;
+
+	class CountingHook: public math::InstrumentationHook
+	{
+		public:
+			std::vector<math::OperationInfo> calls;
+			void onOperation(const math::OperationInfo &info, double elapsedTime)
+			{
+				calls.push_back(info);
+			}
+	};
+}
+
+namespace avocado
+{
+	TEST(TestInstrumentation, hook)
+	{
+		Context context;
+		Tensor dst( { 4, 5 }, DataType::FLOAT32, Device::cpu());
+		Tensor src( { 4, 5 }, DataType::FLOAT32, Device::cpu());
+
+		CountingHook hook;
+		math::addTensors(context, dst, src, 1, 0);
+		EXPECT_TRUE(hook.calls.empty());
+
+		math::setInstrumentationHook(&hook);
+		math::addTensors(context, dst, src, 1, 0);
+		math::setInstrumentationHook(nullptr);
+		math::addTensors(context, dst, src, 1, 0);
+
+		ASSERT_EQ(hook.calls.size(), 1u);
+		EXPECT_EQ(std::string(hook.calls[0].name), "addTensors");
+		ASSERT_EQ(hook.calls[0].shapes.size(), 2u);
+		EXPECT_EQ(hook.calls[0].shapes[0], Shape( { 4, 5 }));
+		EXPECT_EQ(hook.calls[0].dtypes[1], DataType::FLOAT32);
+		EXPECT_EQ(hook.calls[0].device, Device::cpu());
+	}
+	TEST(TestInstrumentation, slowest_calls)
+	{
+		math::SlowestCalls slowest(2);
+		math::OperationInfo info("op", Device::cpu());
+		slowest.onOperation(info, 1.0);
+		slowest.onOperation(info, 3.0);
+		slowest.onOperation(info, 2.0);
+		slowest.onOperation(info, 0.5);
+
+		std::vector<std::pair<double, math::OperationInfo>> calls = slowest.getCalls();
+		ASSERT_EQ(calls.size(), 2u);
+		EXPECT_EQ(calls[0].first, 3.0);
+		EXPECT_EQ(calls[1].first, 2.0);
+	}
+	TEST(TestInstrumentation, latency_histogram)
+	{
+		math::LatencyHistogram histogram;
+		math::OperationInfo info("op", Device::cpu());
+		histogram.onOperation(info, 1.0e-6);
+		histogram.onOperation(info, 5.0e-6);
+		EXPECT_NE(histogram.toString().find("calls = 2"), std::string::npos);
+		histogram.clear();
+		EXPECT_TRUE(histogram.toString().empty());
+	}
+
+} /* namespace avocado */
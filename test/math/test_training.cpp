@@ -0,0 +1,310 @@
+/*
+ * test_training.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <Avocado/math/training.hpp>
+#include <Avocado/losses/CrossEntropyLoss.hpp>
+#include <Avocado/core/Context.hpp>
+#include <Avocado/core/Tensor.hpp>
+#include <Avocado/core/Scalar.hpp>
+#include <Avocado/core/error_handling.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+	using namespace avocado;
+
+	void fill_logits(Tensor &input, float scale)
+	{
+		float *x = reinterpret_cast<float*>(input.data());
+		for (int i = 0; i < input.volume(); i++)
+			x[i] = scale * std::sin(0.37f * i + 0.1f);
+	}
+	void fill_one_hot(Tensor &target)
+	{
+		float *t = reinterpret_cast<float*>(target.data());
+		for (int i = 0; i < target.firstDim(); i++)
+			for (int j = 0; j < target.lastDim(); j++)
+				t[i * target.lastDim() + j] = (j == (3 * i) % target.lastDim()) ? 1.0f : 0.0f;
+	}
+	void fill_class_index(Tensor &target, int classes)
+	{
+		int32_t *t = reinterpret_cast<int32_t*>(target.data());
+		for (int i = 0; i < target.firstDim(); i++)
+			t[i] = (3 * i) % classes;
+	}
+	/*
+	 * Reference computed with separate passes in double precision, with the same loss definition as the backend cross-entropy.
+	 */
+	double reference(const Tensor &input, const Tensor &target, Tensor &output, Tensor &gradient, double alpha)
+	{
+		const float *x = reinterpret_cast<const float*>(input.data());
+		const float *t = reinterpret_cast<const float*>(target.data());
+		float *y = reinterpret_cast<float*>(output.data());
+		float *dx = reinterpret_cast<float*>(gradient.data());
+		const int columns = input.lastDim();
+		double loss = 0.0;
+		for (int i = 0; i < input.firstDim(); i++)
+		{
+			double max_value = x[i * columns];
+			for (int j = 0; j < columns; j++)
+				max_value = std::max(max_value, static_cast<double>(x[i * columns + j]));
+			double sum = 0.0;
+			for (int j = 0; j < columns; j++)
+				sum += std::exp(x[i * columns + j] - max_value);
+			for (int j = 0; j < columns; j++)
+			{
+				const int k = i * columns + j;
+				const double log_y = x[k] - max_value - std::log(sum);
+				y[k] = std::exp(log_y);
+				dx[k] = alpha * (y[k] - t[k]);
+				loss -= t[k] * log_y + (1.0 - t[k]) * std::log(std::max(1.0e-7, 1.0 - std::exp(log_y)));
+			}
+		}
+		return loss;
+	}
+	double max_abs_diff(const Tensor &lhs, const Tensor &rhs)
+	{
+		double result = 0.0;
+		for (int i = 0; i < lhs.volume(); i++)
+			result = std::max(result,
+					std::fabs(static_cast<double>(reinterpret_cast<const float*>(lhs.data())[i]) - reinterpret_cast<const float*>(rhs.data())[i]));
+		return result;
+	}
+}
+
+namespace avocado
+{
+	TEST(TestTraining, lars)
+	{
+		Context context;
+		OptimizerConfig config;
+		config.setType(OptimizerType::LARS);
+		config.setLearningRate(0.1);
+		config.setCoefficients( { 0.0, 0.01, 0.001, 0.0 });
+		Tensor weight( { 64 }, DataType::FLOAT32, Device::cpu());
+		Tensor update( { 64 }, DataType::FLOAT32, Device::cpu());
+		Tensor workspace(Shape(), DataType::FLOAT32, Device::cpu());
+		fill_logits(weight, 1.0f);
+		fill_logits(update, 0.01f);
+		Tensor expected(weight);
+
+		double w_norm = 0.0, g_norm = 0.0;
+		for (int i = 0; i < weight.volume(); i++)
+		{
+			w_norm += std::pow(weight.get<float>( { i }), 2);
+			g_norm += std::pow(update.get<float>( { i }), 2);
+		}
+		const double trust = 0.01 * std::sqrt(w_norm) / (std::sqrt(g_norm) + 0.001 * std::sqrt(w_norm));
+		for (int i = 0; i < weight.volume(); i++)
+		{
+			const double w = weight.get<float>( { i });
+			expected.set<float>(w - 0.5 * 0.1 * trust * (update.get<float>( { i }) + 0.001 * w), { i });
+		}
+
+		math::layerwiseAdaptiveLearn(context, config, 0, 0.5, 1, weight, update, workspace);
+		for (int i = 0; i < weight.volume(); i++)
+			EXPECT_NEAR(weight.get<float>( { i }), expected.get<float>( { i }), 1.0e-6f);
+		EXPECT_THROW(math::optimizerLearn(context, config, 0.5, 1, weight, update, workspace), LogicError);
+	}
+	TEST(TestTraining, lars_zero_weights)
+	{
+		Context context;
+		OptimizerConfig config;
+		config.setType(OptimizerType::LARS);
+		config.setLearningRate(0.1);
+		config.setCoefficients( { 0.0, 0.001, 0.0, 0.0 });
+		Tensor weight( { 64 }, DataType::FLOAT32, Device::cpu());
+		Tensor update( { 64 }, DataType::FLOAT32, Device::cpu());
+		Tensor workspace(Shape(), DataType::FLOAT32, Device::cpu());
+		weight.zeroall();
+		fill_logits(update, 0.01f);
+
+		math::layerwiseAdaptiveLearn(context, config, 0, 1, 1, weight, update, workspace);
+		for (int i = 0; i < weight.volume(); i++) // trust ratio is 1, not the trust coefficient
+			EXPECT_NEAR(weight.get<float>( { i }), -0.1f * update.get<float>( { i }), 1.0e-7f);
+	}
+	TEST(TestTraining, lamb)
+	{
+		Context context;
+		OptimizerConfig config;
+		config.setType(OptimizerType::LAMB);
+		config.setLearningRate(0.1);
+		config.setCoefficients( { 0.9, 0.999, 0.0, 1.0e-9 });
+		Tensor weight( { 64 }, DataType::FLOAT32, Device::cpu());
+		Tensor update( { 64 }, DataType::FLOAT32, Device::cpu());
+		Tensor workspace( { 128 }, DataType::FLOAT32, Device::cpu());
+		fill_logits(weight, 1.0f);
+		fill_logits(update, 0.01f);
+		workspace.zeroall();
+		Tensor expected(weight);
+
+		// after bias correction the first adam step is (almost) sign of the gradient, so the trust ratio is ||w|| / sqrt(n)
+		double w_norm = 0.0;
+		for (int i = 0; i < weight.volume(); i++)
+			w_norm += std::pow(weight.get<float>( { i }), 2);
+		const double trust = std::sqrt(w_norm / weight.volume());
+		for (int i = 0; i < weight.volume(); i++)
+		{
+			const double sign = (update.get<float>( { i }) > 0.0f) ? 1.0 : -1.0;
+			expected.set<float>(weight.get<float>( { i }) - 0.1 * trust * sign, { i });
+		}
+
+		math::layerwiseAdaptiveLearn(context, config, 0, 1, 1, weight, update, workspace);
+		for (int i = 0; i < weight.volume(); i++)
+			EXPECT_NEAR(weight.get<float>( { i }), expected.get<float>( { i }), 1.0e-5f);
+	}
+	TEST(TestTraining, global_norm)
+	{
+		Context context;
+		Tensor t1( { 3000 }, DataType::FLOAT32, Device::cpu()); // more than one block
+		Tensor t2( { 7, 5 }, DataType::FLOAT32, Device::cpu());
+		fill_logits(t1, 1.0f);
+		fill_logits(t2, 2.0f);
+
+		double expected = 0.0;
+		for (int i = 0; i < t1.volume(); i++)
+			expected += std::pow(t1.get<float>( { i }), 2);
+		for (int i = 0; i < t2.firstDim(); i++)
+			for (int j = 0; j < t2.lastDim(); j++)
+				expected += std::pow(t2.get<float>( { i, j }), 2);
+		EXPECT_NEAR(math::globalNorm2(context, { &t1, &t2 }), std::sqrt(expected), 1.0e-4);
+		EXPECT_EQ(math::globalNorm2(context, { }), 0.0);
+	}
+	TEST(TestTraining, softmax_cross_entropy)
+	{
+		Context context;
+		const Shape shape( { 7, 19 });
+		Tensor input(shape, DataType::FLOAT32, Device::cpu());
+		Tensor target(shape, DataType::FLOAT32, Device::cpu());
+		Tensor output(shape, DataType::FLOAT32, Device::cpu());
+		Tensor gradient(shape, DataType::FLOAT32, Device::cpu());
+		Tensor correct_output(shape, DataType::FLOAT32, Device::cpu());
+		Tensor correct_gradient(shape, DataType::FLOAT32, Device::cpu());
+		fill_logits(input, 5.0f);
+		fill_one_hot(target);
+
+		const double alpha = 1.0 / shape[0];
+		const double correct_loss = reference(input, target, correct_output, correct_gradient, alpha);
+		const double loss = math::softmaxCrossEntropy(context, SoftmaxMode::PER_CHANNEL, alpha, 0, input, output, gradient, target).get<double>();
+
+		EXPECT_NEAR(loss, correct_loss, 1.0e-4 * std::fabs(correct_loss));
+		EXPECT_LT(max_abs_diff(output, correct_output), 1.0e-6);
+		EXPECT_LT(max_abs_diff(gradient, correct_gradient), 1.0e-6);
+	}
+	TEST(TestTraining, softmax_cross_entropy_accumulate)
+	{
+		Context context;
+		const Shape shape( { 7, 19 });
+		Tensor input(shape, DataType::FLOAT32, Device::cpu());
+		Tensor target(shape, DataType::FLOAT32, Device::cpu());
+		Tensor output(shape, DataType::FLOAT32, Device::cpu());
+		Tensor gradient(shape, DataType::FLOAT32, Device::cpu());
+		Tensor correct_output(shape, DataType::FLOAT32, Device::cpu());
+		Tensor correct_gradient(shape, DataType::FLOAT32, Device::cpu());
+		Tensor accumulator( { 1 }, DataType::FLOAT32, Device::cpu());
+		fill_logits(input, 5.0f);
+		fill_one_hot(target);
+		accumulator.setall(1.0f);
+
+		const double alpha = 1.0 / shape[0];
+		const double correct_loss = reference(input, target, correct_output, correct_gradient, alpha);
+		math::softmaxCrossEntropy(context, SoftmaxMode::PER_CHANNEL, alpha, 0, input, output, gradient, target, 0.1, accumulator);
+
+		EXPECT_NEAR(accumulator.get<float>( { 0 }), 1.0 + 0.1 * correct_loss, 1.0e-4 * (1.0 + correct_loss));
+		EXPECT_LT(max_abs_diff(output, correct_output), 1.0e-6);
+		EXPECT_LT(max_abs_diff(gradient, correct_gradient), 1.0e-6);
+	}
+	TEST(TestTraining, softmax_cross_entropy_saturated)
+	{
+		Context context;
+		const Shape shape( { 4, 10 });
+		Tensor input(shape, DataType::FLOAT32, Device::cpu());
+		Tensor target(shape, DataType::FLOAT32, Device::cpu());
+		Tensor output(shape, DataType::FLOAT32, Device::cpu());
+		Tensor gradient(shape, DataType::FLOAT32, Device::cpu());
+		fill_logits(input, 1000.0f); // softmax of the correct class underflows to zero
+		fill_one_hot(target);
+
+		const double loss = math::softmaxCrossEntropy(context, SoftmaxMode::PER_CHANNEL, 1, 0, input, output, gradient, target).get<double>();
+		EXPECT_TRUE(std::isfinite(loss));
+		EXPECT_GT(loss, 100.0);
+	}
+	TEST(TestTraining, loss_gradient_and_accumulate)
+	{
+		Context context;
+		const Shape shape( { 5, 12 });
+		Tensor output(shape, DataType::FLOAT32, Device::cpu());
+		Tensor target(shape, DataType::FLOAT32, Device::cpu());
+		Tensor gradient(shape, DataType::FLOAT32, Device::cpu());
+		Tensor correct_gradient(shape, DataType::FLOAT32, Device::cpu());
+		Tensor accumulator( { 1 }, DataType::FLOAT32, Device::cpu());
+		fill_logits(output, 1.0f);
+		math::softmaxForward(context, SoftmaxMode::PER_CHANNEL, 1, output, 0, output);
+		fill_one_hot(target);
+
+		for (LossType loss : { LossType::MEAN_SQUARE_LOSS, LossType::CROSS_ENTROPY_LOSS, LossType::KL_DIVERGECE_LOSS })
+			for (bool isFused : { false, true })
+			{
+				gradient.zeroall();
+				correct_gradient.zeroall();
+				accumulator.setall(1.0f);
+
+				math::calcLossGradient(context, loss, 0.5, 1, correct_gradient, output, target, isFused);
+				const double correct_loss = math::calcLossFunction(context, loss, output, target).get<double>();
+				math::calcLossGradientAndAccumulate(context, loss, 0.5, 1, gradient, output, target, isFused, 0.1, accumulator);
+
+				EXPECT_LT(max_abs_diff(gradient, correct_gradient), 1.0e-5);
+				EXPECT_NEAR(accumulator.get<float>( { 0 }), 1.0 + 0.1 * correct_loss, 1.0e-4 * (1.0 + correct_loss));
+			}
+	}
+	TEST(TestTraining, class_index_target)
+	{
+		Context context;
+		const Shape shape( { 6, 11 });
+		CrossEntropyLoss loss(TargetFormat::CLASS_INDEX);
+		EXPECT_EQ(loss.getTargetShape(shape), Shape( { 6 }));
+		EXPECT_EQ(loss.getTargetType(DataType::FLOAT32), DataType::INT32);
+
+		Tensor input(shape, DataType::FLOAT32, Device::cpu());
+		Tensor dense_target(shape, DataType::FLOAT32, Device::cpu());
+		Tensor sparse_target(loss.getTargetShape(shape), DataType::INT32, Device::cpu());
+		Tensor dense_output(shape, DataType::FLOAT32, Device::cpu());
+		Tensor sparse_output(shape, DataType::FLOAT32, Device::cpu());
+		Tensor dense_gradient(shape, DataType::FLOAT32, Device::cpu());
+		Tensor sparse_gradient(shape, DataType::FLOAT32, Device::cpu());
+		fill_logits(input, 3.0f);
+		fill_one_hot(dense_target);
+		fill_class_index(sparse_target, shape.lastDim());
+
+		const double dense_loss = math::softmaxCrossEntropy(context, SoftmaxMode::PER_CHANNEL, 0.5, 0, input, dense_output, dense_gradient,
+				dense_target).get<double>();
+		const double sparse_loss = math::softmaxCrossEntropy(context, SoftmaxMode::PER_CHANNEL, 0.5, 0, input, sparse_output, sparse_gradient,
+				sparse_target).get<double>();
+		EXPECT_NEAR(dense_loss, sparse_loss, 1.0e-5 * dense_loss);
+		EXPECT_LT(max_abs_diff(dense_output, sparse_output), 1.0e-6);
+		EXPECT_LT(max_abs_diff(dense_gradient, sparse_gradient), 1.0e-6);
+
+		Tensor dense_accumulator( { 1 }, DataType::FLOAT32, Device::cpu());
+		Tensor sparse_accumulator( { 1 }, DataType::FLOAT32, Device::cpu());
+		dense_accumulator.zeroall();
+		sparse_accumulator.zeroall();
+		for (bool isFused : { false, true })
+		{
+			math::calcLossGradientAndAccumulate(context, LossType::CROSS_ENTROPY_LOSS, 1, 0, dense_gradient, dense_output, dense_target, isFused, 1,
+					dense_accumulator);
+			math::calcLossGradientAndAccumulate(context, LossType::CROSS_ENTROPY_LOSS, 1, 0, sparse_gradient, dense_output, sparse_target, isFused,
+					1, sparse_accumulator);
+			EXPECT_LT(max_abs_diff(dense_gradient, sparse_gradient), 1.0e-5);
+		}
+		EXPECT_NEAR(dense_accumulator.get<float>( { 0 }), sparse_accumulator.get<float>( { 0 }), 1.0e-4);
+	}
+
+} /* namespace avocado */
@@ -0,0 +1,88 @@
+/*
+ * test_Metric.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <Avocado/metrics/TopKAccuracy.hpp>
+#include <Avocado/metrics/ConfusionMatrix.hpp>
+#include <Avocado/core/Context.hpp>
+#include <Avocado/core/Tensor.hpp>
+#include <Avocado/core/Scalar.hpp>
+#include <Avocado/utils/json.hpp>
+#include <Avocado/utils/serialization.hpp>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+	using namespace avocado;
+
+	/* rows are ranked so that class (i + r) % columns has rank r, i.e. class i is the argmax of row i */
+	Tensor ranked_output(int rows, int columns)
+	{
+		Tensor result( { rows, columns }, DataType::FLOAT32, Device::cpu());
+		for (int i = 0; i < rows; i++)
+			for (int r = 0; r < columns; r++)
+				result.set<float>(1.0f - 0.1f * r, { i, (i + r) % columns });
+		return result;
+	}
+}
+
+namespace avocado
+{
+	TEST(TestMetric, top_k_accuracy)
+	{
+		Context context;
+		const Tensor output = ranked_output(4, 5);
+		Tensor dense_target( { 4, 5 }, DataType::FLOAT32, Device::cpu());
+		Tensor sparse_target( { 4 }, DataType::INT32, Device::cpu());
+		dense_target.zeroall();
+		for (int i = 0; i < 4; i++)
+		{
+			const int target = (i + i) % 5; // rank of the target in row i is equal to i
+			dense_target.set<float>(1.0f, { i, target });
+			sparse_target.set<int32_t>(target, { i });
+		}
+
+		TopKAccuracy top1(1), top3(3);
+		top1.update(context, output, dense_target);
+		top3.update(context, output, dense_target);
+		EXPECT_DOUBLE_EQ(top1.getValue().get<double>(), 0.25);
+		EXPECT_DOUBLE_EQ(top3.getValue().get<double>(), 0.75);
+
+		top3.update(context, output, sparse_target);
+		EXPECT_DOUBLE_EQ(top3.getValue().get<double>(), 0.75);
+		top3.reset();
+		EXPECT_DOUBLE_EQ(top3.getValue().get<double>(), 0.0);
+
+		EXPECT_ANY_THROW(TopKAccuracy(0));
+	}
+	TEST(TestMetric, confusion_matrix)
+	{
+		Context context;
+		const Tensor output = ranked_output(3, 3); // predicts classes 0, 1, 2
+		Tensor target( { 3 }, DataType::INT32, Device::cpu());
+		target.set<int32_t>(0, { 0 });
+		target.set<int32_t>(2, { 1 });
+		target.set<int32_t>(2, { 2 });
+
+		ConfusionMatrix metric;
+		metric.update(context, output, target);
+		metric.update(context, output, target);
+		EXPECT_EQ(metric.numberOfClasses(), 3);
+		const std::vector<int64_t> correct = { 2, 0, 0, 0, 0, 0, 0, 2, 2 }; // rows are targets, columns are predictions
+		EXPECT_EQ(metric.getMatrix(), correct);
+		EXPECT_DOUBLE_EQ(metric.getValue().get<double>(), 4.0 / 6.0);
+	}
+	TEST(TestMetric, serialization)
+	{
+		SerializedObject so;
+		const Json json = TopKAccuracy(5).serialize(so);
+		std::unique_ptr<Metric> loaded = loadMetric(json, so);
+		EXPECT_EQ(loaded->name(), "TopKAccuracy");
+		EXPECT_EQ(static_cast<int>(loaded->serialize(so)["k"]), 5);
+	}
+
+} /* namespace avocado */
@@ -0,0 +1,74 @@
+/*
+ * test_LearningRateSchedule.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: Maciej Kozarzewski
+ */
+
+#include <Avocado/optimizers/LinearWarmup.hpp>
+#include <Avocado/optimizers/CosineDecay.hpp>
+#include <Avocado/optimizers/StepDecay.hpp>
+#include <Avocado/optimizers/OneCycle.hpp>
+#include <Avocado/utils/json.hpp>
+#include <Avocado/utils/serialization.hpp>
+
+#include <gtest/gtest.h>
+
+namespace avocado
+{
+	TEST(TestLearningRateSchedule, warmup)
+	{
+		LinearWarmup schedule(4);
+		EXPECT_DOUBLE_EQ(schedule.getMultiplier(0), 0.25);
+		EXPECT_DOUBLE_EQ(schedule.getMultiplier(3), 1.0);
+		EXPECT_DOUBLE_EQ(schedule.getMultiplier(100), 1.0);
+	}
+	TEST(TestLearningRateSchedule, cosine)
+	{
+		CosineDecay schedule(10, 0.1, 2);
+		EXPECT_DOUBLE_EQ(schedule.getMultiplier(0), 0.5);
+		EXPECT_DOUBLE_EQ(schedule.getMultiplier(2), 1.0);
+		EXPECT_DOUBLE_EQ(schedule.getMultiplier(7), 0.55);
+		EXPECT_DOUBLE_EQ(schedule.getMultiplier(12), 0.1);
+		EXPECT_DOUBLE_EQ(schedule.getMultiplier(50), 0.1);
+	}
+	TEST(TestLearningRateSchedule, step)
+	{
+		StepDecay schedule(3, 0.5);
+		EXPECT_DOUBLE_EQ(schedule.getMultiplier(2), 1.0);
+		EXPECT_DOUBLE_EQ(schedule.getMultiplier(3), 0.5);
+		EXPECT_DOUBLE_EQ(schedule.getMultiplier(7), 0.25);
+	}
+	TEST(TestLearningRateSchedule, oneCycle)
+	{
+		OneCycle schedule(101, 0.3, 10.0, 100.0);
+		EXPECT_DOUBLE_EQ(schedule.getMultiplier(0), 0.1);
+		EXPECT_DOUBLE_EQ(schedule.getMultiplier(30), 1.0);
+		EXPECT_DOUBLE_EQ(schedule.getMultiplier(100), 0.001);
+		for (int i = 1; i <= 30; i++)
+			EXPECT_GT(schedule.getMultiplier(i), schedule.getMultiplier(i - 1));
+		for (int i = 31; i <= 100; i++)
+			EXPECT_LT(schedule.getMultiplier(i), schedule.getMultiplier(i - 1));
+	}
+	TEST(TestLearningRateSchedule, next)
+	{
+		StepDecay schedule(1, 0.5);
+		EXPECT_DOUBLE_EQ(schedule.next(), 1.0);
+		EXPECT_DOUBLE_EQ(schedule.next(), 0.5);
+		EXPECT_EQ(schedule.getStep(), 2);
+	}
+	TEST(TestLearningRateSchedule, serialization)
+	{
+		CosineDecay schedule(100, 0.01, 10);
+		schedule.setStep(42);
+
+		SerializedObject binary_data;
+		const Json json = schedule.serialize(binary_data);
+		std::unique_ptr<LearningRateSchedule> loaded = loadLearningRateSchedule(json, binary_data);
+		EXPECT_EQ(loaded->name(), "CosineDecay");
+		EXPECT_EQ(loaded->getStep(), 42);
+		for (int i = 0; i < 120; i += 7)
+			EXPECT_DOUBLE_EQ(loaded->getMultiplier(i), schedule.getMultiplier(i));
+	}
+
+} /* namespace avocado */